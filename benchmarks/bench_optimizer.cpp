@@ -0,0 +1,81 @@
+// Times the remote optimizer path against a local stand-in server, so it
+// runs offline: a fresh HTTP client per request (what get_https used to do),
+// one kept-alive client, and repeated snapshots answered from the cache.
+//
+// The stand-in answers instantly, so the numbers are Houston's own overhead
+// plus loopback connection setup; against a real TLS endpoint the connection
+// reuse saves a full handshake per request on top of this.
+
+#include "smart_sparker/machine_opt/gemini_backend.hpp"
+#include "mock_http_server.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+static std::vector<Process> make_snapshot(size_t count, int variant)
+{
+    std::vector<Process> processes;
+    processes.reserve(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        pid_t pid = static_cast<pid_t>(i + 100);
+        processes.emplace_back(pid, "proc" + std::to_string(i), 1000 + (i * 7919) % 500000,
+                               static_cast<double>((i * 31 + variant * 17) % 100));
+    }
+    return processes;
+}
+
+template <typename F>
+static double time_per_request_us(int requests, F &&run)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < requests; i++)
+        run(i);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::micro>(elapsed).count() / requests;
+}
+
+int main(int argc, char **argv)
+{
+    int requests = argc > 1 ? std::atoi(argv[1]) : 200;
+    size_t process_count = argc > 2 ? static_cast<size_t>(std::atoi(argv[2])) : 2000;
+
+    MockHttpServer server;
+    server.pid = 100;
+    GeminiOptions options;
+    options.endpoint = server.url();
+    options.api_key = "bench";
+
+    std::vector<std::vector<Process>> snapshots;
+    for (int i = 0; i < requests; i++)
+        snapshots.push_back(make_snapshot(process_count, i));
+
+    options.cache_entries = 0;
+    int connections_before = server.connections;
+    double fresh = time_per_request_us(requests, [&](int i)
+                                       {
+        GeminiBackend backend(options);
+        backend.recommend(snapshots[i]); });
+    int fresh_connections = server.connections - connections_before;
+
+    connections_before = server.connections;
+    GeminiBackend reused(options);
+    double kept_alive = time_per_request_us(requests, [&](int i)
+                                            { reused.recommend(snapshots[i]); });
+    int reused_connections = server.connections - connections_before;
+
+    options.cache_entries = 32;
+    GeminiBackend cached(options);
+    cached.recommend(snapshots[0]);
+    int requests_before = server.requests;
+    double cache_hits = time_per_request_us(requests, [&](int)
+                                            { cached.recommend(snapshots[0]); });
+
+    printf("%d requests, %zu processes per snapshot\n", requests, process_count);
+    printf("  fresh client per request: %8.1f us/request, %d connections\n", fresh, fresh_connections);
+    printf("  kept-alive client:        %8.1f us/request, %d connections\n", kept_alive, reused_connections);
+    printf("  cache hits:               %8.1f us/request, %d requests sent\n", cache_hits,
+           server.requests - requests_before);
+    return 0;
+}
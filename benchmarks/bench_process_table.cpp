@@ -0,0 +1,63 @@
+// Measures the frame time of the process table (build + layout + draw) at
+// 1k, 10k and 50k rows.
+//
+// "all rows" forces a viewport as tall as the list, which is what the table
+// used to do: one row element per process inside a yframe. "windowed" uses a
+// normal 50 row viewport, so only the visible rows plus overscan are built.
+
+#include "ui/process_view/processes_view_table.hpp"
+#include "ftxui/dom/elements.hpp"
+#include "ftxui/screen/screen.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+using namespace ProcessesView;
+
+static std::vector<Process> make_processes(int count)
+{
+    std::vector<Process> processes;
+    processes.reserve(count);
+    for (int i = 0; i < count; i++)
+    {
+        processes.emplace_back(1000 + i, "proc_" + std::to_string(i), (i * 7919) % 2000000, (i % 1000) / 10.0,
+                               (i * 31) % 100000, i * 3, "/usr/bin/proc_" + std::to_string(i) + " --flag");
+    }
+    return processes;
+}
+
+// Average milliseconds per frame over the given number of frames
+static double frame_time_ms(const std::vector<Process> &processes, int viewport_rows, int frames)
+{
+    ViewState state;
+    auto screen = Screen(200, 60);
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < frames; i++)
+    {
+        // Keep the selection moving so the window scrolls like a user paging down
+        *state.selected_index = (i * 37) % static_cast<int>(processes.size());
+        // Rendering reflects the real box back into the state; pin the viewport
+        *state.table_box = Box{0, 199, 0, viewport_rows - 1};
+        Element table = create_process_table(processes, state);
+        Render(screen, table);
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+    return elapsed.count() / 1000.0 / frames;
+}
+
+int main(int argc, char **argv)
+{
+    int frames = argc > 1 ? std::atoi(argv[1]) : 20;
+
+    std::printf("%-8s %16s %16s\n", "rows", "all rows ms", "windowed ms");
+    for (int count : {1000, 10000, 50000})
+    {
+        std::vector<Process> processes = make_processes(count);
+        double all_rows = frame_time_ms(processes, count, frames);
+        double windowed = frame_time_ms(processes, 50, frames);
+        std::printf("%-8d %16.2f %16.2f\n", count, all_rows, windowed);
+    }
+}
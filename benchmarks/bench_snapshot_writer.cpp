@@ -0,0 +1,81 @@
+// Compares serializing a large process snapshot through an nlohmann::json DOM
+// (built element by element, then dump()ed, as the optimizer payload used to
+// be) against SnapshotWriter streaming JSON, CSV and binary into one reused
+// buffer. Allocations are counted by the global operator new in self_monitor.
+
+#include "processes_list/snapshot_writer.hpp"
+#include "metrics/self_monitor.hpp"
+#include "smart_sparker/json.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+static constexpr uint32_t PAYLOAD_FIELDS =
+    SNAPSHOT_PID | SNAPSHOT_NAME | SNAPSHOT_CPU | SNAPSHOT_MEMORY | SNAPSHOT_NETWORK | SNAPSHOT_UPTIME;
+
+static std::vector<Process> make_snapshot(size_t count)
+{
+    std::vector<Process> processes;
+    processes.reserve(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        pid_t pid = static_cast<pid_t>(i + 100);
+        processes.emplace_back(pid, "worker-" + std::to_string(i % 97), 1000 + (i * 7919) % 500000,
+                               static_cast<double>(i % 1000) / 10.0, (i * 131) % 100000, i % 86400,
+                               "/usr/bin/worker --id=" + std::to_string(i));
+    }
+    return processes;
+}
+
+static size_t dom_path(const std::vector<Process> &processes)
+{
+    nlohmann::json processes_json = nlohmann::json::array();
+    for (const auto &p : processes)
+    {
+        processes_json.push_back({{"pid", p.get_pid()},
+                                  {"name", p.get_process_name()},
+                                  {"cpu_usage", p.get_cpu_usage()},
+                                  {"memory_usage", p.get_memory_usage()},
+                                  {"network_usage", p.get_network_usage()},
+                                  {"cpu_time", p.get_cpu_time()}});
+    }
+    return processes_json.dump().size();
+}
+
+template <typename F>
+static void report(const char *label, int iterations, F &&serialize)
+{
+    size_t bytes = serialize(); // Warm-up: lets reused buffers reach their size
+    uint64_t allocations_before = SelfMonitor::get_allocation_count();
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++)
+        bytes = serialize();
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    uint64_t allocations = SelfMonitor::get_allocation_count() - allocations_before;
+
+    printf("  %-22s %9.0f us/snapshot %9zu bytes %9.0f allocations/snapshot\n", label,
+           std::chrono::duration<double, std::micro>(elapsed).count() / iterations, bytes,
+           static_cast<double>(allocations) / iterations);
+}
+
+int main(int argc, char **argv)
+{
+    size_t count = argc > 1 ? static_cast<size_t>(std::atoi(argv[1])) : 20000;
+    int iterations = argc > 2 ? std::atoi(argv[2]) : 20;
+    std::vector<Process> processes = make_snapshot(count);
+    SnapshotWriter writer;
+
+    printf("%zu processes, %d iterations\n", count, iterations);
+    report("nlohmann DOM + dump", iterations, [&]
+           { return dom_path(processes); });
+    report("SnapshotWriter JSON", iterations, [&]
+           { return writer.write(processes, SnapshotFormat::JSON, PAYLOAD_FIELDS).size(); });
+    report("SnapshotWriter CSV", iterations, [&]
+           { return writer.write(processes, SnapshotFormat::CSV, PAYLOAD_FIELDS).size(); });
+    report("SnapshotWriter binary", iterations, [&]
+           { return writer.write(processes, SnapshotFormat::BINARY, PAYLOAD_FIELDS).size(); });
+    report("SnapshotWriter JSON all", iterations, [&]
+           { return writer.write(processes, SnapshotFormat::JSON).size(); });
+    return 0;
+}
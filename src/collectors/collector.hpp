@@ -0,0 +1,44 @@
+#ifndef __COLLECTOR_HPP
+#define __COLLECTOR_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+// A source of metrics refreshed by the CollectorScheduler. Each collector runs
+// at its own interval; an interval of zero means it only runs when triggered.
+class Collector
+{
+public:
+    virtual ~Collector() = default;
+
+    virtual std::string name() const = 0;
+    virtual std::chrono::milliseconds interval() const = 0;
+    virtual void collect() = 0;
+
+    // Collectors returning the same non-null lane (typically the state they
+    // write into) never run at the same time, even with several workers
+    virtual const void *lane() const
+    {
+        return nullptr;
+    }
+};
+
+// Runtime accounting for one collector, as measured by the scheduler
+struct CollectorStats
+{
+    std::string name;
+    std::chrono::milliseconds interval{0};
+    uint64_t runs = 0;
+    uint64_t missed_ticks = 0; // Intervals skipped because a run overran
+    std::chrono::microseconds last_runtime{0};
+    std::chrono::microseconds max_runtime{0};
+    std::chrono::microseconds total_runtime{0};
+
+    std::chrono::microseconds average_runtime() const
+    {
+        return this->runs == 0 ? std::chrono::microseconds(0) : this->total_runtime / static_cast<std::chrono::microseconds::rep>(this->runs);
+    }
+};
+
+#endif /* __COLLECTOR_HPP */
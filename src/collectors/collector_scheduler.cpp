@@ -0,0 +1,341 @@
+#include "collector_scheduler.hpp"
+#include <algorithm>
+#include <time.h>
+
+static std::chrono::nanoseconds thread_cpu_time()
+{
+    timespec ts{};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return std::chrono::seconds(ts.tv_sec) + std::chrono::nanoseconds(ts.tv_nsec);
+}
+
+CollectorScheduler::CollectorScheduler(std::chrono::milliseconds resolution, size_t slot_count, size_t worker_count)
+    : resolution(resolution.count() > 0 ? resolution : std::chrono::milliseconds(1)),
+      wheel(slot_count == 0 ? 1 : slot_count),
+      worker_count(worker_count == 0 ? 1 : worker_count)
+{
+}
+
+CollectorScheduler::~CollectorScheduler()
+{
+    this->stop();
+}
+
+void CollectorScheduler::add(std::shared_ptr<Collector> collector)
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    CollectorStats collector_stats;
+    collector_stats.name = collector->name();
+    collector_stats.interval = collector->interval();
+    this->stats.push_back(collector_stats);
+    this->collectors.push_back(std::move(collector));
+}
+
+void CollectorScheduler::set_on_collected(std::function<void()> callback)
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->on_collected = std::move(callback);
+}
+
+// Places a collector in the slot its due time falls into. Must hold the mutex.
+void CollectorScheduler::schedule(size_t collector_index, Clock::time_point due)
+{
+    auto ahead = due - this->current_tick_time;
+    size_t ticks_ahead = ahead <= Clock::duration::zero()
+                             ? 1
+                             : static_cast<size_t>((ahead + this->resolution - Clock::duration(1)) / this->resolution);
+    if (ticks_ahead == 0)
+        ticks_ahead = 1;
+
+    Entry entry;
+    entry.collector_index = collector_index;
+    entry.rounds = (ticks_ahead - 1) / this->wheel.size();
+    entry.due = due;
+    this->wheel[(this->current_slot + ticks_ahead) % this->wheel.size()].push_back(entry);
+}
+
+void CollectorScheduler::start()
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    if (this->running)
+        return;
+    this->running = true;
+
+    for (auto &slot : this->wheel)
+        slot.clear();
+    this->current_slot = 0;
+    this->current_tick_time = Clock::now();
+    this->window_start = this->current_tick_time;
+    this->window_cpu_time = std::chrono::nanoseconds(0);
+
+    // Periodic collectors run once straight away; trigger-only ones wait to be asked
+    for (size_t i = 0; i < this->collectors.size(); i++)
+    {
+        if (this->stats[i].interval.count() > 0)
+        {
+            this->triggered.push_back(i);
+            this->schedule(i, this->current_tick_time + this->stats[i].interval);
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> batch_lock(this->batch_mutex);
+        this->helpers_running = true;
+    }
+    for (size_t i = 1; i < this->worker_count; i++)
+        this->helpers.emplace_back([this]
+                                   { this->run_helper(); });
+
+    this->worker = std::thread([this]
+                               { this->run_loop(); });
+}
+
+void CollectorScheduler::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        if (!this->running)
+            return;
+        this->running = false;
+    }
+    this->wake.notify_all();
+    if (this->worker.joinable())
+        this->worker.join();
+
+    {
+        std::lock_guard<std::mutex> batch_lock(this->batch_mutex);
+        this->helpers_running = false;
+    }
+    this->batch_wake.notify_all();
+    for (auto &helper : this->helpers)
+        helper.join();
+    this->helpers.clear();
+}
+
+void CollectorScheduler::trigger(const std::string &name)
+{
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        for (size_t i = 0; i < this->stats.size(); i++)
+        {
+            if (this->stats[i].name == name)
+                this->triggered.push_back(i);
+        }
+    }
+    this->wake.notify_all();
+}
+
+void CollectorScheduler::set_cpu_budget(double percent, std::chrono::milliseconds window)
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->cpu_budget_percent = std::max(0.0, percent);
+    this->budget_window = std::max(window, this->resolution);
+    if (this->cpu_budget_percent == 0.0)
+        this->interval_scale = 1;
+}
+
+std::vector<CollectorStats> CollectorScheduler::get_stats() const
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return this->stats;
+}
+
+double CollectorScheduler::get_measured_overhead() const
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return this->measured_overhead_percent;
+}
+
+int CollectorScheduler::get_interval_scale() const
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return this->interval_scale;
+}
+
+// Closes the measurement window once it is long enough and doubles or halves
+// the interval scale depending on how the window compared to the budget.
+// Must hold the mutex.
+void CollectorScheduler::update_interval_scale(Clock::time_point now)
+{
+    auto elapsed = now - this->window_start;
+    if (elapsed < this->budget_window)
+        return;
+
+    this->measured_overhead_percent = 100.0 * std::chrono::duration<double>(this->window_cpu_time).count() /
+                                      std::chrono::duration<double>(elapsed).count();
+    this->window_start = now;
+    this->window_cpu_time = std::chrono::nanoseconds(0);
+
+    if (this->cpu_budget_percent <= 0.0)
+        return;
+    if (this->measured_overhead_percent > this->cpu_budget_percent)
+        this->interval_scale = std::min(this->interval_scale * 2, MAX_INTERVAL_SCALE);
+    else if (this->measured_overhead_percent < this->cpu_budget_percent / 2)
+        this->interval_scale = std::max(this->interval_scale / 2, 1);
+}
+
+// Runs one group of the current batch if any are left. Called with
+// batch_mutex held; drops it while the group runs.
+bool CollectorScheduler::run_next_in_batch(std::unique_lock<std::mutex> &batch_lock)
+{
+    if (this->batch_next >= this->batch.size())
+        return false;
+
+    const std::vector<size_t> &group = this->batch[this->batch_next++];
+    batch_lock.unlock();
+    for (size_t collector_index : group)
+        this->run_collector(collector_index);
+    batch_lock.lock();
+
+    if (--this->batch_remaining == 0)
+        this->batch_done.notify_all();
+    return true;
+}
+
+void CollectorScheduler::run_helper()
+{
+    std::unique_lock<std::mutex> batch_lock(this->batch_mutex);
+    uint64_t seen_generation = this->batch_generation;
+    while (true)
+    {
+        this->batch_wake.wait(batch_lock, [&]
+                              { return !this->helpers_running || this->batch_generation != seen_generation; });
+        if (!this->helpers_running)
+            break;
+        seen_generation = this->batch_generation;
+        while (this->run_next_in_batch(batch_lock))
+        {
+        }
+    }
+}
+
+void CollectorScheduler::run_batch(const std::vector<size_t> &collector_indices)
+{
+    // Collectors on the same lane go into one group so a single thread runs them in turn
+    std::vector<std::vector<size_t>> groups;
+    std::vector<const void *> group_lanes;
+    for (size_t collector_index : collector_indices)
+    {
+        const void *lane = this->collectors[collector_index]->lane();
+        auto it = lane ? std::find(group_lanes.begin(), group_lanes.end(), lane) : group_lanes.end();
+        if (it != group_lanes.end())
+        {
+            groups[it - group_lanes.begin()].push_back(collector_index);
+            continue;
+        }
+        groups.push_back({collector_index});
+        group_lanes.push_back(lane);
+    }
+
+    if (this->helpers.empty() || groups.size() == 1)
+    {
+        for (size_t collector_index : collector_indices)
+            this->run_collector(collector_index);
+        return;
+    }
+
+    std::unique_lock<std::mutex> batch_lock(this->batch_mutex);
+    this->batch = std::move(groups);
+    this->batch_next = 0;
+    this->batch_remaining = this->batch.size();
+    this->batch_generation++;
+    this->batch_wake.notify_all();
+
+    // This thread takes its share too, then waits for the helpers to finish
+    while (this->run_next_in_batch(batch_lock))
+    {
+    }
+    this->batch_done.wait(batch_lock, [this]
+                          { return this->batch_remaining == 0; });
+}
+
+void CollectorScheduler::run_collector(size_t collector_index)
+{
+    auto started = Clock::now();
+    auto cpu_started = thread_cpu_time();
+    this->collectors[collector_index]->collect();
+    auto runtime = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - started);
+    auto cpu_time = thread_cpu_time() - cpu_started;
+
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->window_cpu_time += cpu_time;
+    CollectorStats &collector_stats = this->stats[collector_index];
+    collector_stats.runs++;
+    collector_stats.last_runtime = runtime;
+    collector_stats.total_runtime += runtime;
+    if (runtime > collector_stats.max_runtime)
+        collector_stats.max_runtime = runtime;
+}
+
+void CollectorScheduler::run_loop()
+{
+    std::unique_lock<std::mutex> lock(this->mutex);
+    while (this->running)
+    {
+        Clock::time_point next_tick_time = this->current_tick_time + this->resolution;
+        this->wake.wait_until(lock, next_tick_time, [this]
+                              { return !this->running || !this->triggered.empty(); });
+        if (!this->running)
+            break;
+
+        std::vector<size_t> due = std::move(this->triggered);
+        this->triggered.clear();
+
+        // Advance over every tick that has elapsed. If a run overran, this
+        // catches up without sleeping instead of shifting the whole schedule.
+        Clock::time_point now = Clock::now();
+        while (this->current_tick_time + this->resolution <= now)
+        {
+            this->current_tick_time += this->resolution;
+            this->current_slot = (this->current_slot + 1) % this->wheel.size();
+
+            std::vector<Entry> &slot = this->wheel[this->current_slot];
+            std::vector<Entry> waiting;
+            std::vector<std::pair<size_t, Clock::time_point>> rescheduled;
+            for (const Entry &entry : slot)
+            {
+                if (entry.rounds > 0)
+                {
+                    Entry later = entry;
+                    later.rounds--;
+                    waiting.push_back(later);
+                    continue;
+                }
+
+                // Next due time is anchored to the previous one, not to now
+                std::chrono::milliseconds interval = this->stats[entry.collector_index].interval * this->interval_scale;
+                Clock::time_point next_due = entry.due + interval;
+                while (next_due <= now)
+                {
+                    next_due += interval;
+                    this->stats[entry.collector_index].missed_ticks++;
+                }
+                due.push_back(entry.collector_index);
+                rescheduled.emplace_back(entry.collector_index, next_due);
+            }
+            // Swap the slot out before rescheduling: a long interval can land back in it
+            slot = std::move(waiting);
+            for (const auto &[collector_index, next_due] : rescheduled)
+                this->schedule(collector_index, next_due);
+        }
+
+        this->update_interval_scale(now);
+        if (due.empty())
+            continue;
+
+        // A collector both due and triggered in the same pass only runs once
+        std::vector<size_t> unique_due;
+        for (size_t collector_index : due)
+        {
+            if (std::find(unique_due.begin(), unique_due.end(), collector_index) == unique_due.end())
+                unique_due.push_back(collector_index);
+        }
+
+        std::function<void()> callback = this->on_collected;
+        lock.unlock();
+        this->run_batch(unique_due);
+        if (callback)
+            callback();
+        lock.lock();
+    }
+}
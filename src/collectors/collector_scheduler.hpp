@@ -0,0 +1,110 @@
+#ifndef __COLLECTOR_SCHEDULER_HPP
+#define __COLLECTOR_SCHEDULER_HPP
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "collector.hpp"
+
+// Runs collectors at their own intervals using a hashed timer wheel. The wheel
+// advances on absolute tick times and each collector's next due time is its
+// previous due time plus its interval, so cadences don't drift with collector
+// runtime or thread wake-up latency.
+//
+// Collectors due in the same tick run on up to worker_count threads; the
+// next tick waits for all of them, so a collector never overlaps itself.
+// Collectors that share a lane form one serial group within the tick.
+// With a CPU budget set, the CPU time spent in collectors is measured and
+// every interval is stretched (up to MAX_INTERVAL_SCALE times) while the
+// budget is exceeded.
+class CollectorScheduler
+{
+public:
+    using Clock = std::chrono::steady_clock;
+    static constexpr int MAX_INTERVAL_SCALE = 16;
+
+private:
+    struct Entry
+    {
+        size_t collector_index = 0;
+        size_t rounds = 0; // Full wheel turns left before the entry is due
+        Clock::time_point due;
+    };
+
+    std::chrono::milliseconds resolution;
+    std::vector<std::vector<Entry>> wheel;
+    size_t current_slot = 0;
+    Clock::time_point current_tick_time;
+
+    std::vector<std::shared_ptr<Collector>> collectors;
+    std::vector<CollectorStats> stats;
+    std::vector<size_t> triggered;
+    std::function<void()> on_collected;
+
+    mutable std::mutex mutex;
+    std::condition_variable wake;
+    bool running = false;
+    std::thread worker;
+
+    // Helper threads for batches of due collectors, guarded by batch_mutex
+    size_t worker_count;
+    std::vector<std::thread> helpers;
+    std::mutex batch_mutex;
+    std::condition_variable batch_wake;
+    std::condition_variable batch_done;
+    std::vector<std::vector<size_t>> batch; // Groups of collector indices; each group runs serially
+    size_t batch_next = 0;
+    size_t batch_remaining = 0;
+    uint64_t batch_generation = 0;
+    bool helpers_running = false;
+
+    // CPU budget, guarded by mutex
+    double cpu_budget_percent = 0.0; // 0 disables the budget
+    std::chrono::milliseconds budget_window{2000};
+    int interval_scale = 1;
+    std::chrono::nanoseconds window_cpu_time{0};
+    Clock::time_point window_start;
+    double measured_overhead_percent = 0.0;
+
+    void schedule(size_t collector_index, Clock::time_point due);
+    void run_loop();
+    void run_helper();
+    void run_batch(const std::vector<size_t> &collector_indices);
+    bool run_next_in_batch(std::unique_lock<std::mutex> &batch_lock);
+    void run_collector(size_t collector_index);
+    void update_interval_scale(Clock::time_point now);
+
+public:
+    explicit CollectorScheduler(std::chrono::milliseconds resolution = std::chrono::milliseconds(50),
+                                size_t slot_count = 64, size_t worker_count = 1);
+    ~CollectorScheduler();
+    CollectorScheduler(const CollectorScheduler &) = delete;
+    CollectorScheduler &operator=(const CollectorScheduler &) = delete;
+
+    // Collectors must be added before start()
+    void add(std::shared_ptr<Collector> collector);
+    // Called on the worker thread after each batch of collector runs
+    void set_on_collected(std::function<void()> callback);
+
+    void start();
+    void stop();
+
+    // Runs the named collector as soon as the worker is free, regardless of its interval
+    void trigger(const std::string &name);
+
+    // Percent of one CPU the collectors may use, measured over windows of the
+    // given length. 0 (the default) means no limit.
+    void set_cpu_budget(double percent, std::chrono::milliseconds window = std::chrono::milliseconds(2000));
+
+    std::vector<CollectorStats> get_stats() const;
+    // CPU used by collectors over the last measurement window, in percent of one CPU
+    double get_measured_overhead() const;
+    // Factor every interval is currently stretched by to stay within the budget
+    int get_interval_scale() const;
+};
+
+#endif /* __COLLECTOR_SCHEDULER_HPP */
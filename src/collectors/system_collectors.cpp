@@ -0,0 +1,67 @@
+#include "system_collectors.hpp"
+#include "../processes_list/processes_list.hpp"
+#include "../metrics/self_monitor.hpp"
+
+CpuCollector::CpuCollector(std::shared_ptr<StatusMonitor> status_monitor, std::chrono::milliseconds period,
+                           std::function<void()> on_hotplug)
+    : status_monitor(std::move(status_monitor)), period(period), on_hotplug(std::move(on_hotplug))
+{
+}
+
+void CpuCollector::collect()
+{
+    if (this->status_monitor->update_cpu() && this->on_hotplug)
+    {
+        this->on_hotplug();
+    }
+}
+
+MemoryCollector::MemoryCollector(std::shared_ptr<StatusMonitor> status_monitor, std::chrono::milliseconds period)
+    : status_monitor(std::move(status_monitor)), period(period)
+{
+}
+
+void MemoryCollector::collect()
+{
+    this->status_monitor->update_system();
+}
+
+HardwareCollector::HardwareCollector(std::shared_ptr<StatusMonitor> status_monitor)
+    : status_monitor(std::move(status_monitor))
+{
+}
+
+void HardwareCollector::collect()
+{
+    this->status_monitor->update_hardware();
+}
+
+ProcessCollector::ProcessCollector(std::function<std::vector<Process>()> list_processes, std::vector<Process> &processes,
+                                   std::mutex &processes_mutex,
+                                   std::atomic<uint64_t> &processes_version,
+                                   std::shared_ptr<ProcessHistoryStore> process_history, std::chrono::milliseconds period,
+                                   std::shared_ptr<AnomalyDetector> anomaly_detector)
+    : list_processes(std::move(list_processes)), processes(processes), processes_mutex(processes_mutex), processes_version(processes_version),
+      process_history(std::move(process_history)), period(period), anomaly_detector(std::move(anomaly_detector))
+{
+}
+
+void ProcessCollector::collect()
+{
+    auto new_processes = this->list_processes();
+    if (this->process_history)
+        this->process_history->record(new_processes);
+    if (this->anomaly_detector)
+    {
+        StageTimer timer(Stage::ANOMALY_DETECTION);
+        this->anomaly_detector->observe(new_processes);
+    }
+
+    // Don't stall the collector thread behind the UI; the next tick catches up
+    std::unique_lock<std::mutex> lock(this->processes_mutex, std::try_to_lock);
+    if (lock.owns_lock())
+    {
+        this->processes = std::move(new_processes);
+        this->processes_version++;
+    }
+}
@@ -0,0 +1,129 @@
+#ifndef __SYSTEM_COLLECTORS_HPP
+#define __SYSTEM_COLLECTORS_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "collector.hpp"
+#include "../status_monitor/status_monitor.hpp"
+#include "../processes_list/process.hpp"
+#include "../metrics/process_history.hpp"
+#include "../metrics/anomaly_detector.hpp"
+
+// Overall and per-core CPU utilization. Cheap (one /proc/stat read), so it can
+// run several times a second. on_hotplug is called when CPUs come or go.
+class CpuCollector : public Collector
+{
+private:
+    std::shared_ptr<StatusMonitor> status_monitor;
+    std::chrono::milliseconds period;
+    std::function<void()> on_hotplug;
+
+public:
+    CpuCollector(std::shared_ptr<StatusMonitor> status_monitor, std::chrono::milliseconds period,
+                 std::function<void()> on_hotplug = nullptr);
+
+    std::string name() const override
+    {
+        return "cpu";
+    }
+    std::chrono::milliseconds interval() const override
+    {
+        return this->period;
+    }
+    void collect() override;
+    // StatusMonitor's update_* calls are not safe against each other
+    const void *lane() const override
+    {
+        return this->status_monitor.get();
+    }
+};
+
+// Memory, clock speeds and process / thread counts
+class MemoryCollector : public Collector
+{
+private:
+    std::shared_ptr<StatusMonitor> status_monitor;
+    std::chrono::milliseconds period;
+
+public:
+    MemoryCollector(std::shared_ptr<StatusMonitor> status_monitor, std::chrono::milliseconds period);
+
+    std::string name() const override
+    {
+        return "memory";
+    }
+    std::chrono::milliseconds interval() const override
+    {
+        return this->period;
+    }
+    void collect() override;
+    const void *lane() const override
+    {
+        return this->status_monitor.get();
+    }
+};
+
+// CPU / GPU / NIC / drive inventory. Only runs when triggered (CPU hotplug),
+// since walking PCI ids and /sys/block every tick is wasted work.
+class HardwareCollector : public Collector
+{
+private:
+    std::shared_ptr<StatusMonitor> status_monitor;
+
+public:
+    explicit HardwareCollector(std::shared_ptr<StatusMonitor> status_monitor);
+
+    std::string name() const override
+    {
+        return "hardware";
+    }
+    std::chrono::milliseconds interval() const override
+    {
+        return std::chrono::milliseconds(0);
+    }
+    void collect() override;
+    const void *lane() const override
+    {
+        return this->status_monitor.get();
+    }
+};
+
+// Refreshes the shared process list used by the processes and optimizer views,
+// using whichever backend list_processes reads from.
+// processes_version is bumped with every new snapshot so views can tell when
+// their derived data is stale. Every snapshot is also recorded into
+// process_history and fed to anomaly_detector (if set), whether or not the UI
+// currently holds the list.
+class ProcessCollector : public Collector
+{
+private:
+    std::function<std::vector<Process>()> list_processes;
+    std::vector<Process> &processes;
+    std::mutex &processes_mutex;
+    std::atomic<uint64_t> &processes_version;
+    std::shared_ptr<ProcessHistoryStore> process_history;
+    std::chrono::milliseconds period;
+    std::shared_ptr<AnomalyDetector> anomaly_detector;
+
+public:
+    ProcessCollector(std::function<std::vector<Process>()> list_processes, std::vector<Process> &processes,
+                     std::mutex &processes_mutex,
+                     std::atomic<uint64_t> &processes_version, std::shared_ptr<ProcessHistoryStore> process_history,
+                     std::chrono::milliseconds period, std::shared_ptr<AnomalyDetector> anomaly_detector = nullptr);
+
+    std::string name() const override
+    {
+        return "processes";
+    }
+    std::chrono::milliseconds interval() const override
+    {
+        return this->period;
+    }
+    void collect() override;
+};
+
+#endif /* __SYSTEM_COLLECTORS_HPP */
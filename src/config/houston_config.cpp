@@ -0,0 +1,384 @@
+#include "houston_config.hpp"
+#include <charconv>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+static std::string_view trim(std::string_view text)
+{
+    while (!text.empty() && (text.front() == ' ' || text.front() == '\t'))
+        text.remove_prefix(1);
+    while (!text.empty() && (text.back() == ' ' || text.back() == '\t' || text.back() == '\r'))
+        text.remove_suffix(1);
+    return text;
+}
+
+static bool parse_number(const std::string &value, double &out)
+{
+    auto result = std::from_chars(value.data(), value.data() + value.size(), out);
+    return result.ec == std::errc() && result.ptr == value.data() + value.size();
+}
+
+static bool parse_number(const std::string &value, int &out)
+{
+    auto result = std::from_chars(value.data(), value.data() + value.size(), out);
+    return result.ec == std::errc() && result.ptr == value.data() + value.size();
+}
+
+// Comma-separated collector names replace the enabled set entirely
+static bool apply_collectors(HoustonConfig &config, const std::string &value, std::string &error)
+{
+    HoustonConfig selected = config;
+    selected.collect_cpu = selected.collect_memory = selected.collect_processes = false;
+    selected.collect_network = selected.collect_hardware = false;
+
+    std::stringstream list(value);
+    std::string name;
+    while (std::getline(list, name, ','))
+    {
+        std::string_view collector = trim(name);
+        if (collector == "cpu")
+            selected.collect_cpu = true;
+        else if (collector == "memory")
+            selected.collect_memory = true;
+        else if (collector == "processes")
+            selected.collect_processes = true;
+        else if (collector == "network")
+            selected.collect_network = true;
+        else if (collector == "hardware")
+            selected.collect_hardware = true;
+        else if (collector == "all")
+            selected.collect_cpu = selected.collect_memory = selected.collect_processes =
+                selected.collect_network = selected.collect_hardware = true;
+        else if (!collector.empty())
+        {
+            error = "unknown collector '" + std::string(collector) + "'";
+            return false;
+        }
+    }
+    config = selected;
+    return true;
+}
+
+bool apply_profile(HoustonConfig &config, const std::string &name)
+{
+    if (name == "default")
+    {
+        HoustonConfig defaults;
+        defaults.config_path = config.config_path;
+        defaults.show_help = config.show_help;
+        config = defaults;
+    }
+    else if (name == "minimal")
+    {
+        // For loaded production hosts: no fd walks or hardware rescans, slower
+        // ticks, fewer frames, and collectors held to 1% of a CPU
+        config.refresh_interval_seconds = 5.0;
+        config.cpu_interval_seconds = 2.0;
+        config.collect_network = false;
+        config.collect_hardware = false;
+        config.backend = ProcessBackend::PROCFS;
+        config.collector_threads = 1;
+        config.history_length = 60;
+        config.max_fps = 10;
+        config.cpu_budget_percent = 1.0;
+    }
+    else if (name == "detailed")
+    {
+        // Finer sampling and longer history for investigating a single box
+        config.refresh_interval_seconds = 0.5;
+        config.cpu_interval_seconds = 0.1;
+        config.collector_threads = 2;
+        config.history_length = 600;
+        config.max_fps = 30;
+        config.cpu_budget_percent = 0.0;
+    }
+    else
+    {
+        return false;
+    }
+    config.profile = name;
+    return true;
+}
+
+bool apply_option(HoustonConfig &config, const std::string &key, const std::string &value, std::string &error)
+{
+    auto invalid = [&](const char *expected)
+    {
+        error = "invalid value '" + value + "' for " + key + " (expected " + expected + ")";
+        return false;
+    };
+
+    if (key == "refresh")
+    {
+        if (!parse_number(value, config.refresh_interval_seconds) || config.refresh_interval_seconds < 0.1)
+            return invalid("seconds >= 0.1");
+    }
+    else if (key == "cpu-refresh")
+    {
+        if (!parse_number(value, config.cpu_interval_seconds) || config.cpu_interval_seconds < 0.05)
+            return invalid("seconds >= 0.05");
+    }
+    else if (key == "collectors")
+    {
+        return apply_collectors(config, value, error);
+    }
+    else if (key == "backend")
+    {
+        if (value == "statgrab")
+            config.backend = ProcessBackend::STATGRAB;
+        else if (value == "procfs")
+            config.backend = ProcessBackend::PROCFS;
+        else
+            return invalid("statgrab or procfs");
+    }
+    else if (key == "threads")
+    {
+        if (!parse_number(value, config.collector_threads) || config.collector_threads < 1 ||
+            config.collector_threads > 16)
+            return invalid("1-16");
+    }
+    else if (key == "history")
+    {
+        if (!parse_number(value, config.history_length) || config.history_length < 10 ||
+            config.history_length > 3600)
+            return invalid("10-3600 samples");
+    }
+    else if (key == "fps")
+    {
+        if (!parse_number(value, config.max_fps) || config.max_fps < 1 || config.max_fps > 120)
+            return invalid("1-120");
+    }
+    else if (key == "cpu-budget")
+    {
+        if (!parse_number(value, config.cpu_budget_percent) || config.cpu_budget_percent < 0.0)
+            return invalid("a percentage, 0 for no limit");
+    }
+    else if (key == "grace")
+    {
+        if (!parse_number(value, config.termination_grace_seconds) || config.termination_grace_seconds < 0.0 ||
+            config.termination_grace_seconds > 600.0)
+            return invalid("0-600 seconds");
+    }
+    else if (key == "anomaly-threshold")
+    {
+        if (!parse_number(value, config.anomaly_threshold) || config.anomaly_threshold < 1.0 ||
+            config.anomaly_threshold > 100.0)
+            return invalid("1-100 standard deviations");
+    }
+    else if (key == "optimizer")
+    {
+        if (value == "local")
+            config.optimizer = OptimizerKind::LOCAL;
+        else if (value == "gemini")
+            config.optimizer = OptimizerKind::GEMINI;
+        else
+            return invalid("local or gemini");
+    }
+    else if (key == "optimizer-endpoint")
+    {
+        if (value.rfind("http://", 0) != 0 && value.rfind("https://", 0) != 0)
+            return invalid("an http:// or https:// URL");
+        config.optimizer_endpoint = value;
+    }
+    else if (key == "optimizer-timeout")
+    {
+        if (!parse_number(value, config.optimizer_timeout_seconds) || config.optimizer_timeout_seconds <= 0.0)
+            return invalid("seconds > 0");
+    }
+    else if (key == "profile")
+    {
+        if (!apply_profile(config, value))
+            return invalid("default, minimal or detailed");
+    }
+    else
+    {
+        error = "unknown option '" + key + "'";
+        return false;
+    }
+    return true;
+}
+
+bool parse_config_text(std::string_view text, std::vector<std::pair<std::string, std::string>> &options,
+                       std::string &error)
+{
+    int line_number = 0;
+    size_t pos = 0;
+    while (pos < text.size())
+    {
+        size_t end = text.find('\n', pos);
+        if (end == std::string_view::npos)
+            end = text.size();
+        std::string_view line = trim(text.substr(pos, end - pos));
+        pos = end + 1;
+        line_number++;
+
+        if (line.empty() || line.front() == '#')
+            continue;
+
+        size_t equals = line.find('=');
+        if (equals == std::string_view::npos)
+        {
+            error = "line " + std::to_string(line_number) + ": expected key = value";
+            return false;
+        }
+        options.emplace_back(std::string(trim(line.substr(0, equals))), std::string(trim(line.substr(equals + 1))));
+    }
+    return true;
+}
+
+std::string default_config_path()
+{
+    if (const char *xdg = std::getenv("XDG_CONFIG_HOME"); xdg != nullptr && *xdg != '\0')
+        return std::string(xdg) + "/houston/houston.conf";
+    if (const char *home = std::getenv("HOME"); home != nullptr && *home != '\0')
+        return std::string(home) + "/.config/houston/houston.conf";
+    return "";
+}
+
+static bool apply_options(HoustonConfig &config, const std::vector<std::pair<std::string, std::string>> &options,
+                          const std::string &source, std::string &error)
+{
+    for (const auto &[key, value] : options)
+    {
+        if (key != "profile" && !apply_option(config, key, value, error))
+        {
+            error = source + ": " + error;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool load_config(int argc, const char *const *argv, HoustonConfig &config, std::string &error)
+{
+    std::vector<std::pair<std::string, std::string>> cli_options;
+    bool explicit_config = false;
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (arg == "-h" || arg == "--help")
+        {
+            config.show_help = true;
+            return true;
+        }
+        if (arg.rfind("--", 0) != 0)
+        {
+            error = "unexpected argument '" + arg + "'";
+            return false;
+        }
+
+        // Both --key=value and --key value are accepted
+        std::string key = arg.substr(2);
+        std::string value;
+        size_t equals = key.find('=');
+        if (equals != std::string::npos)
+        {
+            value = key.substr(equals + 1);
+            key = key.substr(0, equals);
+        }
+        else if (i + 1 < argc)
+        {
+            value = argv[++i];
+        }
+        else
+        {
+            error = "missing value for --" + key;
+            return false;
+        }
+
+        if (key == "config")
+        {
+            config.config_path = value;
+            explicit_config = true;
+        }
+        else
+        {
+            cli_options.emplace_back(key, value);
+        }
+    }
+
+    if (!explicit_config)
+        config.config_path = default_config_path();
+
+    std::vector<std::pair<std::string, std::string>> file_options;
+    if (!config.config_path.empty())
+    {
+        std::ifstream file(config.config_path);
+        if (!file && explicit_config)
+        {
+            error = "cannot read config file " + config.config_path;
+            return false;
+        }
+        if (file)
+        {
+            std::stringstream contents;
+            contents << file.rdbuf();
+            if (!parse_config_text(contents.str(), file_options, error))
+            {
+                error = config.config_path + ": " + error;
+                return false;
+            }
+        }
+    }
+
+    // One profile is applied first, so every explicit value from the file or
+    // the command line wins over it; the command line's choice beats the file's
+    std::string profile;
+    std::string profile_source;
+    for (const auto &option : file_options)
+    {
+        if (option.first == "profile")
+        {
+            profile = option.second;
+            profile_source = config.config_path;
+        }
+    }
+    for (const auto &option : cli_options)
+    {
+        if (option.first == "profile")
+        {
+            profile = option.second;
+            profile_source = "command line";
+        }
+    }
+    if (!profile.empty() && !apply_option(config, "profile", profile, error))
+    {
+        error = profile_source + ": " + error;
+        return false;
+    }
+
+    return apply_options(config, file_options, config.config_path, error) &&
+           apply_options(config, cli_options, "command line", error);
+}
+
+std::string usage_text()
+{
+    return "Usage: houston [options]\n"
+           "\n"
+           "Options (each can also be set as 'key = value' in the config file):\n"
+           "  --profile=NAME       default, minimal (low overhead for loaded hosts) or detailed\n"
+           "  --refresh=SECONDS    Process and memory refresh interval (default 1)\n"
+           "  --cpu-refresh=SECONDS\n"
+           "                       CPU utilization refresh interval (default 0.25)\n"
+           "  --collectors=LIST    Comma-separated: cpu,memory,processes,network,hardware or all\n"
+           "  --backend=NAME       Process list backend: statgrab or procfs\n"
+           "  --threads=N          Collector worker threads (default 1)\n"
+           "  --history=N          Samples of per-process history to keep (default 120)\n"
+           "  --fps=N              Maximum UI frames per second (default 30)\n"
+           "  --cpu-budget=PERCENT Stretch collector intervals while they use more than this\n"
+           "                       percentage of one CPU (default 0, no limit)\n"
+           "  --grace=SECONDS      Time a process terminated with 'T' gets to exit before\n"
+           "                       SIGKILL (default 3)\n"
+           "  --anomaly-threshold=SD\n"
+           "                       Flag a process whose CPU, memory or IO rises this many\n"
+           "                       standard deviations above its average (default 4)\n"
+           "  --optimizer=NAME     Machine Optimize backend: local (default) or gemini\n"
+           "  --optimizer-endpoint=URL\n"
+           "                       Where the gemini backend sends requests (e.g. a local stand-in)\n"
+           "  --optimizer-timeout=SECONDS\n"
+           "                       Give up on a gemini request after this long (default 15)\n"
+           "  --config=PATH        Config file (default $XDG_CONFIG_HOME/houston/houston.conf)\n"
+           "  -h, --help           Show this help\n";
+}
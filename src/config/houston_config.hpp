@@ -0,0 +1,73 @@
+#ifndef __HOUSTON_CONFIG_HPP
+#define __HOUSTON_CONFIG_HPP
+
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+enum class ProcessBackend
+{
+    STATGRAB, // libstatgrab, as Houston has always used
+    PROCFS    // Reads /proc directly, keeping per-pid files open between ticks
+};
+
+enum class OptimizerKind
+{
+    LOCAL, // Scores kill candidates on the machine itself
+    GEMINI // Asks the Gemini API; needs GEMINI_API_KEY and outbound HTTPS
+};
+
+// Everything start_ui needs to know. Values are resolved in order: built-in
+// defaults, the selected profile, the config file, then the command line.
+struct HoustonConfig
+{
+    double refresh_interval_seconds = 1.0;
+    double cpu_interval_seconds = 0.25;
+
+    bool collect_cpu = true;
+    bool collect_memory = true;
+    bool collect_processes = true;
+    bool collect_network = true; // Per-process network usage (walks every process's fds)
+    bool collect_hardware = true;
+
+    ProcessBackend backend = ProcessBackend::STATGRAB;
+    int collector_threads = 1;
+    int history_length = 120;
+    int max_fps = 30;
+    // Percent of one CPU collectors may use before their intervals are stretched; 0 = no limit
+    double cpu_budget_percent = 0.0;
+    // How long a terminated process gets to exit on SIGTERM before SIGKILL
+    double termination_grace_seconds = 3.0;
+    // Standard deviations above a process's average that count as an anomaly
+    double anomaly_threshold = 4.0;
+    OptimizerKind optimizer = OptimizerKind::LOCAL;
+    std::string optimizer_endpoint; // Empty: the Gemini API
+    double optimizer_timeout_seconds = 15.0;
+
+    std::string profile = "default";
+    std::string config_path; // Empty: the default path, if it exists
+    bool show_help = false;
+};
+
+// Applies a named profile on top of config. Returns false if there is no such profile.
+bool apply_profile(HoustonConfig &config, const std::string &name);
+
+// Sets one option given as key and value, e.g. ("refresh", "2.5"). Returns
+// false and sets error for unknown keys and malformed values.
+bool apply_option(HoustonConfig &config, const std::string &key, const std::string &value, std::string &error);
+
+// Parses "key = value" lines; blank lines and lines starting with '#' are skipped
+bool parse_config_text(std::string_view text, std::vector<std::pair<std::string, std::string>> &options,
+                       std::string &error);
+
+// $XDG_CONFIG_HOME/houston/houston.conf, falling back to ~/.config/houston/houston.conf
+std::string default_config_path();
+
+// Resolves the configuration from the command line and config file. Returns
+// false and sets error if an option, profile or the file is invalid.
+bool load_config(int argc, const char *const *argv, HoustonConfig &config, std::string &error);
+
+std::string usage_text();
+
+#endif /* __HOUSTON_CONFIG_HPP */
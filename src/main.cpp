@@ -1,7 +1,22 @@
 #include "ui/main_view.hpp"
+#include "config/houston_config.hpp"
+#include <iostream>
 
-int main()
+int main(int argc, char **argv)
 {
-    double refresh_rate_seconds = 1.0;
-    start_ui(refresh_rate_seconds);
-}
\ No newline at end of file
+    HoustonConfig config;
+    std::string error;
+    if (!load_config(argc, argv, config, error))
+    {
+        std::cerr << "houston: " << error << "\n\n"
+                  << usage_text();
+        return 2;
+    }
+    if (config.show_help)
+    {
+        std::cout << usage_text();
+        return 0;
+    }
+
+    start_ui(config);
+}
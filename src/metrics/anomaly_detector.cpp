@@ -0,0 +1,203 @@
+#include "anomaly_detector.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <unistd.h>
+
+static const char *metric_name(AnomalyMetric metric)
+{
+    switch (metric)
+    {
+    case AnomalyMetric::MEMORY:
+        return "memory";
+    case AnomalyMetric::IO:
+        return "IO";
+    default:
+        return "CPU";
+    }
+}
+
+// Binary units, matching the process table's MEM (MB) column and the mem filter
+static std::string format_metric(AnomalyMetric metric, double value)
+{
+    char s[32];
+    switch (metric)
+    {
+    case AnomalyMetric::MEMORY:
+        snprintf(s, sizeof(s), "%.1f MB", value / 1024.0);
+        break;
+    case AnomalyMetric::IO:
+        snprintf(s, sizeof(s), "%.1f KB/s", value / 1024.0);
+        break;
+    default:
+        snprintf(s, sizeof(s), "%.1f%%", value);
+        break;
+    }
+    return s;
+}
+
+std::string describe_anomaly(const AnomalyAlert &alert)
+{
+    std::string description = alert.name + " (" + std::to_string(alert.pid) + ") ";
+    char s[64];
+    switch (alert.kind)
+    {
+    case AnomalyKind::SPIKE:
+        snprintf(s, sizeof(s), ", %.1f sd)", alert.score);
+        description += std::string(metric_name(alert.metric)) + " spike " + format_metric(alert.metric, alert.value) +
+                       " (mean " + format_metric(alert.metric, alert.mean) + s;
+        break;
+    case AnomalyKind::SATURATION:
+        description += "CPU saturated at " + format_metric(alert.metric, alert.value) + " for " +
+                       std::to_string(static_cast<long>(alert.score)) + " ticks";
+        break;
+    case AnomalyKind::HEAVY_HITTER:
+        snprintf(s, sizeof(s), "%.0f%%", alert.score * 100.0);
+        description += "new heavy hitter: " + std::string(s) + " of " + metric_name(alert.metric) + " (" +
+                       format_metric(alert.metric, alert.value) + ")";
+        break;
+    }
+    return description;
+}
+
+AnomalyDetector::AnomalyDetector(AnomalyOptions options)
+    : options(options), log(options.log_capacity)
+{
+    this->options.alpha = std::clamp(this->options.alpha, 0.001, 1.0);
+    if (this->options.cpu_capacity_percent <= 0.0)
+        this->options.cpu_capacity_percent = 100.0 * std::max(1L, sysconf(_SC_NPROCESSORS_ONLN));
+    if (this->options.memory_total_kb <= 0.0)
+        this->options.memory_total_kb = static_cast<double>(sysconf(_SC_PHYS_PAGES)) * (sysconf(_SC_PAGESIZE) / 1024);
+}
+
+size_t AnomalyDetector::observe(const std::vector<Process> &processes)
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->slot_map.begin_snapshot();
+    uint64_t generation = this->slot_map.get_generation();
+    bool baseline = generation == 1;
+    uint64_t alerts_before = this->total_alerts;
+    auto now = std::chrono::system_clock::now();
+    const double min_delta[METRIC_COUNT] = {this->options.min_cpu_delta, this->options.min_memory_delta_kb,
+                                            this->options.min_io_delta};
+
+    // What each process's usage is a share of for the heavy hitter check. CPU
+    // and memory are measured against the machine, so an idle host does not
+    // make every busy-ish process look heavy; IO has no capacity to compare to.
+    double totals[METRIC_COUNT] = {this->options.cpu_capacity_percent, this->options.memory_total_kb, 0.0};
+    for (const auto &proc : processes)
+        totals[2] += static_cast<double>(proc.get_network_usage());
+
+    auto raise = [&](Slot &slot, const Process &proc, AnomalyKind kind, AnomalyMetric metric, double value,
+                     double mean, double score)
+    {
+        uint64_t &quiet_until = slot.quiet_until[static_cast<size_t>(kind)];
+        if (generation < quiet_until)
+            return;
+        quiet_until = generation + this->options.cooldown_ticks;
+
+        AnomalyAlert alert;
+        alert.pid = proc.get_pid();
+        alert.name = proc.get_process_name();
+        alert.kind = kind;
+        alert.metric = metric;
+        alert.value = value;
+        alert.mean = mean;
+        alert.score = score;
+        alert.time = now;
+        this->log.push(alert);
+        this->total_alerts++;
+    };
+
+    for (const auto &proc : processes)
+    {
+        PidSlot pid_slot = this->slot_map.acquire(proc.get_pid(), proc.get_start_time());
+        if (pid_slot.index >= this->slots.size())
+            this->slots.emplace_back();
+        Slot &slot = this->slots[pid_slot.index];
+        if (pid_slot.fresh)
+            slot = Slot{};
+
+        const double values[METRIC_COUNT] = {proc.get_cpu_usage(), static_cast<double>(proc.get_memory_usage()),
+                                             static_cast<double>(proc.get_network_usage())};
+        for (size_t m = 0; m < METRIC_COUNT; m++)
+        {
+            AnomalyMetric metric = static_cast<AnomalyMetric>(m);
+            Ewma &ewma = slot.ewma[m];
+
+            // The deviation floor keeps a flat history from turning any wobble into infinite sigmas
+            if (slot.samples >= this->options.warmup_samples)
+            {
+                double deviation = std::max(std::sqrt(ewma.variance), min_delta[m] / this->options.spike_threshold);
+                double delta = values[m] - ewma.mean;
+                if (delta >= min_delta[m] && delta >= this->options.spike_threshold * deviation)
+                    raise(slot, proc, AnomalyKind::SPIKE, metric, values[m], ewma.mean, delta / deviation);
+            }
+
+            // Hysteresis: a heavy hitter stays one until its share halves, so
+            // usage hovering around the line does not alert every other tick
+            double share = totals[m] > 0.0 ? values[m] / totals[m] : 0.0;
+            double heavy_share = slot.heavy[m] ? this->options.heavy_share / 2.0 : this->options.heavy_share;
+            bool heavy = share >= heavy_share && values[m] >= min_delta[m];
+            if (heavy && !slot.heavy[m] && !baseline)
+                raise(slot, proc, AnomalyKind::HEAVY_HITTER, metric, values[m], ewma.mean, share);
+            slot.heavy[m] = heavy;
+
+            if (slot.samples == 0)
+                ewma.mean = values[m];
+            else
+                ewma.update(values[m], this->options.alpha);
+        }
+
+        if (values[0] >= this->options.saturation_cpu_percent)
+        {
+            slot.saturated_ticks++;
+            if (slot.saturated_ticks == this->options.saturation_ticks)
+                raise(slot, proc, AnomalyKind::SATURATION, AnomalyMetric::CPU, values[0], slot.ewma[0].mean,
+                      slot.saturated_ticks);
+        }
+        else
+        {
+            slot.saturated_ticks = 0;
+        }
+
+        slot.samples++;
+    }
+
+    this->slot_map.release_unseen();
+
+    return static_cast<size_t>(this->total_alerts - alerts_before);
+}
+
+std::vector<AnomalyAlert> AnomalyDetector::get_alerts() const
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return this->log.to_vector();
+}
+
+bool AnomalyDetector::get_latest_alert(AnomalyAlert &alert) const
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    if (this->log.empty())
+        return false;
+    alert = this->log.back();
+    return true;
+}
+
+uint64_t AnomalyDetector::get_total_alerts() const
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return this->total_alerts;
+}
+
+void AnomalyDetector::clear_alerts()
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->log.clear();
+}
+
+size_t AnomalyDetector::get_tracked_count() const
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return this->slot_map.size();
+}
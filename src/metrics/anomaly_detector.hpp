@@ -0,0 +1,125 @@
+#ifndef __ANOMALY_DETECTOR_HPP
+#define __ANOMALY_DETECTOR_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "pid_slot_map.hpp"
+#include "time_series.hpp"
+#include "../processes_list/process.hpp"
+
+enum class AnomalyKind
+{
+    SPIKE,       // A sample far outside the process's own recent behaviour
+    SATURATION,  // CPU pinned at or above the saturation level for several ticks
+    HEAVY_HITTER // Newly holding a large share of the host's CPU capacity, RAM or IO
+};
+
+enum class AnomalyMetric
+{
+    CPU,    // Percent
+    MEMORY, // RSS in KB
+    IO      // Network bytes per second
+};
+
+struct AnomalyAlert
+{
+    pid_t pid = 0;
+    std::string name;
+    AnomalyKind kind = AnomalyKind::SPIKE;
+    AnomalyMetric metric = AnomalyMetric::CPU;
+    double value = 0.0;
+    double mean = 0.0;  // EWMA before this sample
+    double score = 0.0; // Spike: standard deviations above the mean. Heavy hitter: share of the host.
+    std::chrono::system_clock::time_point time;
+};
+
+struct AnomalyOptions
+{
+    double alpha = 0.1;           // EWMA weight of the newest sample
+    double spike_threshold = 4.0; // Standard deviations above the mean that count as a spike
+    uint32_t warmup_samples = 10; // Samples a process needs before it can spike
+    double saturation_cpu_percent = 90.0;
+    uint32_t saturation_ticks = 10;
+    // Share of the host that makes a process a heavy hitter: of all CPUs, of
+    // RAM, and of every process's IO combined (there is no IO capacity to use)
+    double heavy_share = 0.25;
+    double cpu_capacity_percent = 0.0; // 100 per logical CPU; 0: the CPUs online at construction
+    double memory_total_kb = 0.0;      // 0: physical RAM at construction
+    // Below these the deviation is noise however many sigmas it is
+    double min_cpu_delta = 10.0;        // Percent
+    double min_memory_delta_kb = 51200; // 50 MB
+    double min_io_delta = 1048576;      // 1 MB/s
+    uint32_t cooldown_ticks = 30; // Ticks before the same process can raise the same alert again
+    size_t log_capacity = 256;
+};
+
+// "firefox (1234) CPU spike 85.0% (mean 3.1%, 12.4 sd)"
+std::string describe_anomaly(const AnomalyAlert &alert);
+
+// Always-on detector fed every process snapshot. Each process keeps an
+// exponentially weighted mean and variance of CPU, RSS and IO, so a tick costs
+// one hash lookup and a few multiplies per process whatever its history length.
+// State lives in a slab indexed through a PidSlotMap, like ProcessHistoryStore.
+// Alerts go into a bounded log that the UI reads from another thread.
+class AnomalyDetector
+{
+private:
+    struct Ewma
+    {
+        double mean = 0.0;
+        double variance = 0.0;
+
+        void update(double value, double alpha)
+        {
+            double diff = value - this->mean;
+            double increment = alpha * diff;
+            this->mean += increment;
+            this->variance = (1.0 - alpha) * (this->variance + diff * increment);
+        }
+    };
+
+    static constexpr size_t METRIC_COUNT = 3;
+    static constexpr size_t KIND_COUNT = 3;
+
+    struct Slot
+    {
+        uint32_t samples = 0;
+        uint32_t saturated_ticks = 0;
+        Ewma ewma[METRIC_COUNT];
+        bool heavy[METRIC_COUNT] = {};
+        uint64_t quiet_until[KIND_COUNT] = {}; // Per alert kind: first tick it may fire again
+    };
+
+    AnomalyOptions options;
+    std::vector<Slot> slots;
+    PidSlotMap slot_map;
+    RingBuffer<AnomalyAlert> log;
+    uint64_t total_alerts = 0;
+    mutable std::mutex mutex;
+
+public:
+    explicit AnomalyDetector(AnomalyOptions options = {});
+
+    // Updates every process's statistics with one snapshot and returns how
+    // many alerts it raised. The first snapshot only sets the baseline.
+    size_t observe(const std::vector<Process> &processes);
+
+    // Logged alerts, oldest first
+    std::vector<AnomalyAlert> get_alerts() const;
+    // Copies the newest logged alert; false if the log is empty
+    bool get_latest_alert(AnomalyAlert &alert) const;
+    // Alerts raised since the detector started, including ones rotated out of the log
+    uint64_t get_total_alerts() const;
+    void clear_alerts();
+
+    size_t get_tracked_count() const;
+    const AnomalyOptions &get_options() const
+    {
+        return this->options;
+    }
+};
+
+#endif /* __ANOMALY_DETECTOR_HPP */
@@ -0,0 +1,81 @@
+#include "core_history.hpp"
+#include <algorithm>
+#include <cmath>
+
+CoreHistory::CoreHistory(size_t capacity)
+    : capacity(capacity == 0 ? 1 : capacity)
+{
+}
+
+uint8_t CoreHistory::quantize(double utilization)
+{
+    if (utilization < 0.0)
+        return NO_SAMPLE;
+    return static_cast<uint8_t>(std::lround(std::min(utilization, 100.0) * FULL_SCALE / 100.0));
+}
+
+double CoreHistory::dequantize(uint8_t sample)
+{
+    return sample == NO_SAMPLE ? -1.0 : sample * 100.0 / FULL_SCALE;
+}
+
+void CoreHistory::resize_cores(size_t new_core_count)
+{
+    // Rare (CPU hotplug beyond the highest id seen), so re-lay the whole slab
+    std::vector<uint8_t> resized(this->capacity * new_core_count, NO_SAMPLE);
+    for (size_t column = 0; column < this->capacity; column++)
+        std::copy_n(this->samples.begin() + column * this->core_count, this->core_count,
+                    resized.begin() + column * new_core_count);
+    this->samples = std::move(resized);
+    this->core_count = new_core_count;
+}
+
+void CoreHistory::push(const std::vector<double> &utilization_by_cpu)
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    if (utilization_by_cpu.size() > this->core_count)
+        this->resize_cores(utilization_by_cpu.size());
+
+    uint8_t *column = this->samples.data() + this->head * this->core_count;
+    for (size_t core = 0; core < this->core_count; core++)
+        column[core] = core < utilization_by_cpu.size() ? quantize(utilization_by_cpu[core]) : NO_SAMPLE;
+
+    this->head = (this->head + 1) % this->capacity;
+    this->count = std::min(this->count + 1, this->capacity);
+    this->total_columns++;
+}
+
+CoreHistoryUpdate CoreHistory::get_since(uint64_t since) const
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    CoreHistoryUpdate update;
+    update.total_columns = this->total_columns;
+    update.core_count = this->core_count;
+
+    uint64_t oldest = this->total_columns - this->count;
+    update.first_sequence = std::clamp(since, oldest, this->total_columns);
+    size_t columns = static_cast<size_t>(this->total_columns - update.first_sequence);
+    update.samples.resize(columns * this->core_count);
+
+    // The newest column sits just before head
+    size_t start = (this->head + this->capacity - columns) % this->capacity;
+    for (size_t i = 0; i < columns; i++)
+    {
+        size_t column = (start + i) % this->capacity;
+        std::copy_n(this->samples.begin() + column * this->core_count, this->core_count,
+                    update.samples.begin() + i * this->core_count);
+    }
+    return update;
+}
+
+size_t CoreHistory::get_core_count() const
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return this->core_count;
+}
+
+uint64_t CoreHistory::get_total_columns() const
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return this->total_columns;
+}
@@ -0,0 +1,63 @@
+#ifndef __CORE_HISTORY_HPP
+#define __CORE_HISTORY_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+// Columns appended to a CoreHistory since a reader last looked
+struct CoreHistoryUpdate
+{
+    uint64_t first_sequence = 0; // Sequence number of the first column in samples
+    uint64_t total_columns = 0;  // Columns ever pushed; the reader's next since value
+    size_t core_count = 0;
+    std::vector<uint8_t> samples; // core_count quantized samples per column, oldest column first
+};
+
+// Per-core utilization over time for the CPU heatmap. Each sample is one
+// byte (0-100% quantized to 0-250), and each push appends a column holding
+// every core, so 128 cores over 300 samples take under 40 KB. Columns are
+// numbered by a sequence that keeps counting past the capacity, which lets
+// a renderer ask for just the columns it has not drawn yet.
+class CoreHistory
+{
+public:
+    static constexpr uint8_t FULL_SCALE = 250;
+    static constexpr uint8_t NO_SAMPLE = 255; // Core offline or not sampled yet
+
+private:
+    size_t capacity;
+    size_t core_count = 0;
+    std::vector<uint8_t> samples; // capacity columns of core_count bytes
+    size_t head = 0;              // Column the next push writes to
+    size_t count = 0;
+    uint64_t total_columns = 0;
+    mutable std::mutex mutex;
+
+    void resize_cores(size_t new_core_count);
+
+public:
+    explicit CoreHistory(size_t capacity = 300);
+
+    static uint8_t quantize(double utilization);
+    static double dequantize(uint8_t sample);
+
+    // Appends one column. utilization_by_cpu is indexed by CPU id, with
+    // negative values for CPUs that have no sample; a higher CPU id than
+    // seen before adds rows, which read as NO_SAMPLE in older columns.
+    void push(const std::vector<double> &utilization_by_cpu);
+
+    // Columns with sequence >= since that are still held. A since older than
+    // the oldest column held returns everything held.
+    CoreHistoryUpdate get_since(uint64_t since) const;
+
+    size_t get_capacity() const
+    {
+        return this->capacity;
+    }
+    size_t get_core_count() const;
+    uint64_t get_total_columns() const;
+};
+
+#endif /* __CORE_HISTORY_HPP */
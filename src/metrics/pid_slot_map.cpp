@@ -0,0 +1,62 @@
+#include "pid_slot_map.hpp"
+
+void PidSlotMap::begin_snapshot()
+{
+    this->generation++;
+}
+
+PidSlot PidSlotMap::acquire(pid_t pid, uint64_t start_time)
+{
+    PidSlot slot;
+    auto it = this->slot_by_pid.find(pid);
+    if (it != this->slot_by_pid.end())
+    {
+        slot.index = it->second;
+        slot.fresh = start_time != this->entries[slot.index].start_time;
+    }
+    else
+    {
+        if (!this->free_slots.empty())
+        {
+            slot.index = this->free_slots.back();
+            this->free_slots.pop_back();
+        }
+        else
+        {
+            slot.index = static_cast<uint32_t>(this->entries.size());
+            this->entries.emplace_back();
+        }
+        this->slot_by_pid[pid] = slot.index;
+        slot.fresh = true;
+    }
+
+    Entry &entry = this->entries[slot.index];
+    entry.last_seen = this->generation;
+    entry.start_time = start_time;
+    return slot;
+}
+
+void PidSlotMap::release_unseen()
+{
+    for (auto it = this->slot_by_pid.begin(); it != this->slot_by_pid.end();)
+    {
+        if (this->entries[it->second].last_seen != this->generation)
+        {
+            this->free_slots.push_back(it->second);
+            it = this->slot_by_pid.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+bool PidSlotMap::find(pid_t pid, uint32_t &index) const
+{
+    auto it = this->slot_by_pid.find(pid);
+    if (it == this->slot_by_pid.end())
+        return false;
+    index = it->second;
+    return true;
+}
@@ -0,0 +1,63 @@
+#ifndef __PID_SLOT_MAP_HPP
+#define __PID_SLOT_MAP_HPP
+
+#include <cstdint>
+#include <sys/types.h>
+#include <unordered_map>
+#include <vector>
+
+// Slot assigned to a pid for one snapshot
+struct PidSlot
+{
+    uint32_t index = 0;
+    bool fresh = false; // New slot, or the pid now belongs to a different process: reset its data
+};
+
+// Gives every live pid a stable index into per-process arrays owned by the
+// caller. Indices of pids missing from a snapshot go on a free list and are
+// handed out again, so the arrays stay as large as the peak process count.
+// Indices are allocated densely: a new one is always the current slot_count()
+// minus one, so callers grow their arrays by one slot when they see it.
+// Not thread-safe; callers lock around it together with their own data.
+class PidSlotMap
+{
+private:
+    struct Entry
+    {
+        uint64_t last_seen = 0;  // Generation of the last snapshot containing the pid
+        uint64_t start_time = 0; // Detects a pid being reused by a new process
+    };
+
+    std::vector<Entry> entries;
+    std::vector<uint32_t> free_slots;
+    std::unordered_map<pid_t, uint32_t> slot_by_pid;
+    uint64_t generation = 0;
+
+public:
+    // Starts a snapshot; every pid in it must then be passed to acquire()
+    void begin_snapshot();
+    // start_time is Process::get_start_time(), which never changes for one
+    // process. A different value than last time means a new process got the pid.
+    PidSlot acquire(pid_t pid, uint64_t start_time);
+    // Frees the slots of pids that were not acquired since begin_snapshot()
+    void release_unseen();
+
+    // False if the pid is not being tracked
+    bool find(pid_t pid, uint32_t &index) const;
+
+    // Number of generations started, so the first snapshot can be told apart
+    uint64_t get_generation() const
+    {
+        return this->generation;
+    }
+    size_t size() const
+    {
+        return this->slot_by_pid.size();
+    }
+    size_t slot_count() const
+    {
+        return this->entries.size();
+    }
+};
+
+#endif /* __PID_SLOT_MAP_HPP */
@@ -0,0 +1,110 @@
+#include "process_history.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+static uint16_t quantize_cpu(double percent)
+{
+    double centi = std::round(percent * 100.0);
+    return static_cast<uint16_t>(std::clamp(centi, 0.0, static_cast<double>(std::numeric_limits<uint16_t>::max())));
+}
+
+static uint32_t saturate_u32(unsigned long value)
+{
+    return static_cast<uint32_t>(std::min<unsigned long>(value, std::numeric_limits<uint32_t>::max()));
+}
+
+ProcessHistoryStore::ProcessHistoryStore(size_t capacity)
+    : capacity(capacity == 0 ? 1 : capacity),
+      snapshot_times(this->capacity)
+{
+}
+
+void ProcessHistoryStore::record(const std::vector<Process> &processes, std::chrono::steady_clock::time_point time)
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->slot_map.begin_snapshot();
+    this->snapshot_times[this->snapshot_head] = time;
+    this->snapshot_head = (this->snapshot_head + 1) % this->capacity;
+
+    for (const auto &proc : processes)
+    {
+        PidSlot pid_slot = this->slot_map.acquire(proc.get_pid(), proc.get_start_time());
+        if (pid_slot.index >= this->slots.size())
+        {
+            this->slots.emplace_back();
+            this->cpu_samples.resize(this->cpu_samples.size() + this->capacity);
+            this->memory_samples.resize(this->memory_samples.size() + this->capacity);
+            this->network_samples.resize(this->network_samples.size() + this->capacity);
+        }
+        Slot &slot = this->slots[pid_slot.index];
+        if (pid_slot.fresh)
+            slot = Slot{};
+
+        size_t sample = static_cast<size_t>(pid_slot.index) * this->capacity + slot.head;
+        this->cpu_samples[sample] = quantize_cpu(proc.get_cpu_usage());
+        this->memory_samples[sample] = saturate_u32(proc.get_memory_usage());
+        this->network_samples[sample] = saturate_u32(proc.get_network_usage());
+
+        slot.head = (slot.head + 1) % this->capacity;
+        slot.count = std::min(slot.count + 1, this->capacity);
+        slot.total_samples++;
+    }
+
+    this->slot_map.release_unseen();
+}
+
+ProcessHistory ProcessHistoryStore::get(pid_t pid) const
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    ProcessHistory history;
+
+    uint32_t index;
+    if (!this->slot_map.find(pid, index))
+        return history;
+
+    const Slot &slot = this->slots[index];
+    size_t base = static_cast<size_t>(index) * this->capacity;
+    size_t start = (slot.head + this->capacity - slot.count) % this->capacity;
+
+    history.cpu.reserve(slot.count);
+    history.memory.reserve(slot.count);
+    history.network.reserve(slot.count);
+    history.times.reserve(slot.count);
+    size_t time_start = (this->snapshot_head + this->capacity - slot.count) % this->capacity;
+    for (size_t i = 0; i < slot.count; i++)
+    {
+        size_t sample = base + (start + i) % this->capacity;
+        history.cpu.push_back(this->cpu_samples[sample] / 100.0f);
+        history.memory.push_back(static_cast<float>(this->memory_samples[sample]));
+        history.network.push_back(static_cast<float>(this->network_samples[sample]));
+        history.times.push_back(this->snapshot_times[(time_start + i) % this->capacity]);
+    }
+    history.total_samples = slot.total_samples;
+    return history;
+}
+
+MemoryTrend ProcessHistoryStore::get_memory_trend(pid_t pid) const
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    MemoryTrend trend;
+
+    uint32_t index;
+    if (!this->slot_map.find(pid, index) || this->slots[index].count == 0)
+        return trend;
+
+    const Slot &slot = this->slots[index];
+    size_t base = static_cast<size_t>(index) * this->capacity;
+    size_t start = (slot.head + this->capacity - slot.count) % this->capacity;
+    size_t newest = (slot.head + this->capacity - 1) % this->capacity;
+    trend.oldest_kb = static_cast<float>(this->memory_samples[base + start]);
+    trend.newest_kb = static_cast<float>(this->memory_samples[base + newest]);
+    trend.samples = slot.count;
+    return trend;
+}
+
+size_t ProcessHistoryStore::get_tracked_count() const
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return this->slot_map.size();
+}
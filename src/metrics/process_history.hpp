@@ -0,0 +1,77 @@
+#ifndef __PROCESS_HISTORY_HPP
+#define __PROCESS_HISTORY_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+#include "pid_slot_map.hpp"
+#include "../processes_list/process.hpp"
+
+// Recent samples for one process, oldest first
+struct ProcessHistory
+{
+    std::vector<float> cpu;     // Percent
+    std::vector<float> memory;  // KB
+    std::vector<float> network; // Bytes per second
+    std::vector<std::chrono::steady_clock::time_point> times; // When each sample was recorded
+    uint64_t total_samples = 0; // Samples ever recorded, including ones that have been overwritten
+};
+
+// Oldest and newest memory sample kept for one process
+struct MemoryTrend
+{
+    float oldest_kb = 0.0f;
+    float newest_kb = 0.0f;
+    size_t samples = 0; // 0 if the pid is not being tracked
+};
+
+// Short history for every running process, recorded by the process collector
+// so a detail view opens with its graphs already filled in. Samples are
+// quantized (CPU in hundredths of a percent, memory and network as saturating
+// 32-bit counts) and stored in one slab with a fixed number of samples per
+// pid, indexed through a PidSlotMap. Slots of exited processes are reused, so
+// memory stays bounded by the peak process count. A tracked pid is in every
+// snapshot since it was first seen, so its samples line up with the newest
+// snapshots and one ring of snapshot times serves all of them.
+class ProcessHistoryStore
+{
+private:
+    struct Slot
+    {
+        size_t head = 0; // Sample index the next push writes to
+        size_t count = 0;
+        uint64_t total_samples = 0;
+    };
+
+    size_t capacity;
+    std::vector<uint16_t> cpu_samples;
+    std::vector<uint32_t> memory_samples;
+    std::vector<uint32_t> network_samples;
+    std::vector<Slot> slots;
+    std::vector<std::chrono::steady_clock::time_point> snapshot_times;
+    size_t snapshot_head = 0; // Index the next snapshot time is written to
+    PidSlotMap slot_map;
+    mutable std::mutex mutex;
+
+public:
+    explicit ProcessHistoryStore(size_t capacity = 120);
+
+    // Appends one sample per process, taken at the given time, and frees the
+    // slots of processes that are no longer in the snapshot
+    void record(const std::vector<Process> &processes,
+                std::chrono::steady_clock::time_point time = std::chrono::steady_clock::now());
+
+    // Empty history if the pid is not being tracked
+    ProcessHistory get(pid_t pid) const;
+    // Two samples instead of the whole history, for ranking every process
+    MemoryTrend get_memory_trend(pid_t pid) const;
+
+    size_t get_capacity() const
+    {
+        return this->capacity;
+    }
+    size_t get_tracked_count() const;
+};
+
+#endif /* __PROCESS_HISTORY_HPP */
@@ -0,0 +1,218 @@
+#include "self_monitor.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstdlib>
+#include <ctime>
+#include <new>
+#include <unistd.h>
+
+// Allocation counters are sharded by thread so concurrent allocations from
+// collector threads and the UI never contend on one cache line
+namespace
+{
+constexpr size_t ALLOCATION_SHARDS = 16;
+
+struct alignas(64) CounterShard
+{
+    std::atomic<uint64_t> value{0};
+};
+
+CounterShard allocation_shards[ALLOCATION_SHARDS];
+std::atomic<unsigned> next_shard{0};
+
+void count_allocation()
+{
+    static thread_local unsigned shard = next_shard.fetch_add(1, std::memory_order_relaxed) % ALLOCATION_SHARDS;
+    allocation_shards[shard].value.fetch_add(1, std::memory_order_relaxed);
+}
+} // namespace
+
+// The default array and nothrow forms forward here, and the default delete
+// frees with free(), so this is the only replacement needed
+void *operator new(std::size_t size)
+{
+    count_allocation();
+    if (size == 0)
+        size = 1;
+    while (true)
+    {
+        if (void *pointer = std::malloc(size))
+            return pointer;
+        std::new_handler handler = std::get_new_handler();
+        if (handler == nullptr)
+            throw std::bad_alloc();
+        handler();
+    }
+}
+
+size_t LatencyHistogram::bucket_index(uint64_t value)
+{
+    if (value < SUB_BUCKETS)
+        return static_cast<size_t>(value);
+    int magnitude = std::bit_width(value) - 1;
+    uint64_t sub_bucket = (value >> (magnitude - SUB_BUCKET_BITS)) - SUB_BUCKETS;
+    return static_cast<size_t>(magnitude - SUB_BUCKET_BITS + 1) * SUB_BUCKETS + sub_bucket;
+}
+
+uint64_t LatencyHistogram::bucket_upper_bound(size_t index)
+{
+    if (index < SUB_BUCKETS)
+        return index;
+    int magnitude = static_cast<int>(index / SUB_BUCKETS) + SUB_BUCKET_BITS - 1;
+    uint64_t mantissa = SUB_BUCKETS + index % SUB_BUCKETS;
+    // Wraps to UINT64_MAX for the very last bucket, which is what it should be
+    return ((mantissa + 1) << (magnitude - SUB_BUCKET_BITS)) - 1;
+}
+
+void LatencyHistogram::record(uint64_t value)
+{
+    this->buckets[bucket_index(value)].fetch_add(1, std::memory_order_relaxed);
+    this->total_count.fetch_add(1, std::memory_order_relaxed);
+    this->total_value.fetch_add(value, std::memory_order_relaxed);
+
+    uint64_t current = this->max_value.load(std::memory_order_relaxed);
+    while (value > current && !this->max_value.compare_exchange_weak(current, value, std::memory_order_relaxed))
+    {
+    }
+}
+
+uint64_t LatencyHistogram::count() const
+{
+    return this->total_count.load(std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::max() const
+{
+    return this->max_value.load(std::memory_order_relaxed);
+}
+
+double LatencyHistogram::mean() const
+{
+    uint64_t count = this->count();
+    return count == 0 ? 0.0 : static_cast<double>(this->total_value.load(std::memory_order_relaxed)) / count;
+}
+
+uint64_t LatencyHistogram::percentile(double percent) const
+{
+    uint64_t count = this->count();
+    if (count == 0)
+        return 0;
+
+    // Buckets may be a few increments ahead of the count while other threads
+    // record; that only shifts the result by a bucket
+    uint64_t target = static_cast<uint64_t>(percent / 100.0 * count + 0.5);
+    if (target == 0)
+        target = 1;
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BUCKET_COUNT; i++)
+    {
+        seen += this->buckets[i].load(std::memory_order_relaxed);
+        if (seen >= target)
+            return std::min(bucket_upper_bound(i), this->max());
+    }
+    return this->max();
+}
+
+const char *stage_name(Stage stage)
+{
+    switch (stage)
+    {
+    case Stage::PROCESS_LIST:
+        return "Process list";
+    case Stage::PROCESS_NETWORK:
+        return "Process network";
+    case Stage::CPU_UTILIZATION:
+        return "CPU utilization";
+    case Stage::PROCESS_COUNT:
+        return "Process count";
+    case Stage::CPU_CLOCK_SPEED:
+        return "CPU clock speed";
+    case Stage::MEMORY_INFO:
+        return "Memory info";
+    case Stage::HARDWARE:
+        return "Hardware";
+    case Stage::ANOMALY_DETECTION:
+        return "Anomaly detection";
+    case Stage::RENDER:
+        return "Render";
+    }
+    return "";
+}
+
+SelfMonitor::SelfMonitor()
+{
+    long page_size = sysconf(_SC_PAGESIZE);
+    this->page_kb = page_size > 0 ? page_size / 1024 : 4;
+}
+
+SelfMonitor &SelfMonitor::getInstance()
+{
+    static SelfMonitor instance;
+    return instance;
+}
+
+void SelfMonitor::record(Stage stage, std::chrono::nanoseconds duration)
+{
+    this->stages[static_cast<size_t>(stage)].record(static_cast<uint64_t>(std::max<int64_t>(0, duration.count())));
+}
+
+void SelfMonitor::record_tick()
+{
+    this->ticks.fetch_add(1, std::memory_order_relaxed);
+}
+
+const LatencyHistogram &SelfMonitor::get_histogram(Stage stage) const
+{
+    return this->stages[static_cast<size_t>(stage)];
+}
+
+uint64_t SelfMonitor::get_allocation_count()
+{
+    uint64_t total = 0;
+    for (const auto &shard : allocation_shards)
+        total += shard.value.load(std::memory_order_relaxed);
+    return total;
+}
+
+SelfUsage SelfMonitor::sample(std::chrono::milliseconds interval)
+{
+    auto now = std::chrono::steady_clock::now();
+    if (this->has_sample && now - this->last_sample_time < interval)
+        return this->last_usage;
+
+    timespec cpu{};
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &cpu);
+    auto cpu_time = std::chrono::seconds(cpu.tv_sec) + std::chrono::nanoseconds(cpu.tv_nsec);
+    uint64_t allocations = get_allocation_count();
+    uint64_t ticks = this->ticks.load(std::memory_order_relaxed);
+
+    SelfUsage usage;
+    usage.allocations = allocations;
+    usage.ticks = ticks;
+    if (this->has_sample)
+    {
+        double elapsed = std::chrono::duration<double>(now - this->last_sample_time).count();
+        if (elapsed > 0.0)
+            usage.cpu_percent = 100.0 * std::chrono::duration<double>(cpu_time - this->last_cpu_time).count() / elapsed;
+        if (ticks > this->last_ticks)
+            usage.allocations_per_tick = static_cast<double>(allocations - this->last_allocations) / (ticks - this->last_ticks);
+        else
+            usage.allocations_per_tick = this->last_usage.allocations_per_tick;
+    }
+
+    // statm: size resident shared text lib data dt, in pages
+    std::string_view statm = this->statm.read();
+    size_t space = statm.find(' ');
+    uint64_t resident_pages = 0;
+    if (space != std::string_view::npos)
+        parse_u64(statm.substr(space + 1), resident_pages);
+    usage.rss_kb = resident_pages * this->page_kb;
+
+    this->last_sample_time = now;
+    this->last_cpu_time = cpu_time;
+    this->last_allocations = allocations;
+    this->last_ticks = ticks;
+    this->last_usage = usage;
+    this->has_sample = true;
+    return usage;
+}
@@ -0,0 +1,130 @@
+#ifndef __SELF_MONITOR_HPP
+#define __SELF_MONITOR_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include "../proc_io/proc_file.hpp"
+
+// Log-linear latency histogram in the style of HdrHistogram: every power of
+// two is split into SUB_BUCKETS linear buckets, so any value is stored with
+// about 6% relative error in a fixed 8 KB. Recording is a few relaxed atomic
+// adds, so any thread can record without locking.
+class LatencyHistogram
+{
+public:
+    static constexpr int SUB_BUCKET_BITS = 4;
+    static constexpr size_t SUB_BUCKETS = size_t{1} << SUB_BUCKET_BITS;
+    static constexpr size_t BUCKET_COUNT = (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+private:
+    std::array<std::atomic<uint64_t>, BUCKET_COUNT> buckets{};
+    std::atomic<uint64_t> total_count{0};
+    std::atomic<uint64_t> total_value{0};
+    std::atomic<uint64_t> max_value{0};
+
+public:
+    static size_t bucket_index(uint64_t value);
+    // Largest value that falls into the bucket
+    static uint64_t bucket_upper_bound(size_t index);
+
+    void record(uint64_t value);
+
+    uint64_t count() const;
+    uint64_t max() const;
+    double mean() const;
+    // Smallest bucket bound at or below which the given percent of values fall
+    uint64_t percentile(double percent) const;
+};
+
+// Stages of collection and rendering Houston times itself on. PROCESS_LIST
+// includes the PROCESS_NETWORK lookups made while building the list.
+enum class Stage
+{
+    PROCESS_LIST,
+    PROCESS_NETWORK,
+    CPU_UTILIZATION,
+    PROCESS_COUNT,
+    CPU_CLOCK_SPEED,
+    MEMORY_INFO,
+    HARDWARE,
+    ANOMALY_DETECTION,
+    RENDER
+};
+
+constexpr size_t STAGE_COUNT = 9;
+
+const char *stage_name(Stage stage);
+
+// Houston's own footprint, as shown by the self-monitoring overlay
+struct SelfUsage
+{
+    double cpu_percent = 0.0; // Of one CPU, since the previous sample
+    uint64_t rss_kb = 0;
+    uint64_t allocations = 0; // Since start
+    uint64_t ticks = 0;       // Collector batches since start
+    double allocations_per_tick = 0.0;
+};
+
+// Process-wide timers and counters for Houston's own overhead. Stage latencies
+// go into per-stage histograms and heap allocations are counted through a
+// replaced operator new, both lock-free; CPU and RSS are only read when
+// sample() is called, so the cost while nobody looks is a clock read per stage.
+class SelfMonitor
+{
+private:
+    std::array<LatencyHistogram, STAGE_COUNT> stages;
+    std::atomic<uint64_t> ticks{0};
+
+    // Sampling state, only touched by the thread calling sample()
+    ProcFile statm{"/proc/self/statm", 256};
+    long page_kb;
+    SelfUsage last_usage;
+    std::chrono::steady_clock::time_point last_sample_time;
+    std::chrono::nanoseconds last_cpu_time{0};
+    uint64_t last_allocations = 0;
+    uint64_t last_ticks = 0;
+    bool has_sample = false;
+
+    SelfMonitor();
+
+public:
+    static SelfMonitor &getInstance();
+
+    void record(Stage stage, std::chrono::nanoseconds duration);
+    // Counts one collector batch, the unit allocations are reported per
+    void record_tick();
+
+    const LatencyHistogram &get_histogram(Stage stage) const;
+
+    // Refreshes CPU, RSS and allocation rates at most once per interval and
+    // returns the latest values
+    SelfUsage sample(std::chrono::milliseconds interval = std::chrono::milliseconds(1000));
+
+    // Heap allocations made through operator new by every thread so far
+    static uint64_t get_allocation_count();
+};
+
+// Records the time between construction and destruction against a stage
+class StageTimer
+{
+private:
+    Stage stage;
+    std::chrono::steady_clock::time_point start;
+
+public:
+    explicit StageTimer(Stage stage)
+        : stage(stage), start(std::chrono::steady_clock::now())
+    {
+    }
+    ~StageTimer()
+    {
+        SelfMonitor::getInstance().record(this->stage, std::chrono::steady_clock::now() - this->start);
+    }
+    StageTimer(const StageTimer &) = delete;
+    StageTimer &operator=(const StageTimer &) = delete;
+};
+
+#endif /* __SELF_MONITOR_HPP */
@@ -0,0 +1,283 @@
+#ifndef __TIME_SERIES_HPP
+#define __TIME_SERIES_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Fixed-capacity circular buffer. Pushing into a full buffer overwrites the
+// oldest sample in O(1) instead of shifting everything like vector::erase.
+// Index 0 is the oldest sample, size() - 1 the newest.
+template <typename T>
+class RingBuffer
+{
+private:
+    std::vector<T> data;
+    size_t head = 0; // Slot the next push writes to
+    size_t count = 0;
+
+public:
+    explicit RingBuffer(size_t capacity = 60)
+        : data(capacity == 0 ? 1 : capacity)
+    {
+    }
+
+    void push(const T &value)
+    {
+        this->data[this->head] = value;
+        this->head = (this->head + 1) % this->data.size();
+        if (this->count < this->data.size())
+            this->count++;
+    }
+
+    const T &operator[](size_t index) const
+    {
+        size_t start = (this->head + this->data.size() - this->count) % this->data.size();
+        return this->data[(start + index) % this->data.size()];
+    }
+
+    const T &back() const
+    {
+        return (*this)[this->count - 1];
+    }
+
+    // Overwrites the newest sample; the buffer must not be empty
+    void replace_back(const T &value)
+    {
+        this->data[(this->head + this->data.size() - 1) % this->data.size()] = value;
+    }
+
+    size_t size() const
+    {
+        return this->count;
+    }
+    size_t capacity() const
+    {
+        return this->data.size();
+    }
+    bool empty() const
+    {
+        return this->count == 0;
+    }
+    bool full() const
+    {
+        return this->count == this->data.size();
+    }
+
+    void clear()
+    {
+        this->head = 0;
+        this->count = 0;
+    }
+
+    std::vector<T> to_vector() const
+    {
+        std::vector<T> values;
+        values.reserve(this->count);
+        for (size_t i = 0; i < this->count; i++)
+            values.push_back((*this)[i]);
+        return values;
+    }
+};
+
+// Summary of a window of samples produced by a roll-up
+template <typename T>
+struct Rollup
+{
+    T min{};
+    T avg{};
+    T max{};
+};
+
+enum class Resolution
+{
+    SECONDS,
+    MINUTES,
+    HOURS
+};
+
+// Multi-resolution history for one metric, bucketed by the time each sample
+// was taken rather than by how many were pushed, so the ranges stay right
+// whatever the collector interval is. The raw tier keeps one point per period
+// (the newest sample in it); the minute tier summarises (min/avg/max) every
+// periods_per_rollup periods, and the hour tier every periods_per_rollup
+// minutes. Periods or windows that passed without a sample repeat the previous
+// point, so every point of a tier covers the same span of time. With the
+// default capacities that keeps the last minute, hour and day in constant memory.
+template <typename T>
+class TimeSeries
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+private:
+    struct Accumulator
+    {
+        T min{};
+        T max{};
+        double sum = 0.0;
+        size_t count = 0;
+
+        void add(T min_value, T avg_value, T max_value)
+        {
+            this->min = this->count == 0 ? min_value : std::min(this->min, min_value);
+            this->max = this->count == 0 ? max_value : std::max(this->max, max_value);
+            this->sum += avg_value;
+            this->count++;
+        }
+
+        Rollup<T> take()
+        {
+            Rollup<T> rollup{this->min, static_cast<T>(this->sum / this->count), this->max};
+            *this = Accumulator{};
+            return rollup;
+        }
+    };
+
+    size_t periods_per_rollup;
+    Clock::duration period;
+    Clock::time_point origin; // Time of the first sample; window indices count periods from it
+    bool started = false;
+    uint64_t second_index = 0; // Period of the newest raw point
+    uint64_t minute_index = 0; // Window the minute accumulator is filling
+    uint64_t hour_index = 0;
+    RingBuffer<T> second_samples;
+    RingBuffer<Rollup<T>> minute_samples;
+    RingBuffer<Rollup<T>> hour_samples;
+    Accumulator minute_accumulator;
+    Accumulator hour_accumulator;
+
+    // Closes the open window once a sample falls into a later one, repeating it
+    // for the windows skipped in between
+    static void advance(RingBuffer<Rollup<T>> &tier, Accumulator &accumulator, uint64_t &open_index, uint64_t index)
+    {
+        if (index <= open_index)
+            return;
+
+        Rollup<T> closed = accumulator.take();
+        uint64_t windows = std::min<uint64_t>(index - open_index, tier.capacity());
+        for (uint64_t i = 0; i < windows; i++)
+            tier.push(closed);
+        open_index = index;
+    }
+
+public:
+    explicit TimeSeries(size_t seconds_capacity = 60, size_t minutes_capacity = 60, size_t hours_capacity = 24,
+                        size_t periods_per_rollup = 60, Clock::duration period = std::chrono::seconds(1))
+        : periods_per_rollup(periods_per_rollup == 0 ? 1 : periods_per_rollup),
+          period(period <= Clock::duration::zero() ? std::chrono::seconds(1) : period),
+          second_samples(seconds_capacity),
+          minute_samples(minutes_capacity),
+          hour_samples(hours_capacity)
+    {
+    }
+
+    void push(T value, Clock::time_point time = Clock::now())
+    {
+        if (!this->started)
+        {
+            this->origin = time;
+            this->started = true;
+        }
+        uint64_t index = time > this->origin ? static_cast<uint64_t>((time - this->origin) / this->period) : 0;
+        index = std::max(index, this->second_index);
+
+        if (this->second_samples.empty() || index == this->second_index)
+        {
+            if (this->second_samples.empty())
+                this->second_samples.push(value);
+            else
+                this->second_samples.replace_back(value);
+        }
+        else
+        {
+            T previous = this->second_samples.back();
+            uint64_t skipped = std::min<uint64_t>(index - this->second_index - 1, this->second_samples.capacity());
+            for (uint64_t i = 0; i < skipped; i++)
+                this->second_samples.push(previous);
+            this->second_samples.push(value);
+        }
+        this->second_index = index;
+
+        advance(this->minute_samples, this->minute_accumulator, this->minute_index, index / this->periods_per_rollup);
+        this->minute_accumulator.add(value, value, value);
+
+        uint64_t periods_per_hour = this->periods_per_rollup * this->periods_per_rollup;
+        advance(this->hour_samples, this->hour_accumulator, this->hour_index, index / periods_per_hour);
+        this->hour_accumulator.add(value, value, value);
+    }
+
+    const RingBuffer<T> &seconds() const
+    {
+        return this->second_samples;
+    }
+    const RingBuffer<Rollup<T>> &minutes() const
+    {
+        return this->minute_samples;
+    }
+    const RingBuffer<Rollup<T>> &hours() const
+    {
+        return this->hour_samples;
+    }
+
+    // Number of points the given resolution can hold when full
+    size_t capacity(Resolution resolution) const
+    {
+        switch (resolution)
+        {
+        case Resolution::MINUTES:
+            return this->minute_samples.capacity();
+        case Resolution::HOURS:
+            return this->hour_samples.capacity();
+        default:
+            return this->second_samples.capacity();
+        }
+    }
+
+    // Oldest-to-newest values at the given resolution; roll-up tiers report
+    // their averages.
+    std::vector<T> values(Resolution resolution) const
+    {
+        if (resolution == Resolution::SECONDS)
+            return this->second_samples.to_vector();
+
+        const RingBuffer<Rollup<T>> &tier = resolution == Resolution::MINUTES ? this->minute_samples : this->hour_samples;
+        std::vector<T> averages;
+        averages.reserve(tier.size());
+        for (size_t i = 0; i < tier.size(); i++)
+            averages.push_back(tier[i].avg);
+        return averages;
+    }
+
+    // Newest raw sample, or a default value when empty
+    T latest() const
+    {
+        return this->second_samples.empty() ? T{} : this->second_samples.back();
+    }
+
+    size_t size() const
+    {
+        return this->second_samples.size();
+    }
+    bool empty() const
+    {
+        return this->second_samples.empty();
+    }
+
+    void clear()
+    {
+        this->second_samples.clear();
+        this->minute_samples.clear();
+        this->hour_samples.clear();
+        this->minute_accumulator = Accumulator{};
+        this->hour_accumulator = Accumulator{};
+        this->started = false;
+        this->second_index = 0;
+        this->minute_index = 0;
+        this->hour_index = 0;
+    }
+};
+
+#endif /* __TIME_SERIES_HPP */
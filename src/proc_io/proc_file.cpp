@@ -0,0 +1,187 @@
+#include "proc_file.hpp"
+#include <charconv>
+#include <fcntl.h>
+#include <unistd.h>
+
+ProcFileStats &proc_file_stats()
+{
+    static ProcFileStats stats;
+    return stats;
+}
+
+ProcFile::ProcFile(std::string path, size_t initial_capacity, bool read_to_eof)
+    : path(std::move(path)), buffer(initial_capacity), read_to_eof(read_to_eof)
+{
+    this->reopen();
+}
+
+ProcFile::~ProcFile()
+{
+    this->close();
+}
+
+ProcFile::ProcFile(ProcFile &&other) noexcept
+    : path(std::move(other.path)), fd(other.fd), buffer(std::move(other.buffer)), read_to_eof(other.read_to_eof)
+{
+    other.fd = -1;
+}
+
+ProcFile &ProcFile::operator=(ProcFile &&other) noexcept
+{
+    if (this != &other)
+    {
+        this->close();
+        this->path = std::move(other.path);
+        this->fd = other.fd;
+        this->buffer = std::move(other.buffer);
+        this->read_to_eof = other.read_to_eof;
+        other.fd = -1;
+    }
+    return *this;
+}
+
+bool ProcFile::reopen()
+{
+    this->close();
+    if (this->path.empty())
+        return false;
+    this->fd = ::open(this->path.c_str(), O_RDONLY | O_CLOEXEC);
+    proc_file_stats().opens.fetch_add(1, std::memory_order_relaxed);
+    return this->fd >= 0;
+}
+
+void ProcFile::close()
+{
+    if (this->fd >= 0)
+    {
+        ::close(this->fd);
+        proc_file_stats().closes.fetch_add(1, std::memory_order_relaxed);
+        this->fd = -1;
+    }
+}
+
+std::string_view ProcFile::read()
+{
+    if (this->fd < 0)
+        return {};
+
+    if (this->buffer.empty())
+        this->buffer.resize(4096);
+
+    size_t total = 0;
+    while (true)
+    {
+        ssize_t len = pread(this->fd, this->buffer.data() + total, this->buffer.size() - total, total);
+        proc_file_stats().reads.fetch_add(1, std::memory_order_relaxed);
+        if (len < 0)
+            return {};
+        if (len == 0)
+            break;
+
+        total += len;
+        if (total < this->buffer.size())
+        {
+            if (!this->read_to_eof)
+                break;
+            continue;
+        }
+        this->buffer.resize(this->buffer.size() * 2);
+    }
+
+    return std::string_view(this->buffer.data(), total);
+}
+
+ProcFileCache::ProcFileCache(size_t capacity)
+    : capacity(capacity == 0 ? 1 : capacity)
+{
+}
+
+std::string_view ProcFileCache::read(const std::string &path)
+{
+    auto it = this->index.find(path);
+    if (it != this->index.end())
+    {
+        // Move to the front (most recently used) without touching the descriptor
+        this->files.splice(this->files.begin(), this->files, it->second);
+        std::string_view contents = this->files.front().read();
+        if (!contents.empty())
+            return contents;
+
+        // The descriptor may be stale (the pid exited or was reused); retry once
+        if (!this->files.front().reopen())
+        {
+            this->evict(path);
+            return {};
+        }
+        return this->files.front().read();
+    }
+
+    ProcFile file(path, 1024);
+    if (!file.is_open())
+        return {};
+
+    if (this->files.size() >= this->capacity)
+    {
+        this->index.erase(this->files.back().get_path());
+        this->files.pop_back();
+    }
+
+    this->files.push_front(std::move(file));
+    this->index[path] = this->files.begin();
+    return this->files.front().read();
+}
+
+void ProcFileCache::evict(const std::string &path)
+{
+    auto it = this->index.find(path);
+    if (it == this->index.end())
+        return;
+    this->files.erase(it->second);
+    this->index.erase(it);
+}
+
+void ProcFileCache::set_capacity(size_t capacity)
+{
+    this->capacity = capacity == 0 ? 1 : capacity;
+    while (this->files.size() > this->capacity)
+    {
+        this->index.erase(this->files.back().get_path());
+        this->files.pop_back();
+    }
+}
+
+void ProcFileCache::clear()
+{
+    this->index.clear();
+    this->files.clear();
+}
+
+std::string_view find_field(std::string_view contents, std::string_view key)
+{
+    size_t pos = 0;
+    while (pos < contents.size())
+    {
+        size_t end = contents.find('\n', pos);
+        if (end == std::string_view::npos)
+            end = contents.size();
+
+        std::string_view line = contents.substr(pos, end - pos);
+        if (line.starts_with(key))
+        {
+            std::string_view value = line.substr(key.size());
+            size_t start = value.find_first_not_of(" \t:");
+            return start == std::string_view::npos ? std::string_view{} : value.substr(start);
+        }
+        pos = end + 1;
+    }
+    return {};
+}
+
+bool parse_u64(std::string_view text, uint64_t &value)
+{
+    size_t start = text.find_first_not_of(" \t");
+    if (start == std::string_view::npos)
+        return false;
+    auto result = std::from_chars(text.data() + start, text.data() + text.size(), value);
+    return result.ec == std::errc();
+}
@@ -0,0 +1,107 @@
+#ifndef __PROC_FILE_HPP
+#define __PROC_FILE_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Counters for every syscall issued through ProcFile, used to compare against
+// the open/read/close pattern of a fresh std::ifstream per read.
+struct ProcFileStats
+{
+    std::atomic<uint64_t> opens{0};
+    std::atomic<uint64_t> reads{0};
+    std::atomic<uint64_t> closes{0};
+};
+
+ProcFileStats &proc_file_stats();
+
+// A /proc or /sys file that stays open between reads. Each read() rewinds with
+// pread(fd, buf, n, 0) into a buffer owned by the ProcFile, so steady-state
+// reads cost one syscall and no allocation. The returned view is valid until
+// the next read() or until the ProcFile is destroyed.
+//
+// seq_file-backed /proc files and sysfs attributes hand out everything they
+// have in one read, so a short read is treated as EOF. Files whose handlers
+// return at most a page per call (/proc/[pid]/cmdline, environ) need
+// read_to_eof so the loop keeps going until pread() returns 0.
+class ProcFile
+{
+private:
+    std::string path;
+    int fd = -1;
+    std::vector<char> buffer;
+    bool read_to_eof = false;
+
+public:
+    explicit ProcFile(std::string path, size_t initial_capacity = 4096, bool read_to_eof = false);
+    ~ProcFile();
+    ProcFile(ProcFile &&other) noexcept;
+    ProcFile &operator=(ProcFile &&other) noexcept;
+    ProcFile(const ProcFile &) = delete;
+    ProcFile &operator=(const ProcFile &) = delete;
+
+    bool is_open() const
+    {
+        return this->fd >= 0;
+    }
+    const std::string &get_path() const
+    {
+        return this->path;
+    }
+
+    // Re-reads the whole file. Returns an empty view if it could not be read.
+    std::string_view read();
+
+    // Closes and reopens the file, e.g. after the process behind a /proc/[pid]
+    // file has exited and the old descriptor went stale.
+    bool reopen();
+    void close();
+};
+
+// Bounded LRU of open ProcFiles keyed by path, for per-pid files where keeping
+// every descriptor open would exhaust RLIMIT_NOFILE on busy hosts.
+class ProcFileCache
+{
+private:
+    size_t capacity;
+    std::list<ProcFile> files;
+    std::unordered_map<std::string, std::list<ProcFile>::iterator> index;
+
+public:
+    explicit ProcFileCache(size_t capacity);
+
+    // Reads path through a cached descriptor, opening (and evicting the least
+    // recently used entry) on a miss. Returns an empty view on failure.
+    std::string_view read(const std::string &path);
+    void evict(const std::string &path);
+    void clear();
+    bool contains(const std::string &path) const
+    {
+        return this->index.count(path) != 0;
+    }
+    // Shrinking closes the least recently used files beyond the new capacity
+    void set_capacity(size_t capacity);
+
+    size_t size() const
+    {
+        return this->files.size();
+    }
+    size_t get_capacity() const
+    {
+        return this->capacity;
+    }
+};
+
+// Returns the value following "key" on the line that starts with it, e.g.
+// find_field(status, "read_bytes:") on /proc/[pid]/io. Empty if not present.
+std::string_view find_field(std::string_view contents, std::string_view key);
+
+// Parses a leading (optionally whitespace-prefixed) unsigned integer.
+bool parse_u64(std::string_view text, uint64_t &value);
+
+#endif /* __PROC_FILE_HPP */
@@ -1,5 +1,5 @@
 #include "network_tracker.hpp"
-#include <fstream>
+#include "../metrics/self_monitor.hpp"
 #include <sstream>
 #include <dirent.h>
 #include <unistd.h>
@@ -41,33 +41,27 @@ unsigned long NetworkTracker::getSocketBytesForPid(pid_t pid) {
 
     closedir(dir);
 
-    std::stringstream io_path;
-    io_path << "/proc/" << pid << "/io";
-    std::ifstream io_file(io_path.str());
+    // Only processes with open sockets are attributed any traffic
+    if (total_bytes == 0) {
+        return 0;
+    }
 
-    if (io_file.is_open()) {
-        std::string line;
-        unsigned long read_bytes = 0, write_bytes = 0;
+    std::string io_path = "/proc/" + std::to_string(pid) + "/io";
+    std::string_view io_contents = io_files.read(io_path);
 
-        while (std::getline(io_file, line)) {
-            if (line.find("read_bytes:") == 0) {
-                sscanf(line.c_str(), "read_bytes: %lu", &read_bytes);
-            } else if (line.find("write_bytes:") == 0) {
-                sscanf(line.c_str(), "write_bytes: %lu", &write_bytes);
-            }
-        }
+    if (!io_contents.empty()) {
+        uint64_t read_bytes = 0, write_bytes = 0;
+        parse_u64(find_field(io_contents, "read_bytes:"), read_bytes);
+        parse_u64(find_field(io_contents, "write_bytes:"), write_bytes);
 
-        if (total_bytes > 0) {
-            total_bytes = (read_bytes + write_bytes) / 1024;
-        } else {
-            total_bytes = 0;
-        }
+        total_bytes = (read_bytes + write_bytes) / 1024;
     }
 
     return total_bytes;
 }
 
 unsigned long NetworkTracker::getProcessNetworkUsage(pid_t pid) {
+    StageTimer timer(Stage::PROCESS_NETWORK);
     std::lock_guard<std::mutex> lock(tracker_mutex);
 
     unsigned long current_bytes = getSocketBytesForPid(pid);
@@ -4,6 +4,7 @@
 #include <sys/types.h>
 #include <map>
 #include <mutex>
+#include "../proc_io/proc_file.hpp"
 
 class NetworkTracker {
 public:
@@ -16,6 +17,7 @@ private:
     std::map<pid_t, unsigned long> process_bytes;
     std::map<pid_t, unsigned long> last_bytes;
     std::mutex tracker_mutex;
+    ProcFileCache io_files{512};
 
     unsigned long getSocketBytesForPid(pid_t pid);
 };
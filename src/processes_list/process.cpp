@@ -13,7 +13,7 @@ pid_t Process::get_pid() const
     return pid;
 }
 
-std::string Process::get_process_name() const
+const std::string& Process::get_process_name() const
 {
     return process_name;
 }
@@ -38,7 +38,7 @@ unsigned long Process::get_cpu_time() const
     return cpu_time;
 }
 
-std::string Process::get_command() const
+const std::string& Process::get_command() const
 {
     return command;
 }
@@ -73,6 +73,46 @@ void Process::set_command(const std::string& cmd)
     command = cmd;
 }
 
+uid_t Process::get_uid() const
+{
+    return uid;
+}
+
+void Process::set_uid(uid_t owner_uid)
+{
+    uid = owner_uid;
+}
+
+pid_t Process::get_parent_pid() const
+{
+    return parent_pid;
+}
+
+void Process::set_parent_pid(pid_t ppid)
+{
+    parent_pid = ppid;
+}
+
+int Process::get_nice() const
+{
+    return nice;
+}
+
+void Process::set_nice(int niceness)
+{
+    nice = niceness;
+}
+
+uint64_t Process::get_start_time() const
+{
+    return start_time;
+}
+
+void Process::set_start_time(uint64_t started)
+{
+    start_time = started;
+}
+
 bool Process::kill(int signal_number)
 {
     if (::kill(pid, signal_number) == 0)
@@ -1,6 +1,7 @@
 #ifndef __PROCESS_HPP
 #define __PROCESS_HPP
 
+#include <cstdint>
 #include <string>
 #include <sys/types.h>
 #include <signal.h>
@@ -15,17 +16,28 @@ private:
     unsigned long network_usage;
     unsigned long cpu_time;
     std::string command;
+    uid_t uid = static_cast<uid_t>(-1);
+    pid_t parent_pid = 0;
+    int nice = 0;
+    // When the process started, in the backend's own units (clock ticks after
+    // boot from /proc, seconds since the epoch from libstatgrab). Only compared
+    // for equality, to tell a reused pid apart; 0 if unknown.
+    uint64_t start_time = 0;
 
 public:
     Process(pid_t pid, const std::string& name = "", unsigned long memory = 0, double cpu = 0.0, unsigned long network = 0, unsigned long time = 0, const std::string& cmd = "");
 
     pid_t get_pid() const;
-    std::string get_process_name() const;
+    const std::string& get_process_name() const;
     unsigned long get_memory_usage() const;
     double get_cpu_usage() const;
     unsigned long get_network_usage() const;
     unsigned long get_cpu_time() const;
-    std::string get_command() const;
+    const std::string& get_command() const;
+    uid_t get_uid() const;
+    pid_t get_parent_pid() const;
+    int get_nice() const;
+    uint64_t get_start_time() const;
 
     void set_process_name(const std::string& name);
     void set_memory_usage(unsigned long memory);
@@ -33,6 +45,10 @@ public:
     void set_network_usage(unsigned long network);
     void set_cpu_time(unsigned long time);
     void set_command(const std::string& cmd);
+    void set_uid(uid_t owner_uid);
+    void set_parent_pid(pid_t ppid);
+    void set_nice(int niceness);
+    void set_start_time(uint64_t started);
 
     bool kill(int signal_number);
 
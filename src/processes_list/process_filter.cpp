@@ -0,0 +1,308 @@
+#include "process_filter.hpp"
+#include <charconv>
+#include <pwd.h>
+#include <unistd.h>
+
+struct FieldName
+{
+    std::string_view name;
+    FilterField field;
+};
+
+static const FieldName field_names[] = {
+    {"pid", FilterField::PID},
+    {"cpu", FilterField::CPU},
+    {"mem", FilterField::MEMORY},
+    {"memory", FilterField::MEMORY},
+    {"net", FilterField::NETWORK},
+    {"network", FilterField::NETWORK},
+    {"time", FilterField::TIME},
+    {"user", FilterField::USER},
+    {"uid", FilterField::USER},
+    {"name", FilterField::NAME},
+    {"cmd", FilterField::COMMAND},
+    {"command", FilterField::COMMAND},
+};
+
+static bool is_operator_char(char c)
+{
+    return c == '<' || c == '>' || c == '=' || c == '!' || c == '~';
+}
+
+// Splits "cpu>=20" into field "cpu", operator ">=" and value "20"
+static bool split_term(std::string_view token, std::string_view &field, std::string_view &op, std::string_view &value)
+{
+    size_t op_start = 0;
+    while (op_start < token.size() && !is_operator_char(token[op_start]))
+        op_start++;
+    if (op_start == 0 || op_start == token.size())
+        return false;
+
+    size_t op_end = op_start + 1;
+    if (op_end < token.size() && token[op_end] == '=' && token[op_start] != '=' && token[op_start] != '~')
+        op_end++;
+
+    field = token.substr(0, op_start);
+    op = token.substr(op_start, op_end - op_start);
+    value = token.substr(op_end);
+    return true;
+}
+
+static const FieldName *find_field_name(std::string_view name)
+{
+    for (const auto &field_name : field_names)
+    {
+        if (field_name.name == name)
+            return &field_name;
+    }
+    return nullptr;
+}
+
+static bool is_text_field(FilterField field)
+{
+    return field == FilterField::NAME || field == FilterField::COMMAND;
+}
+
+bool ProcessFilter::looks_like_filter(std::string_view query)
+{
+    size_t pos = 0;
+    while (pos < query.size())
+    {
+        size_t end = query.find(' ', pos);
+        if (end == std::string_view::npos)
+            end = query.size();
+        std::string_view token = query.substr(pos, end - pos);
+        pos = end + 1;
+
+        if (token.starts_with('!'))
+            token.remove_prefix(1);
+        std::string_view field, op, value;
+        if (split_term(token, field, op, value) && find_field_name(field) != nullptr)
+            return true;
+    }
+    return false;
+}
+
+bool ProcessFilter::parse_term(std::string_view token, FilterTerm &term)
+{
+    if (token.starts_with('!'))
+    {
+        term.negated = true;
+        token.remove_prefix(1);
+    }
+
+    std::string_view field, op, value;
+    if (!split_term(token, field, op, value))
+    {
+        this->error = "expected field, operator and value: " + std::string(token);
+        return false;
+    }
+
+    const FieldName *field_name = find_field_name(field);
+    if (field_name == nullptr)
+    {
+        this->error = "unknown field: " + std::string(field);
+        return false;
+    }
+    term.field = field_name->field;
+
+    if (op == "<")
+        term.op = FilterOp::LESS;
+    else if (op == "<=")
+        term.op = FilterOp::LESS_EQUAL;
+    else if (op == ">")
+        term.op = FilterOp::GREATER;
+    else if (op == ">=")
+        term.op = FilterOp::GREATER_EQUAL;
+    else if (op == "=")
+        term.op = FilterOp::EQUAL;
+    else if (op == "!=")
+        term.op = FilterOp::NOT_EQUAL;
+    else if (op == "~")
+        term.op = FilterOp::MATCHES;
+    else
+    {
+        this->error = "unknown operator: " + std::string(op);
+        return false;
+    }
+
+    if (value.empty())
+    {
+        this->error = "missing value for " + std::string(field);
+        return false;
+    }
+
+    if (is_text_field(term.field))
+    {
+        if (term.op != FilterOp::EQUAL && term.op != FilterOp::NOT_EQUAL && term.op != FilterOp::MATCHES)
+        {
+            this->error = std::string(field) + " only supports =, != and ~";
+            return false;
+        }
+        term.text = std::string(value);
+        if (term.op == FilterOp::MATCHES)
+        {
+            try
+            {
+                term.pattern = std::make_shared<std::regex>(term.text, std::regex::ECMAScript | std::regex::icase | std::regex::optimize);
+            }
+            catch (const std::regex_error &)
+            {
+                this->error = "invalid pattern: " + term.text;
+                return false;
+            }
+        }
+        return true;
+    }
+
+    if (term.op == FilterOp::MATCHES)
+    {
+        this->error = "~ only works on name and cmd";
+        return false;
+    }
+
+    auto result = std::from_chars(value.data(), value.data() + value.size(), term.number);
+    if (result.ec == std::errc() && result.ptr == value.data() + value.size())
+        return true;
+
+    // Users can be given by name; resolve to a uid once, here
+    if (term.field == FilterField::USER && (term.op == FilterOp::EQUAL || term.op == FilterOp::NOT_EQUAL))
+    {
+        std::string user_name(value);
+        struct passwd pwd;
+        struct passwd *found = nullptr;
+        char buffer[4096];
+        if (getpwnam_r(user_name.c_str(), &pwd, buffer, sizeof(buffer), &found) == 0 && found != nullptr)
+        {
+            term.number = found->pw_uid;
+            return true;
+        }
+        this->error = "unknown user: " + user_name;
+        return false;
+    }
+
+    this->error = "expected a number for " + std::string(field) + ": " + std::string(value);
+    return false;
+}
+
+bool ProcessFilter::compile(std::string_view query)
+{
+    this->alternatives.clear();
+    this->error.clear();
+
+    std::vector<FilterTerm> conjunction;
+    size_t pos = 0;
+    while (pos <= query.size())
+    {
+        size_t end = query.find(' ', pos);
+        if (end == std::string_view::npos)
+            end = query.size();
+        std::string_view token = query.substr(pos, end - pos);
+        pos = end + 1;
+
+        if (token.empty())
+            continue;
+        if (token == "|" || token == "or")
+        {
+            if (!conjunction.empty())
+                this->alternatives.push_back(std::move(conjunction));
+            conjunction.clear();
+            continue;
+        }
+
+        FilterTerm term;
+        if (!this->parse_term(token, term))
+        {
+            this->alternatives.clear();
+            return false;
+        }
+        conjunction.push_back(std::move(term));
+    }
+    if (!conjunction.empty())
+        this->alternatives.push_back(std::move(conjunction));
+
+    if (this->alternatives.empty())
+    {
+        this->error = "empty filter";
+        return false;
+    }
+    return true;
+}
+
+template <typename T>
+static bool compare(FilterOp op, T lhs, T rhs)
+{
+    switch (op)
+    {
+    case FilterOp::LESS:
+        return lhs < rhs;
+    case FilterOp::LESS_EQUAL:
+        return lhs <= rhs;
+    case FilterOp::GREATER:
+        return lhs > rhs;
+    case FilterOp::GREATER_EQUAL:
+        return lhs >= rhs;
+    case FilterOp::EQUAL:
+        return lhs == rhs;
+    case FilterOp::NOT_EQUAL:
+        return lhs != rhs;
+    default:
+        return false;
+    }
+}
+
+static bool evaluate(const FilterTerm &term, const Process &process)
+{
+    bool result = false;
+    switch (term.field)
+    {
+    case FilterField::PID:
+        result = compare<double>(term.op, process.get_pid(), term.number);
+        break;
+    case FilterField::CPU:
+        result = compare<double>(term.op, process.get_cpu_usage(), term.number);
+        break;
+    case FilterField::MEMORY:
+        result = compare<double>(term.op, process.get_memory_usage() / 1024.0, term.number);
+        break;
+    case FilterField::NETWORK:
+        result = compare<double>(term.op, process.get_network_usage(), term.number);
+        break;
+    case FilterField::TIME:
+        result = compare<double>(term.op, process.get_cpu_time(), term.number);
+        break;
+    case FilterField::USER:
+        result = compare<double>(term.op, process.get_uid(), term.number);
+        break;
+    case FilterField::NAME:
+    case FilterField::COMMAND:
+    {
+        const std::string &text = term.field == FilterField::NAME ? process.get_process_name() : process.get_command();
+        if (term.op == FilterOp::MATCHES)
+            result = std::regex_search(text, *term.pattern);
+        else
+            result = (text == term.text) == (term.op == FilterOp::EQUAL);
+        break;
+    }
+    }
+    return result != term.negated;
+}
+
+bool ProcessFilter::matches(const Process &process) const
+{
+    for (const auto &conjunction : this->alternatives)
+    {
+        bool all = true;
+        for (const auto &term : conjunction)
+        {
+            if (!evaluate(term, process))
+            {
+                all = false;
+                break;
+            }
+        }
+        if (all)
+            return true;
+    }
+    return false;
+}
@@ -0,0 +1,82 @@
+#ifndef __PROCESS_FILTER_HPP
+#define __PROCESS_FILTER_HPP
+
+#include "process.hpp"
+#include <memory>
+#include <regex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+enum class FilterField
+{
+    PID,
+    CPU,
+    MEMORY, // MB, like the table column
+    NETWORK,
+    TIME,
+    USER,
+    NAME,
+    COMMAND
+};
+
+enum class FilterOp
+{
+    LESS,
+    LESS_EQUAL,
+    GREATER,
+    GREATER_EQUAL,
+    EQUAL,
+    NOT_EQUAL,
+    MATCHES // Regex search, text fields only
+};
+
+// One comparison, with its value already converted to the field's type
+struct FilterTerm
+{
+    FilterField field = FilterField::PID;
+    FilterOp op = FilterOp::EQUAL;
+    bool negated = false;
+    double number = 0.0;
+    std::string text;
+    std::shared_ptr<std::regex> pattern;
+};
+
+// Structured process filter for the search bar, e.g.
+//
+//     cpu>20 mem>1024 name~^java user=svc net>0
+//
+// Whitespace-separated terms must all match; "|" separates alternatives and a
+// leading "!" negates a term. Fields: pid, cpu, mem (MB), net (bytes), time
+// (seconds), user (name or uid), name, cmd. Operators: < <= > >= = != and ~
+// (case-insensitive regex). The query is parsed once; matching only compares
+// numbers, except for the name/cmd terms.
+class ProcessFilter
+{
+private:
+    // Alternatives of conjunctions: (a AND b) OR (c)
+    std::vector<std::vector<FilterTerm>> alternatives;
+    std::string error;
+
+    bool parse_term(std::string_view token, FilterTerm &term);
+
+public:
+    // True when the query uses field/operator syntax rather than plain text
+    static bool looks_like_filter(std::string_view query);
+
+    // Parses the query; on failure returns false and leaves a message in get_error()
+    bool compile(std::string_view query);
+
+    bool matches(const Process &process) const;
+
+    const std::string &get_error() const
+    {
+        return this->error;
+    }
+    bool empty() const
+    {
+        return this->alternatives.empty();
+    }
+};
+
+#endif
@@ -0,0 +1,420 @@
+#include "process_inspector.hpp"
+#include "../proc_io/proc_file.hpp"
+#include <algorithm>
+#include <filesystem>
+
+const char *inspection_section_name(InspectionSection section)
+{
+    switch (section)
+    {
+    case InspectionSection::FILES:
+        return "Open Files";
+    case InspectionSection::MEMORY_MAP:
+        return "Memory Map";
+    case InspectionSection::LIMITS:
+        return "Limits";
+    case InspectionSection::CGROUP:
+        return "Cgroup";
+    case InspectionSection::NAMESPACES:
+        return "Namespaces";
+    case InspectionSection::ENVIRONMENT:
+        return "Environment";
+    case InspectionSection::WCHAN:
+        return "Wait Channel";
+    }
+    return "";
+}
+
+static std::string_view trim(std::string_view text)
+{
+    while (!text.empty() && (text.front() == ' ' || text.front() == '\t'))
+        text.remove_prefix(1);
+    while (!text.empty() && (text.back() == ' ' || text.back() == '\t' || text.back() == '\n'))
+        text.remove_suffix(1);
+    return text;
+}
+
+static std::string format_kb(uint64_t kb)
+{
+    if (kb >= 10 * 1024 * 1024)
+        return std::to_string(kb / (1024 * 1024)) + " GB";
+    if (kb >= 10 * 1024)
+        return std::to_string(kb / 1024) + " MB";
+    return std::to_string(kb) + " kB";
+}
+
+FdSummary summarize_fd_targets(const std::vector<std::string> &targets)
+{
+    FdSummary summary;
+    for (const auto &target : targets)
+    {
+        summary.total++;
+        if (target.rfind("socket:", 0) == 0)
+            summary.sockets++;
+        else if (target.rfind("pipe:", 0) == 0)
+            summary.pipes++;
+        else if (target.rfind("anon_inode:", 0) == 0)
+            summary.anon_inodes++;
+        else if (target.rfind("/dev/", 0) == 0)
+            summary.devices++;
+        else if (!target.empty() && target.front() == '/')
+            summary.files++;
+        else
+            summary.other++;
+    }
+    return summary;
+}
+
+// smaps is a header line per mapping ("start-end perms offset dev inode [path]")
+// followed by "Key:   value kB" lines for it
+MemoryMapSummary parse_smaps(std::string_view smaps)
+{
+    MemoryMapSummary summary;
+    uint64_t *current = nullptr;
+
+    size_t pos = 0;
+    while (pos < smaps.size())
+    {
+        size_t end = smaps.find('\n', pos);
+        if (end == std::string_view::npos)
+            end = smaps.size();
+        std::string_view line = smaps.substr(pos, end - pos);
+        pos = end + 1;
+        if (line.empty())
+            continue;
+
+        size_t colon = line.find(':');
+        size_t space = line.find(' ');
+        bool is_field = colon != std::string_view::npos && (space == std::string_view::npos || colon < space);
+        if (!is_field)
+        {
+            // Mapping header: the path is the sixth column, if present
+            std::string_view rest = line;
+            for (int column = 0; column < 5 && !rest.empty(); column++)
+            {
+                size_t next = rest.find(' ');
+                rest = next == std::string_view::npos ? std::string_view() : trim(rest.substr(next + 1));
+            }
+
+            summary.mappings++;
+            if (rest == "[heap]")
+                current = &summary.heap_kb;
+            else if (rest.rfind("[stack", 0) == 0)
+                current = &summary.stack_kb;
+            else if (rest.empty())
+                current = &summary.anon_kb;
+            else if (rest.front() == '/')
+                current = &summary.file_kb;
+            else
+                current = &summary.other_kb;
+            continue;
+        }
+
+        if (current != nullptr && line.rfind("Rss:", 0) == 0)
+        {
+            uint64_t kb = 0;
+            if (parse_u64(line.substr(4), kb))
+                *current += kb;
+        }
+    }
+    return summary;
+}
+
+// Columns of /proc/[pid]/limits are aligned under the header line
+std::vector<ResourceLimit> parse_limits(std::string_view limits)
+{
+    std::vector<ResourceLimit> result;
+    size_t header_end = limits.find('\n');
+    if (header_end == std::string_view::npos)
+        return result;
+
+    std::string_view header = limits.substr(0, header_end);
+    size_t soft_col = header.find("Soft Limit");
+    size_t hard_col = header.find("Hard Limit");
+    size_t units_col = header.find("Units");
+    if (soft_col == std::string_view::npos || hard_col == std::string_view::npos || units_col == std::string_view::npos)
+        return result;
+
+    auto column = [](std::string_view line, size_t from, size_t to)
+    {
+        if (from >= line.size())
+            return std::string();
+        return std::string(trim(line.substr(from, to - from)));
+    };
+
+    size_t pos = header_end + 1;
+    while (pos < limits.size())
+    {
+        size_t end = limits.find('\n', pos);
+        if (end == std::string_view::npos)
+            end = limits.size();
+        std::string_view line = limits.substr(pos, end - pos);
+        pos = end + 1;
+        if (trim(line).empty())
+            continue;
+
+        ResourceLimit limit;
+        limit.name = column(line, 0, soft_col);
+        limit.soft = column(line, soft_col, hard_col);
+        limit.hard = column(line, hard_col, units_col);
+        limit.units = column(line, units_col, std::string_view::npos);
+        result.push_back(limit);
+    }
+    return result;
+}
+
+EnvironmentSummary parse_environ(std::string_view environ)
+{
+    EnvironmentSummary summary;
+    summary.bytes = environ.size();
+    size_t pos = 0;
+    while (pos < environ.size())
+    {
+        size_t end = environ.find('\0', pos);
+        if (end == std::string_view::npos)
+            end = environ.size();
+        if (end > pos)
+            summary.variables++;
+        pos = end + 1;
+    }
+    return summary;
+}
+
+static void add_row(InspectionResult &result, std::string label, std::string value)
+{
+    result.rows.emplace_back(std::move(label), std::move(value));
+}
+
+InspectionResult load_inspection_section(pid_t pid, InspectionSection section, const std::string &proc_root)
+{
+    namespace fs = std::filesystem;
+    InspectionResult result;
+    std::string base = proc_root + "/" + std::to_string(pid);
+    std::error_code ec;
+
+    switch (section)
+    {
+    case InspectionSection::FILES:
+    {
+        std::vector<std::string> targets;
+        for (const auto &entry : fs::directory_iterator(base + "/fd", ec))
+        {
+            std::error_code link_ec;
+            fs::path target = fs::read_symlink(entry.path(), link_ec);
+            targets.push_back(link_ec ? std::string() : target.string());
+        }
+        if (ec)
+        {
+            result.error = ec.message();
+            break;
+        }
+        FdSummary fds = summarize_fd_targets(targets);
+        add_row(result, "Total", std::to_string(fds.total));
+        add_row(result, "Files", std::to_string(fds.files));
+        add_row(result, "Sockets", std::to_string(fds.sockets));
+        add_row(result, "Pipes", std::to_string(fds.pipes));
+        add_row(result, "Anon inodes", std::to_string(fds.anon_inodes));
+        add_row(result, "Devices", std::to_string(fds.devices));
+        add_row(result, "Other", std::to_string(fds.other));
+        break;
+    }
+    case InspectionSection::MEMORY_MAP:
+    {
+        ProcFile smaps(base + "/smaps", 64 * 1024, true);
+        std::string_view contents = smaps.read();
+        if (contents.empty())
+        {
+            result.error = "smaps not readable";
+            break;
+        }
+        MemoryMapSummary map = parse_smaps(contents);
+        add_row(result, "Mappings", std::to_string(map.mappings));
+        add_row(result, "Heap", format_kb(map.heap_kb));
+        add_row(result, "Stack", format_kb(map.stack_kb));
+        add_row(result, "Anonymous", format_kb(map.anon_kb));
+        add_row(result, "File-backed", format_kb(map.file_kb));
+        add_row(result, "Other", format_kb(map.other_kb));
+        break;
+    }
+    case InspectionSection::LIMITS:
+    {
+        ProcFile limits(base + "/limits", 4096);
+        std::vector<ResourceLimit> parsed = parse_limits(limits.read());
+        if (parsed.empty())
+        {
+            result.error = "limits not readable";
+            break;
+        }
+        for (const auto &limit : parsed)
+        {
+            std::string value = limit.soft + " / " + limit.hard;
+            if (!limit.units.empty())
+                value += " " + limit.units;
+            add_row(result, limit.name, value);
+        }
+        break;
+    }
+    case InspectionSection::CGROUP:
+    {
+        ProcFile cgroup(base + "/cgroup", 1024);
+        std::string_view contents = cgroup.read();
+        if (contents.empty())
+        {
+            result.error = "cgroup not readable";
+            break;
+        }
+        // "hierarchy-id:controllers:path"; on cgroup v2 there is a single "0::/path" line
+        size_t pos = 0;
+        while (pos < contents.size())
+        {
+            size_t end = contents.find('\n', pos);
+            if (end == std::string_view::npos)
+                end = contents.size();
+            std::string_view line = contents.substr(pos, end - pos);
+            pos = end + 1;
+
+            size_t first = line.find(':');
+            size_t second = first == std::string_view::npos ? first : line.find(':', first + 1);
+            if (second == std::string_view::npos)
+                continue;
+            std::string_view controllers = line.substr(first + 1, second - first - 1);
+            add_row(result, controllers.empty() ? "unified" : std::string(controllers), std::string(line.substr(second + 1)));
+        }
+        break;
+    }
+    case InspectionSection::NAMESPACES:
+    {
+        for (const auto &entry : fs::directory_iterator(base + "/ns", ec))
+        {
+            std::error_code link_ec;
+            fs::path target = fs::read_symlink(entry.path(), link_ec);
+            add_row(result, entry.path().filename().string(), link_ec ? link_ec.message() : target.string());
+        }
+        if (ec)
+        {
+            result.error = ec.message();
+            break;
+        }
+        std::sort(result.rows.begin(), result.rows.end());
+        break;
+    }
+    case InspectionSection::ENVIRONMENT:
+    {
+        ProcFile environ(base + "/environ", 4096, true);
+        if (!environ.is_open())
+        {
+            result.error = "environ not readable";
+            break;
+        }
+        EnvironmentSummary env = parse_environ(environ.read());
+        add_row(result, "Variables", std::to_string(env.variables));
+        add_row(result, "Size", std::to_string(env.bytes) + " bytes");
+        break;
+    }
+    case InspectionSection::WCHAN:
+    {
+        ProcFile wchan(base + "/wchan", 256);
+        if (!wchan.is_open())
+        {
+            result.error = "wchan not readable";
+            break;
+        }
+        std::string_view contents = trim(wchan.read());
+        // The kernel reports "0" for a task that is running rather than sleeping
+        add_row(result, "Waiting in", contents.empty() || contents == "0" ? "running" : std::string(contents));
+        break;
+    }
+    }
+
+    result.loaded_at = std::chrono::steady_clock::now();
+    return result;
+}
+
+ProcessInspector::ProcessInspector(std::function<void()> on_loaded, std::chrono::milliseconds refresh_interval,
+                                   std::string proc_root)
+    : on_loaded(std::move(on_loaded)), refresh_interval(refresh_interval), proc_root(std::move(proc_root))
+{
+    this->worker = std::thread([this]
+                               { this->run_loop(); });
+}
+
+ProcessInspector::~ProcessInspector()
+{
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->running = false;
+    }
+    this->wake.notify_all();
+    if (this->worker.joinable())
+        this->worker.join();
+}
+
+// Must hold the mutex
+bool ProcessInspector::is_queued(pid_t pid, InspectionSection section) const
+{
+    return std::any_of(this->queue.begin(), this->queue.end(), [&](const Request &request)
+                       { return request.pid == pid && request.section == section; });
+}
+
+std::optional<InspectionResult> ProcessInspector::get(pid_t pid, InspectionSection section)
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    if (pid != this->current_pid)
+    {
+        this->current_pid = pid;
+        this->results.clear();
+        this->queue.clear();
+    }
+
+    std::optional<InspectionResult> result;
+    auto it = this->results.find(section);
+    if (it != this->results.end())
+        result = it->second;
+
+    bool stale = !result || std::chrono::steady_clock::now() - result->loaded_at >= this->refresh_interval;
+    if (stale && !this->is_queued(pid, section))
+    {
+        this->queue.push_back({pid, section});
+        this->wake.notify_all();
+    }
+    return result;
+}
+
+uint64_t ProcessInspector::get_load_count() const
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return this->loads;
+}
+
+void ProcessInspector::run_loop()
+{
+    std::unique_lock<std::mutex> lock(this->mutex);
+    while (true)
+    {
+        this->wake.wait(lock, [this]
+                        { return !this->running || !this->queue.empty(); });
+        if (!this->running)
+            break;
+
+        Request request = this->queue.front();
+        lock.unlock();
+        InspectionResult result = load_inspection_section(request.pid, request.section, this->proc_root);
+        lock.lock();
+
+        // Keep the request queued while loading so get() doesn't ask twice
+        if (!this->queue.empty() && this->queue.front().pid == request.pid &&
+            this->queue.front().section == request.section)
+            this->queue.pop_front();
+        if (request.pid != this->current_pid)
+            continue;
+        this->results[request.section] = std::move(result);
+        this->loads++;
+
+        if (this->on_loaded)
+        {
+            lock.unlock();
+            this->on_loaded();
+            lock.lock();
+        }
+    }
+}
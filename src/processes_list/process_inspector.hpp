@@ -0,0 +1,137 @@
+#ifndef __PROCESS_INSPECTOR_HPP
+#define __PROCESS_INSPECTOR_HPP
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <sys/types.h>
+
+// Parts of /proc/[pid] the detail view can show on demand
+enum class InspectionSection
+{
+    FILES,
+    MEMORY_MAP,
+    LIMITS,
+    CGROUP,
+    NAMESPACES,
+    ENVIRONMENT,
+    WCHAN
+};
+
+constexpr int INSPECTION_SECTION_COUNT = 7;
+
+const char *inspection_section_name(InspectionSection section);
+
+// One loaded section as label / value rows
+struct InspectionResult
+{
+    std::vector<std::pair<std::string, std::string>> rows;
+    std::string error; // Why the section could not be read (process exited, no permission)
+    std::chrono::steady_clock::time_point loaded_at;
+};
+
+// Open descriptors grouped by what they point at
+struct FdSummary
+{
+    size_t total = 0;
+    size_t files = 0;
+    size_t sockets = 0;
+    size_t pipes = 0;
+    size_t anon_inodes = 0;
+    size_t devices = 0;
+    size_t other = 0;
+};
+
+// Resident memory per kind of mapping, summed from /proc/[pid]/smaps
+struct MemoryMapSummary
+{
+    size_t mappings = 0;
+    uint64_t heap_kb = 0;
+    uint64_t stack_kb = 0;
+    uint64_t anon_kb = 0;
+    uint64_t file_kb = 0;
+    uint64_t other_kb = 0; // [vdso], [vvar] and similar
+};
+
+struct ResourceLimit
+{
+    std::string name;
+    std::string soft;
+    std::string hard;
+    std::string units;
+};
+
+struct EnvironmentSummary
+{
+    size_t variables = 0;
+    size_t bytes = 0;
+};
+
+// Classifies readlink() targets of /proc/[pid]/fd entries
+FdSummary summarize_fd_targets(const std::vector<std::string> &targets);
+MemoryMapSummary parse_smaps(std::string_view smaps);
+std::vector<ResourceLimit> parse_limits(std::string_view limits);
+EnvironmentSummary parse_environ(std::string_view environ);
+
+// Reads one section synchronously. proc_root is overridable for tests.
+InspectionResult load_inspection_section(pid_t pid, InspectionSection section, const std::string &proc_root = "/proc");
+
+// Loads inspection sections on a background thread so a slow or huge /proc
+// file (smaps of a large JVM, thousands of fds) never stalls the UI. A
+// section is only read once something asks for it, and is re-read at most
+// every refresh_interval while it keeps being asked for. on_loaded is called
+// from the worker thread after each load.
+class ProcessInspector
+{
+private:
+    struct Request
+    {
+        pid_t pid;
+        InspectionSection section;
+    };
+
+    std::function<void()> on_loaded;
+    std::chrono::milliseconds refresh_interval;
+    std::string proc_root;
+
+    pid_t current_pid = 0;
+    std::map<InspectionSection, InspectionResult> results; // For current_pid only
+    std::deque<Request> queue;
+    uint64_t loads = 0;
+
+    mutable std::mutex mutex;
+    std::condition_variable wake;
+    bool running = true;
+    std::thread worker;
+
+    bool is_queued(pid_t pid, InspectionSection section) const;
+    void run_loop();
+
+public:
+    explicit ProcessInspector(std::function<void()> on_loaded = nullptr,
+                              std::chrono::milliseconds refresh_interval = std::chrono::milliseconds(5000),
+                              std::string proc_root = "/proc");
+    ~ProcessInspector();
+    ProcessInspector(const ProcessInspector &) = delete;
+    ProcessInspector &operator=(const ProcessInspector &) = delete;
+
+    // Last loaded result for the section, or nullopt while the first load is
+    // in flight. Queues a load if there is no result yet or it is stale.
+    // Asking about a different pid drops everything loaded for the old one.
+    std::optional<InspectionResult> get(pid_t pid, InspectionSection section);
+
+    // Number of sections read so far
+    uint64_t get_load_count() const;
+};
+
+#endif /* __PROCESS_INSPECTOR_HPP */
@@ -1,6 +1,7 @@
 #include "processes_list.hpp"
 #include "process.hpp"
 #include "network_tracker.hpp"
+#include "../metrics/self_monitor.hpp"
 #include <vector>
 #include <statgrab.h>
 #include <mutex>
@@ -14,8 +15,9 @@ static void init_statgrab()
     sg_drop_privileges();
 }
 
-std::vector<Process> get_processes_list()
+std::vector<Process> get_processes_list(bool track_network)
 {
+    StageTimer timer(Stage::PROCESS_LIST);
     std::vector<Process> processes;
 
     std::call_once(init_flag, init_statgrab);
@@ -38,11 +40,15 @@ std::vector<Process> get_processes_list()
         std::string name = process_stats[i].process_name;
         unsigned long memory = process_stats[i].proc_resident / 1024;
         double cpu = process_stats[i].cpu_percent;
-        unsigned long network = tracker.getProcessNetworkUsage(pid);
+        unsigned long network = track_network ? tracker.getProcessNetworkUsage(pid) : 0;
         unsigned long uptime = current_time - process_stats[i].start_time;
         std::string command = process_stats[i].proctitle ? process_stats[i].proctitle : "";
 
         Process proc(pid, name, memory, cpu, network, uptime, command);
+        proc.set_uid(process_stats[i].uid);
+        proc.set_parent_pid(process_stats[i].parent);
+        proc.set_nice(process_stats[i].nice);
+        proc.set_start_time(static_cast<uint64_t>(process_stats[i].start_time));
         processes.push_back(proc);
     }
 
@@ -4,7 +4,9 @@
 #include "process.hpp"
 #include <vector>
 
-std::vector<Process> get_processes_list();
+// Process list from libstatgrab. Per-process network usage needs a walk over
+// every process's fds, so it can be turned off on hosts where that is too costly.
+std::vector<Process> get_processes_list(bool track_network = true);
 
 #endif
 
@@ -0,0 +1,180 @@
+#include "procfs_processes.hpp"
+#include "network_tracker.hpp"
+#include "../metrics/self_monitor.hpp"
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <ctime>
+#include <dirent.h>
+#include <optional>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+bool parse_proc_stat(std::string_view contents, ProcStat &stat)
+{
+    size_t open = contents.find('(');
+    size_t close = contents.rfind(')');
+    if (open == std::string_view::npos || close == std::string_view::npos || close < open)
+        return false;
+    stat.name = std::string(contents.substr(open + 1, close - open - 1));
+
+    // Field 3 (state) is the first after the name; ppid, utime, stime, nice,
+    // starttime and rss are fields 4, 14, 15, 19, 22 and 24. Nice is signed.
+    int64_t fields[22] = {};
+    size_t field = 3;
+    size_t pos = close + 1;
+    while (field <= 24 && pos < contents.size())
+    {
+        while (pos < contents.size() && contents[pos] == ' ')
+            pos++;
+        size_t end = contents.find(' ', pos);
+        if (end == std::string_view::npos)
+            end = contents.size();
+        std::from_chars(contents.data() + pos, contents.data() + end, fields[field - 3]);
+        field++;
+        pos = end;
+    }
+    if (field <= 24)
+        return false;
+
+    stat.parent_pid = static_cast<pid_t>(fields[4 - 3]);
+    stat.cpu_ticks = static_cast<uint64_t>(fields[14 - 3] + fields[15 - 3]);
+    stat.nice = static_cast<int>(fields[19 - 3]);
+    stat.start_ticks = static_cast<uint64_t>(fields[22 - 3]);
+    stat.rss_pages = static_cast<uint64_t>(fields[24 - 3]);
+    return true;
+}
+
+// Cached stat files may use the soft descriptor limit minus a quarter of it
+// (at least 256) kept free for sockets, pidfds and the other /proc readers
+static size_t default_max_open_files()
+{
+    struct rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) != 0)
+        return 768;
+    rlim_t soft = limit.rlim_cur == RLIM_INFINITY ? 1 << 20 : limit.rlim_cur;
+    rlim_t headroom = std::max<rlim_t>(256, soft / 4);
+    return soft > 2 * headroom ? static_cast<size_t>(soft - headroom) : static_cast<size_t>(soft / 2);
+}
+
+// Slots for the processes seen on the last tick, plus some to absorb new ones
+static size_t open_files_for(size_t process_count)
+{
+    return process_count + process_count / 8 + 32;
+}
+
+ProcfsProcessReader::ProcfsProcessReader(std::string proc_root, size_t max_open_files)
+    : proc_root(std::move(proc_root)),
+      max_open_files(max_open_files == 0 ? default_max_open_files() : max_open_files),
+      stat_files(std::min<size_t>(this->max_open_files, 1024))
+{
+    this->ticks_per_second = std::max(1L, sysconf(_SC_CLK_TCK));
+    this->page_kb = std::max(1L, sysconf(_SC_PAGESIZE) / 1024);
+
+    ProcFile system_stat(this->proc_root + "/stat", 8192);
+    uint64_t btime = 0;
+    parse_u64(find_field(system_stat.read(), "btime"), btime);
+    this->boot_time = static_cast<int64_t>(btime);
+}
+
+std::vector<Process> ProcfsProcessReader::read(bool track_network)
+{
+    StageTimer timer(Stage::PROCESS_LIST);
+    std::vector<Process> processes;
+    DIR *dir = opendir(this->proc_root.c_str());
+    if (dir == nullptr)
+        return processes;
+
+    auto now = std::chrono::steady_clock::now();
+    double elapsed = this->generation == 0 ? 0.0 : std::chrono::duration<double>(now - this->last_read).count();
+    this->last_read = now;
+    this->generation++;
+    int64_t wall_clock = static_cast<int64_t>(time(nullptr));
+    NetworkTracker &tracker = NetworkTracker::getInstance();
+
+    struct dirent *entry;
+    while ((entry = readdir(dir)) != nullptr)
+    {
+        pid_t pid = 0;
+        const char *name_end = entry->d_name + strlen(entry->d_name);
+        auto result = std::from_chars(entry->d_name, name_end, pid);
+        if (result.ec != std::errc() || result.ptr != name_end)
+            continue;
+
+        std::string base = this->proc_root + "/" + entry->d_name;
+        std::string stat_path = base + "/stat";
+        // A full cache grows up to the descriptor cap; past it, new pids are
+        // read through a one-off descriptor instead of evicting cached ones
+        std::optional<ProcFile> uncached;
+        if (this->stat_files.size() >= this->stat_files.get_capacity() && !this->stat_files.contains(stat_path))
+        {
+            if (this->stat_files.get_capacity() < this->max_open_files)
+                this->stat_files.set_capacity(std::min(this->max_open_files, this->stat_files.get_capacity() * 2));
+            else
+                uncached.emplace(stat_path, 1024);
+        }
+
+        ProcStat stat;
+        if (!parse_proc_stat(uncached ? uncached->read() : this->stat_files.read(stat_path), stat))
+        {
+            // The process exited between readdir and the read
+            this->stat_files.evict(stat_path);
+            continue;
+        }
+
+        auto known_it = this->known.find(pid);
+        bool is_new = known_it == this->known.end() || known_it->second.start_ticks != stat.start_ticks;
+        KnownProcess &known_process = this->known[pid];
+        double cpu = 0.0;
+        if (is_new)
+        {
+            known_process = KnownProcess{};
+            known_process.start_ticks = stat.start_ticks;
+
+            ProcFile cmdline(base + "/cmdline", 256, true);
+            std::string command(cmdline.read());
+            std::replace(command.begin(), command.end(), '\0', ' ');
+            while (!command.empty() && command.back() == ' ')
+                command.pop_back();
+            known_process.command = std::move(command);
+
+            struct stat owner;
+            if (::stat(base.c_str(), &owner) == 0)
+                known_process.uid = owner.st_uid;
+        }
+        else if (elapsed > 0.0 && stat.cpu_ticks >= known_process.cpu_ticks)
+        {
+            cpu = 100.0 * (stat.cpu_ticks - known_process.cpu_ticks) / (elapsed * this->ticks_per_second);
+        }
+        known_process.cpu_ticks = stat.cpu_ticks;
+        known_process.last_seen = this->generation;
+
+        int64_t started = this->boot_time + static_cast<int64_t>(stat.start_ticks / this->ticks_per_second);
+        unsigned long uptime = wall_clock > started ? static_cast<unsigned long>(wall_clock - started) : 0;
+        unsigned long network = track_network ? tracker.getProcessNetworkUsage(pid) : 0;
+
+        Process proc(pid, stat.name, stat.rss_pages * this->page_kb, cpu, network, uptime, known_process.command);
+        proc.set_uid(known_process.uid);
+        proc.set_parent_pid(stat.parent_pid);
+        proc.set_nice(stat.nice);
+        proc.set_start_time(stat.start_ticks);
+        processes.push_back(std::move(proc));
+    }
+    closedir(dir);
+
+    for (auto it = this->known.begin(); it != this->known.end();)
+    {
+        if (it->second.last_seen != this->generation)
+        {
+            this->stat_files.evict(this->proc_root + "/" + std::to_string(it->first) + "/stat");
+            it = this->known.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+    this->stat_files.set_capacity(std::min(this->max_open_files, open_files_for(processes.size())));
+    return processes;
+}
@@ -0,0 +1,73 @@
+#ifndef __PROCFS_PROCESSES_HPP
+#define __PROCFS_PROCESSES_HPP
+
+#include "process.hpp"
+#include "../proc_io/proc_file.hpp"
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Fields of /proc/[pid]/stat the process list needs
+struct ProcStat
+{
+    std::string name;
+    pid_t parent_pid = 0;
+    int nice = 0;
+    uint64_t cpu_ticks = 0;   // utime + stime
+    uint64_t start_ticks = 0; // Clock ticks after boot the process started at
+    uint64_t rss_pages = 0;
+};
+
+// The name is in parentheses and may itself contain spaces and parentheses,
+// so fields are counted from the last ')'
+bool parse_proc_stat(std::string_view contents, ProcStat &stat);
+
+// Process list backend that reads /proc directly instead of going through
+// libstatgrab. Per-pid stat files stay open in an LRU between ticks, and the
+// command line and owner are only read the first time a pid is seen, so a
+// steady-state tick costs one pread per process. The LRU is sized to the
+// process count seen on the last tick, up to max_open_files; pids beyond that
+// are read without caching rather than evicting files needed again next tick.
+class ProcfsProcessReader
+{
+private:
+    struct KnownProcess
+    {
+        uint64_t start_ticks = 0;
+        uint64_t cpu_ticks = 0;
+        std::string command;
+        uid_t uid = static_cast<uid_t>(-1);
+        uint64_t last_seen = 0;
+    };
+
+    std::string proc_root;
+    size_t max_open_files;
+    ProcFileCache stat_files;
+    std::unordered_map<pid_t, KnownProcess> known;
+    std::chrono::steady_clock::time_point last_read;
+    uint64_t generation = 0;
+    long ticks_per_second;
+    long page_kb;
+    int64_t boot_time = 0;
+
+public:
+    // max_open_files of 0 takes RLIMIT_NOFILE minus headroom for the rest of
+    // the program's descriptors
+    explicit ProcfsProcessReader(std::string proc_root = "/proc", size_t max_open_files = 0);
+
+    std::vector<Process> read(bool track_network = true);
+
+    size_t get_open_files() const
+    {
+        return this->stat_files.size();
+    }
+    size_t get_max_open_files() const
+    {
+        return this->max_open_files;
+    }
+};
+
+#endif /* __PROCFS_PROCESSES_HPP */
@@ -0,0 +1,295 @@
+#include "signal_batch.hpp"
+#include "procfs_processes.hpp"
+#include "../proc_io/proc_file.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#ifndef SYS_pidfd_open
+#define SYS_pidfd_open 434
+#endif
+#ifndef SYS_pidfd_send_signal
+#define SYS_pidfd_send_signal 424
+#endif
+
+// Longest name the kernel keeps for a process (TASK_COMM_LEN - 1)
+static constexpr size_t COMM_LENGTH = 15;
+
+static int open_pidfd(pid_t pid)
+{
+    return static_cast<int>(syscall(SYS_pidfd_open, pid, 0));
+}
+
+// A selection of thousands of processes needs as many descriptors; the
+// default soft limit is often 1024, so it is raised to the hard limit once
+static bool raise_descriptor_limit()
+{
+    static bool raised = false;
+    if (raised)
+        return false;
+    raised = true;
+
+    struct rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) != 0 || limit.rlim_cur >= limit.rlim_max)
+        return false;
+    limit.rlim_cur = limit.rlim_max;
+    return setrlimit(RLIMIT_NOFILE, &limit) == 0;
+}
+
+std::string summarize_signal_result(const BatchSignalResult &result)
+{
+    const char *name = result.signal_number == SIGKILL ? "SIGKILL" : result.signal_number == SIGTERM ? "SIGTERM" : nullptr;
+    std::string summary = name ? name : "Signal " + std::to_string(result.signal_number);
+    summary += " sent to " + std::to_string(result.sent) + " of " + std::to_string(result.requested) + " processes";
+
+    std::vector<std::string> details;
+    if (result.exited > 0)
+        details.push_back(std::to_string(result.exited) + " already exited");
+    if (result.denied > 0)
+        details.push_back(std::to_string(result.denied) + " permission denied");
+    if (result.failed > 0)
+        details.push_back(std::to_string(result.failed) + " failed");
+    if (!details.empty())
+    {
+        summary += " (";
+        for (size_t i = 0; i < details.size(); i++)
+            summary += (i > 0 ? ", " : "") + details[i];
+        summary += ")";
+    }
+    return summary;
+}
+
+BatchSignalResult signal_targets(std::vector<SignalTarget> &targets, int signal_number)
+{
+    auto start = std::chrono::steady_clock::now();
+    BatchSignalResult result;
+    result.signal_number = signal_number;
+    result.requested = targets.size();
+
+    for (auto &target : targets)
+    {
+        int status;
+        if (target.pidfd >= 0)
+            status = static_cast<int>(syscall(SYS_pidfd_send_signal, target.pidfd, signal_number, nullptr, 0));
+        else
+            status = ::kill(target.pid, signal_number);
+
+        if (status == 0)
+            result.sent++;
+        else if (errno == ESRCH)
+            result.exited++;
+        else if (errno == EPERM)
+            result.denied++;
+        else
+            result.failed++;
+
+        if (target.pidfd >= 0)
+        {
+            close(target.pidfd);
+            target.pidfd = -1;
+        }
+    }
+
+    result.elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+    return result;
+}
+
+ProcessSelection::ProcessSelection(std::string proc_root)
+    : proc_root(std::move(proc_root))
+{
+    this->ticks_per_second = std::max(1L, sysconf(_SC_CLK_TCK));
+
+    ProcFile system_stat(this->proc_root + "/stat", 8192);
+    uint64_t btime = 0;
+    parse_u64(find_field(system_stat.read(), "btime"), btime);
+    this->boot_time = static_cast<int64_t>(btime);
+}
+
+// The snapshot records the start time in its backend's units: clock ticks
+// after boot from the /proc reader, which must match exactly, or whole seconds
+// since the epoch from libstatgrab, which can be off by one from rounding.
+// 0 means the snapshot has none, leaving only the name check.
+bool ProcessSelection::started_at(uint64_t start_ticks, uint64_t recorded) const
+{
+    if (recorded == 0 || start_ticks == recorded)
+        return true;
+    int64_t started = this->boot_time + static_cast<int64_t>(start_ticks / this->ticks_per_second);
+    int64_t difference = started - static_cast<int64_t>(recorded);
+    return difference >= -1 && difference <= 1;
+}
+
+ProcessSelection::~ProcessSelection()
+{
+    this->clear();
+}
+
+bool ProcessSelection::add(const Process &process)
+{
+    pid_t pid = process.get_pid();
+    if (pid <= 0)
+        return false;
+    if (this->contains(pid))
+        return true;
+
+    int pidfd = open_pidfd(pid);
+    if (pidfd < 0 && errno == EMFILE && raise_descriptor_limit())
+        pidfd = open_pidfd(pid);
+    if (pidfd < 0 && errno != ENOSYS)
+        return false;
+
+    // Opened after the pidfd, so a pid reused in between shows up as a
+    // different start time and the pidfd is dropped. Same-named workers in a
+    // fork storm only differ there.
+    ProcFile stat_file(this->proc_root + "/" + std::to_string(pid) + "/stat", 1024);
+    ProcStat stat;
+    if (!parse_proc_stat(stat_file.read(), stat) ||
+        !this->started_at(stat.start_ticks, process.get_start_time()) ||
+        stat.name.substr(0, COMM_LENGTH) != process.get_process_name().substr(0, COMM_LENGTH))
+    {
+        if (pidfd >= 0)
+            close(pidfd);
+        return false;
+    }
+
+    this->targets[pid] = SignalTarget{pid, process.get_process_name(), pidfd};
+    return true;
+}
+
+void ProcessSelection::remove(pid_t pid)
+{
+    auto it = this->targets.find(pid);
+    if (it == this->targets.end())
+        return;
+    if (it->second.pidfd >= 0)
+        close(it->second.pidfd);
+    this->targets.erase(it);
+}
+
+void ProcessSelection::toggle(const Process &process)
+{
+    if (this->contains(process.get_pid()))
+        this->remove(process.get_pid());
+    else
+        this->add(process);
+}
+
+void ProcessSelection::clear()
+{
+    for (auto &[pid, target] : this->targets)
+    {
+        if (target.pidfd >= 0)
+            close(target.pidfd);
+    }
+    this->targets.clear();
+}
+
+bool ProcessSelection::contains(pid_t pid) const
+{
+    return this->targets.find(pid) != this->targets.end();
+}
+
+std::vector<SignalTarget> ProcessSelection::take()
+{
+    std::vector<SignalTarget> taken;
+    taken.reserve(this->targets.size());
+    for (auto &[pid, target] : this->targets)
+        taken.push_back(std::move(target));
+    this->targets.clear();
+    return taken;
+}
+
+SignalDispatcher::SignalDispatcher(std::function<void()> on_done)
+    : on_done(std::move(on_done))
+{
+    this->worker = std::thread([this]
+                               { this->run_loop(); });
+}
+
+SignalDispatcher::~SignalDispatcher()
+{
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->running = false;
+    }
+    this->wake.notify_all();
+    if (this->worker.joinable())
+        this->worker.join();
+
+    // Batches that never ran still own their pidfds
+    for (auto &batch : this->queue)
+    {
+        for (auto &target : batch.targets)
+        {
+            if (target.pidfd >= 0)
+                close(target.pidfd);
+        }
+    }
+}
+
+void SignalDispatcher::submit(std::vector<SignalTarget> targets, int signal_number)
+{
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->queue.push_back(Batch{std::move(targets), signal_number});
+    }
+    this->wake.notify_all();
+}
+
+void SignalDispatcher::wait_idle()
+{
+    std::unique_lock<std::mutex> lock(this->mutex);
+    this->idle.wait(lock, [this]
+                    { return this->queue.empty() && !this->busy; });
+}
+
+bool SignalDispatcher::is_busy() const
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return this->busy || !this->queue.empty();
+}
+
+std::optional<BatchSignalResult> SignalDispatcher::get_last_result() const
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return this->last_result;
+}
+
+void SignalDispatcher::clear_last_result()
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->last_result.reset();
+}
+
+void SignalDispatcher::run_loop()
+{
+    std::unique_lock<std::mutex> lock(this->mutex);
+    while (true)
+    {
+        this->wake.wait(lock, [this]
+                        { return !this->running || !this->queue.empty(); });
+        if (!this->running)
+            break;
+
+        Batch batch = std::move(this->queue.front());
+        this->queue.pop_front();
+        this->busy = true;
+        lock.unlock();
+        BatchSignalResult result = signal_targets(batch.targets, batch.signal_number);
+        lock.lock();
+
+        this->last_result = result;
+        this->busy = false;
+        this->idle.notify_all();
+
+        if (this->on_done)
+        {
+            lock.unlock();
+            this->on_done();
+            lock.lock();
+        }
+    }
+}
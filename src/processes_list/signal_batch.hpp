@@ -0,0 +1,128 @@
+#ifndef __SIGNAL_BATCH_HPP
+#define __SIGNAL_BATCH_HPP
+
+#include "process.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// A selected process. pidfd refers to the process itself rather than its
+// pid, so a signal sent through it can never reach a process that took the
+// pid over after the original exited. -1 on kernels without pidfd_open
+// (before 5.3), in which case signals fall back to kill().
+struct SignalTarget
+{
+    pid_t pid = 0;
+    std::string name;
+    int pidfd = -1;
+};
+
+// Outcome of signalling one batch of targets
+struct BatchSignalResult
+{
+    int signal_number = 0;
+    size_t requested = 0;
+    size_t sent = 0;
+    size_t exited = 0; // Already gone when the signal was sent
+    size_t denied = 0; // EPERM
+    size_t failed = 0; // Any other error
+    std::chrono::microseconds elapsed{0};
+};
+
+// One-line summary such as "SIGTERM sent to 1203 of 1210 processes (5 already exited, 2 denied)"
+std::string summarize_signal_result(const BatchSignalResult &result);
+
+// Sends signal_number to every target and closes their pidfds
+BatchSignalResult signal_targets(std::vector<SignalTarget> &targets, int signal_number);
+
+// Processes picked in the process table, each pinned by a pidfd opened when
+// it was picked. After the pidfd is opened, the pid is checked to still
+// belong to a process with the snapshot's start time and name, so a pid
+// reused between the snapshot and the selection is refused rather than pinned.
+class ProcessSelection
+{
+private:
+    std::unordered_map<pid_t, SignalTarget> targets;
+    std::string proc_root;
+    int64_t boot_time = 0;
+    long ticks_per_second;
+
+    bool started_at(uint64_t start_ticks, uint64_t recorded) const;
+
+public:
+    explicit ProcessSelection(std::string proc_root = "/proc");
+    ~ProcessSelection();
+    ProcessSelection(const ProcessSelection &) = delete;
+    ProcessSelection &operator=(const ProcessSelection &) = delete;
+
+    // Returns false if the process has exited or its pid now belongs to another process
+    bool add(const Process &process);
+    void remove(pid_t pid);
+    // Adds the process if it is not selected, removes it otherwise
+    void toggle(const Process &process);
+    void clear();
+
+    bool contains(pid_t pid) const;
+    size_t size() const
+    {
+        return this->targets.size();
+    }
+    bool empty() const
+    {
+        return this->targets.empty();
+    }
+
+    // Hands the targets, and ownership of their pidfds, to the caller and
+    // leaves the selection empty
+    std::vector<SignalTarget> take();
+};
+
+// Signals batches on a background thread so thousands of targets never
+// stall the UI. on_done is called on that thread after each batch.
+class SignalDispatcher
+{
+private:
+    struct Batch
+    {
+        std::vector<SignalTarget> targets;
+        int signal_number = 0;
+    };
+
+    std::function<void()> on_done;
+    std::deque<Batch> queue;
+    std::optional<BatchSignalResult> last_result;
+    bool busy = false;
+
+    mutable std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable idle;
+    bool running = true;
+    std::thread worker;
+
+    void run_loop();
+
+public:
+    explicit SignalDispatcher(std::function<void()> on_done = nullptr);
+    ~SignalDispatcher();
+    SignalDispatcher(const SignalDispatcher &) = delete;
+    SignalDispatcher &operator=(const SignalDispatcher &) = delete;
+
+    void submit(std::vector<SignalTarget> targets, int signal_number);
+
+    // Blocks until every submitted batch has been sent
+    void wait_idle();
+    bool is_busy() const;
+    std::optional<BatchSignalResult> get_last_result() const;
+    void clear_last_result();
+};
+
+#endif /* __SIGNAL_BATCH_HPP */
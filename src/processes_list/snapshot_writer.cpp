@@ -0,0 +1,433 @@
+#include "snapshot_writer.hpp"
+#include <charconv>
+#include <cmath>
+#include <cstring>
+
+// Binary layout: magic, version byte, field mask and record count as varints,
+// then per record the selected fields in SnapshotField order. Integers are
+// LEB128 varints (nice zigzag-encoded), CPU is hundredths of a percent, and
+// strings are a varint length followed by the bytes.
+static constexpr char BINARY_MAGIC[4] = {'H', 'S', 'N', 'P'};
+static constexpr uint8_t BINARY_VERSION = 1;
+
+struct FieldName
+{
+    SnapshotField field;
+    const char *name;
+};
+
+static constexpr FieldName FIELD_NAMES[] = {
+    {SNAPSHOT_PID, "pid"},
+    {SNAPSHOT_NAME, "name"},
+    {SNAPSHOT_CPU, "cpu_usage"},
+    {SNAPSHOT_MEMORY, "memory_usage"},
+    {SNAPSHOT_NETWORK, "network_usage"},
+    {SNAPSHOT_UPTIME, "cpu_time"},
+    {SNAPSHOT_PARENT_PID, "parent_pid"},
+    {SNAPSHOT_UID, "uid"},
+    {SNAPSHOT_NICE, "nice"},
+    {SNAPSHOT_COMMAND, "command"},
+};
+
+void append_json_escaped(std::string &out, std::string_view text)
+{
+    static constexpr char HEX[] = "0123456789abcdef";
+    size_t run_start = 0;
+    for (size_t i = 0; i < text.size(); i++)
+    {
+        unsigned char c = static_cast<unsigned char>(text[i]);
+        if (c >= 0x20 && c != '"' && c != '\\')
+            continue;
+
+        // Copy the plain run before the character in one go
+        out.append(text.data() + run_start, i - run_start);
+        run_start = i + 1;
+        switch (c)
+        {
+        case '"':
+            out.append("\\\"");
+            break;
+        case '\\':
+            out.append("\\\\");
+            break;
+        case '\n':
+            out.append("\\n");
+            break;
+        case '\t':
+            out.append("\\t");
+            break;
+        case '\r':
+            out.append("\\r");
+            break;
+        default:
+            char escape[6] = {'\\', 'u', '0', '0', HEX[c >> 4], HEX[c & 0xF]};
+            out.append(escape, sizeof(escape));
+        }
+    }
+    out.append(text.data() + run_start, text.size() - run_start);
+}
+
+SnapshotWriter::SnapshotWriter(size_t initial_capacity)
+{
+    this->buffer.reserve(initial_capacity);
+}
+
+void SnapshotWriter::append_unsigned(uint64_t value)
+{
+    char digits[24];
+    auto result = std::to_chars(digits, digits + sizeof(digits), value);
+    this->buffer.append(digits, result.ptr - digits);
+}
+
+void SnapshotWriter::append_signed(int64_t value)
+{
+    char digits[24];
+    auto result = std::to_chars(digits, digits + sizeof(digits), value);
+    this->buffer.append(digits, result.ptr - digits);
+}
+
+void SnapshotWriter::append_double(double value)
+{
+    // NaN and infinity are not valid JSON numbers
+    if (!std::isfinite(value))
+        value = 0.0;
+    char digits[32];
+    auto result = std::to_chars(digits, digits + sizeof(digits), value);
+    this->buffer.append(digits, result.ptr - digits);
+}
+
+void SnapshotWriter::append_varint(uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        this->buffer.push_back(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    this->buffer.push_back(static_cast<char>(value));
+}
+
+void SnapshotWriter::append_csv_field(std::string_view text)
+{
+    if (text.find_first_of(",\"\r\n") == std::string_view::npos)
+    {
+        this->buffer.append(text);
+        return;
+    }
+    this->buffer.push_back('"');
+    size_t run_start = 0;
+    for (size_t quote = text.find('"'); quote != std::string_view::npos; quote = text.find('"', quote + 1))
+    {
+        this->buffer.append(text.data() + run_start, quote + 1 - run_start);
+        this->buffer.push_back('"');
+        run_start = quote + 1;
+    }
+    this->buffer.append(text.data() + run_start, text.size() - run_start);
+    this->buffer.push_back('"');
+}
+
+std::string_view SnapshotWriter::write(const std::vector<Process> &processes, SnapshotFormat format,
+                                       uint32_t fields)
+{
+    this->buffer.clear();
+    switch (format)
+    {
+    case SnapshotFormat::JSON:
+        this->write_json(processes, fields);
+        break;
+    case SnapshotFormat::CSV:
+        this->write_csv(processes, fields);
+        break;
+    case SnapshotFormat::BINARY:
+        this->write_binary(processes, fields);
+        break;
+    }
+    return this->buffer;
+}
+
+void SnapshotWriter::write_json(const std::vector<Process> &processes, uint32_t fields)
+{
+    this->buffer.push_back('[');
+    for (size_t i = 0; i < processes.size(); i++)
+    {
+        const Process &p = processes[i];
+        if (i > 0)
+            this->buffer.push_back(',');
+        this->buffer.push_back('{');
+
+        bool first = true;
+        for (const auto &[field, name] : FIELD_NAMES)
+        {
+            if (!(fields & field))
+                continue;
+            if (!first)
+                this->buffer.push_back(',');
+            first = false;
+            this->buffer.push_back('"');
+            this->buffer.append(name);
+            this->buffer.append("\":");
+
+            switch (field)
+            {
+            case SNAPSHOT_PID:
+                this->append_signed(p.get_pid());
+                break;
+            case SNAPSHOT_NAME:
+                this->buffer.push_back('"');
+                append_json_escaped(this->buffer, p.get_process_name());
+                this->buffer.push_back('"');
+                break;
+            case SNAPSHOT_CPU:
+                this->append_double(p.get_cpu_usage());
+                break;
+            case SNAPSHOT_MEMORY:
+                this->append_unsigned(p.get_memory_usage());
+                break;
+            case SNAPSHOT_NETWORK:
+                this->append_unsigned(p.get_network_usage());
+                break;
+            case SNAPSHOT_UPTIME:
+                this->append_unsigned(p.get_cpu_time());
+                break;
+            case SNAPSHOT_PARENT_PID:
+                this->append_signed(p.get_parent_pid());
+                break;
+            case SNAPSHOT_UID:
+                this->append_unsigned(p.get_uid());
+                break;
+            case SNAPSHOT_NICE:
+                this->append_signed(p.get_nice());
+                break;
+            case SNAPSHOT_COMMAND:
+                this->buffer.push_back('"');
+                append_json_escaped(this->buffer, p.get_command());
+                this->buffer.push_back('"');
+                break;
+            default:
+                break;
+            }
+        }
+        this->buffer.push_back('}');
+    }
+    this->buffer.push_back(']');
+}
+
+void SnapshotWriter::write_csv(const std::vector<Process> &processes, uint32_t fields)
+{
+    bool first = true;
+    for (const auto &[field, name] : FIELD_NAMES)
+    {
+        if (!(fields & field))
+            continue;
+        if (!first)
+            this->buffer.push_back(',');
+        first = false;
+        this->buffer.append(name);
+    }
+    this->buffer.append("\r\n");
+
+    for (const Process &p : processes)
+    {
+        first = true;
+        for (const auto &[field, name] : FIELD_NAMES)
+        {
+            if (!(fields & field))
+                continue;
+            if (!first)
+                this->buffer.push_back(',');
+            first = false;
+
+            switch (field)
+            {
+            case SNAPSHOT_PID:
+                this->append_signed(p.get_pid());
+                break;
+            case SNAPSHOT_NAME:
+                this->append_csv_field(p.get_process_name());
+                break;
+            case SNAPSHOT_CPU:
+                this->append_double(p.get_cpu_usage());
+                break;
+            case SNAPSHOT_MEMORY:
+                this->append_unsigned(p.get_memory_usage());
+                break;
+            case SNAPSHOT_NETWORK:
+                this->append_unsigned(p.get_network_usage());
+                break;
+            case SNAPSHOT_UPTIME:
+                this->append_unsigned(p.get_cpu_time());
+                break;
+            case SNAPSHOT_PARENT_PID:
+                this->append_signed(p.get_parent_pid());
+                break;
+            case SNAPSHOT_UID:
+                this->append_unsigned(p.get_uid());
+                break;
+            case SNAPSHOT_NICE:
+                this->append_signed(p.get_nice());
+                break;
+            case SNAPSHOT_COMMAND:
+                this->append_csv_field(p.get_command());
+                break;
+            default:
+                break;
+            }
+        }
+        this->buffer.append("\r\n");
+    }
+}
+
+void SnapshotWriter::write_binary(const std::vector<Process> &processes, uint32_t fields)
+{
+    this->buffer.append(BINARY_MAGIC, sizeof(BINARY_MAGIC));
+    this->buffer.push_back(static_cast<char>(BINARY_VERSION));
+    this->append_varint(fields & SNAPSHOT_ALL_FIELDS);
+    this->append_varint(processes.size());
+
+    for (const Process &p : processes)
+    {
+        if (fields & SNAPSHOT_PID)
+            this->append_varint(static_cast<uint32_t>(p.get_pid()));
+        if (fields & SNAPSHOT_NAME)
+        {
+            this->append_varint(p.get_process_name().size());
+            this->buffer.append(p.get_process_name());
+        }
+        if (fields & SNAPSHOT_CPU)
+        {
+            double cpu = std::isfinite(p.get_cpu_usage()) ? std::max(0.0, p.get_cpu_usage()) : 0.0;
+            this->append_varint(static_cast<uint64_t>(std::llround(cpu * 100.0)));
+        }
+        if (fields & SNAPSHOT_MEMORY)
+            this->append_varint(p.get_memory_usage());
+        if (fields & SNAPSHOT_NETWORK)
+            this->append_varint(p.get_network_usage());
+        if (fields & SNAPSHOT_UPTIME)
+            this->append_varint(p.get_cpu_time());
+        if (fields & SNAPSHOT_PARENT_PID)
+            this->append_varint(static_cast<uint32_t>(p.get_parent_pid()));
+        if (fields & SNAPSHOT_UID)
+            this->append_varint(p.get_uid());
+        if (fields & SNAPSHOT_NICE)
+        {
+            int64_t nice = p.get_nice();
+            this->append_varint(static_cast<uint64_t>((nice << 1) ^ (nice >> 63)));
+        }
+        if (fields & SNAPSHOT_COMMAND)
+        {
+            this->append_varint(p.get_command().size());
+            this->buffer.append(p.get_command());
+        }
+    }
+}
+
+static bool read_varint(std::string_view data, size_t &pos, uint64_t &value)
+{
+    value = 0;
+    for (int shift = 0; shift < 64; shift += 7)
+    {
+        if (pos >= data.size())
+            return false;
+        uint8_t byte = static_cast<uint8_t>(data[pos++]);
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80))
+            return true;
+    }
+    return false;
+}
+
+static bool read_string(std::string_view data, size_t &pos, std::string &text)
+{
+    uint64_t length = 0;
+    if (!read_varint(data, pos, length) || length > data.size() - pos)
+        return false;
+    text.assign(data.data() + pos, length);
+    pos += length;
+    return true;
+}
+
+bool read_binary_snapshot(std::string_view data, std::vector<Process> &processes)
+{
+    processes.clear();
+    size_t pos = sizeof(BINARY_MAGIC) + 1;
+    if (data.size() < pos || std::memcmp(data.data(), BINARY_MAGIC, sizeof(BINARY_MAGIC)) != 0 ||
+        static_cast<uint8_t>(data[sizeof(BINARY_MAGIC)]) != BINARY_VERSION)
+        return false;
+
+    uint64_t fields = 0;
+    uint64_t count = 0;
+    if (!read_varint(data, pos, fields) || !read_varint(data, pos, count))
+        return false;
+    // Every record takes at least a byte per field, so a huge count is corrupt
+    if (count > data.size())
+        return false;
+    processes.reserve(count);
+
+    std::string text;
+    for (uint64_t i = 0; i < count; i++)
+    {
+        uint64_t value = 0;
+        Process proc(0);
+        if (fields & SNAPSHOT_PID)
+        {
+            if (!read_varint(data, pos, value))
+                return false;
+            proc = Process(static_cast<pid_t>(value));
+        }
+        if (fields & SNAPSHOT_NAME)
+        {
+            if (!read_string(data, pos, text))
+                return false;
+            proc.set_process_name(text);
+        }
+        if (fields & SNAPSHOT_CPU)
+        {
+            if (!read_varint(data, pos, value))
+                return false;
+            proc.set_cpu_usage(value / 100.0);
+        }
+        if (fields & SNAPSHOT_MEMORY)
+        {
+            if (!read_varint(data, pos, value))
+                return false;
+            proc.set_memory_usage(value);
+        }
+        if (fields & SNAPSHOT_NETWORK)
+        {
+            if (!read_varint(data, pos, value))
+                return false;
+            proc.set_network_usage(value);
+        }
+        if (fields & SNAPSHOT_UPTIME)
+        {
+            if (!read_varint(data, pos, value))
+                return false;
+            proc.set_cpu_time(value);
+        }
+        if (fields & SNAPSHOT_PARENT_PID)
+        {
+            if (!read_varint(data, pos, value))
+                return false;
+            proc.set_parent_pid(static_cast<pid_t>(value));
+        }
+        if (fields & SNAPSHOT_UID)
+        {
+            if (!read_varint(data, pos, value))
+                return false;
+            proc.set_uid(static_cast<uid_t>(value));
+        }
+        if (fields & SNAPSHOT_NICE)
+        {
+            if (!read_varint(data, pos, value))
+                return false;
+            proc.set_nice(static_cast<int>(static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1)));
+        }
+        if (fields & SNAPSHOT_COMMAND)
+        {
+            if (!read_string(data, pos, text))
+                return false;
+            proc.set_command(text);
+        }
+        processes.push_back(std::move(proc));
+    }
+    return pos == data.size();
+}
@@ -0,0 +1,73 @@
+#ifndef __SNAPSHOT_WRITER_HPP
+#define __SNAPSHOT_WRITER_HPP
+
+#include "process.hpp"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+enum class SnapshotFormat
+{
+    JSON,  // An array of objects, one per process
+    CSV,   // A header row, then one row per process (RFC 4180 quoting)
+    BINARY // Varint-packed records, read back with read_binary_snapshot
+};
+
+// Which Process fields are written; JSON keys and CSV columns use these names
+enum SnapshotField : uint32_t
+{
+    SNAPSHOT_PID = 1 << 0,        // "pid"
+    SNAPSHOT_NAME = 1 << 1,       // "name"
+    SNAPSHOT_CPU = 1 << 2,        // "cpu_usage", percent
+    SNAPSHOT_MEMORY = 1 << 3,     // "memory_usage", KB
+    SNAPSHOT_NETWORK = 1 << 4,    // "network_usage", bytes per second
+    SNAPSHOT_UPTIME = 1 << 5,     // "cpu_time", seconds since start
+    SNAPSHOT_PARENT_PID = 1 << 6, // "parent_pid"
+    SNAPSHOT_UID = 1 << 7,        // "uid"
+    SNAPSHOT_NICE = 1 << 8,       // "nice"
+    SNAPSHOT_COMMAND = 1 << 9,    // "command"
+    SNAPSHOT_ALL_FIELDS = (1 << 10) - 1
+};
+
+// Appends text as the inside of a JSON string literal (no surrounding quotes)
+void append_json_escaped(std::string &out, std::string_view text);
+
+// Serializes process snapshots straight into one reused buffer. Numbers are
+// formatted with to_chars on the stack and strings escaped in place, so once
+// the buffer has grown to the snapshot's size, writing allocates nothing.
+// Shared by anything that ships a snapshot out of the process: the optimizer
+// payload, exports and recordings.
+class SnapshotWriter
+{
+private:
+    std::string buffer;
+
+    void append_unsigned(uint64_t value);
+    void append_signed(int64_t value);
+    void append_double(double value);
+    void append_varint(uint64_t value);
+    void append_csv_field(std::string_view text);
+
+    void write_json(const std::vector<Process> &processes, uint32_t fields);
+    void write_csv(const std::vector<Process> &processes, uint32_t fields);
+    void write_binary(const std::vector<Process> &processes, uint32_t fields);
+
+public:
+    explicit SnapshotWriter(size_t initial_capacity = 64 * 1024);
+
+    // Replaces the buffer contents; the view is valid until the next write
+    std::string_view write(const std::vector<Process> &processes, SnapshotFormat format,
+                           uint32_t fields = SNAPSHOT_ALL_FIELDS);
+
+    const std::string &get_buffer() const
+    {
+        return this->buffer;
+    }
+};
+
+// Decodes SnapshotFormat::BINARY. Fields that were not written keep the
+// Process defaults. Returns false on a bad header or truncated data.
+bool read_binary_snapshot(std::string_view data, std::vector<Process> &processes);
+
+#endif /* __SNAPSHOT_WRITER_HPP */
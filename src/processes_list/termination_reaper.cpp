@@ -0,0 +1,253 @@
+#include "termination_reaper.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstdio>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#ifndef SYS_pidfd_send_signal
+#define SYS_pidfd_send_signal 424
+#endif
+
+// Targets without a pidfd (kernels before 5.3) are checked this often instead
+static constexpr int FALLBACK_POLL_MS = 50;
+
+static int send_signal(const SignalTarget &target, int signal_number)
+{
+    if (target.pidfd >= 0)
+        return static_cast<int>(syscall(SYS_pidfd_send_signal, target.pidfd, signal_number, nullptr, 0));
+    return ::kill(target.pid, signal_number);
+}
+
+static std::string format_seconds(std::chrono::milliseconds time)
+{
+    char buffer[32];
+    snprintf(buffer, sizeof(buffer), "%.1f s", time.count() / 1000.0);
+    return buffer;
+}
+
+std::string describe_termination(const TerminationOutcome &outcome)
+{
+    std::string process = outcome.name + " (" + std::to_string(outcome.pid) + ")";
+    switch (outcome.state)
+    {
+    case TerminationState::EXITED:
+        return process + " exited " + format_seconds(outcome.exit_time) + " after SIGTERM";
+    case TerminationState::KILLED:
+        return process + " ignored SIGTERM, killed; gone " + format_seconds(outcome.exit_time) + " after SIGTERM";
+    case TerminationState::ALREADY_EXITED:
+        return process + " had already exited";
+    case TerminationState::DENIED:
+        return process + ": permission denied";
+    case TerminationState::UNKILLABLE:
+        return process + " is still running after SIGKILL";
+    }
+    return process;
+}
+
+std::string summarize_terminations(const std::vector<TerminationOutcome> &outcomes)
+{
+    if (outcomes.size() == 1)
+        return describe_termination(outcomes.front());
+
+    size_t counts[5] = {};
+    std::chrono::milliseconds slowest{0};
+    for (const auto &outcome : outcomes)
+    {
+        counts[static_cast<int>(outcome.state)]++;
+        if (outcome.state == TerminationState::EXITED || outcome.state == TerminationState::KILLED)
+            slowest = std::max(slowest, outcome.exit_time);
+    }
+
+    std::string summary = std::to_string(outcomes.size()) + " terminated: " +
+                          std::to_string(counts[static_cast<int>(TerminationState::EXITED)]) + " exited on SIGTERM, " +
+                          std::to_string(counts[static_cast<int>(TerminationState::KILLED)]) + " killed";
+    if (size_t gone = counts[static_cast<int>(TerminationState::ALREADY_EXITED)])
+        summary += ", " + std::to_string(gone) + " already exited";
+    if (size_t denied = counts[static_cast<int>(TerminationState::DENIED)])
+        summary += ", " + std::to_string(denied) + " denied";
+    if (size_t stuck = counts[static_cast<int>(TerminationState::UNKILLABLE)])
+        summary += ", " + std::to_string(stuck) + " still running";
+    return summary + "; slowest " + format_seconds(slowest);
+}
+
+TerminationReaper::TerminationReaper(std::function<void()> on_update, std::chrono::milliseconds grace_period)
+    : on_update(std::move(on_update)), grace_period(grace_period)
+{
+    this->wake_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    this->worker = std::thread([this]
+                               { this->run_loop(); });
+}
+
+TerminationReaper::~TerminationReaper()
+{
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->running = false;
+    }
+    this->wake();
+    if (this->worker.joinable())
+        this->worker.join();
+
+    for (auto &target : this->incoming)
+    {
+        if (target.pidfd >= 0)
+            close(target.pidfd);
+    }
+    if (this->wake_fd >= 0)
+        close(this->wake_fd);
+}
+
+void TerminationReaper::wake()
+{
+    uint64_t one = 1;
+    if (this->wake_fd >= 0)
+        (void)!write(this->wake_fd, &one, sizeof(one));
+}
+
+void TerminationReaper::terminate(std::vector<SignalTarget> targets)
+{
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->pending += targets.size();
+        for (auto &target : targets)
+            this->incoming.push_back(std::move(target));
+    }
+    this->wake();
+}
+
+size_t TerminationReaper::get_pending_count() const
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return this->pending;
+}
+
+std::vector<TerminationOutcome> TerminationReaper::get_outcomes() const
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return std::vector<TerminationOutcome>(this->outcomes.begin(), this->outcomes.end());
+}
+
+void TerminationReaper::clear_outcomes()
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->outcomes.clear();
+}
+
+// Sends SIGTERM and starts the grace period, or records why it could not
+void TerminationReaper::start_watch(SignalTarget &target, std::vector<Watch> &watches,
+                                    std::vector<TerminationOutcome> &finished)
+{
+    auto now = Clock::now();
+    if (send_signal(target, SIGTERM) != 0)
+    {
+        TerminationState state = errno == EPERM ? TerminationState::DENIED : TerminationState::ALREADY_EXITED;
+        finished.push_back({target.pid, target.name, state, std::chrono::milliseconds(0)});
+        if (target.pidfd >= 0)
+            close(target.pidfd);
+        return;
+    }
+    watches.push_back({std::move(target), now, now + this->grace_period, false});
+}
+
+void TerminationReaper::run_loop()
+{
+    std::vector<Watch> watches;
+    std::vector<pollfd> poll_fds;
+
+    while (true)
+    {
+        std::vector<TerminationOutcome> finished;
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            if (!this->running)
+                break;
+            for (auto &target : this->incoming)
+                this->start_watch(target, watches, finished);
+            this->incoming.clear();
+        }
+
+        // The wake eventfd first, then one pidfd per watched process
+        poll_fds.clear();
+        poll_fds.push_back({this->wake_fd, POLLIN, 0});
+        int timeout = -1;
+        auto now = Clock::now();
+        for (const auto &watch : watches)
+        {
+            poll_fds.push_back({watch.target.pidfd, POLLIN, 0});
+            int until_deadline = static_cast<int>(
+                std::chrono::ceil<std::chrono::milliseconds>(std::max(watch.deadline - now, Clock::duration(0))).count());
+            if (watch.target.pidfd < 0)
+                until_deadline = std::min(until_deadline, FALLBACK_POLL_MS);
+            timeout = timeout < 0 ? until_deadline : std::min(timeout, until_deadline);
+        }
+        if (finished.empty())
+            poll(poll_fds.data(), poll_fds.size(), timeout);
+
+        uint64_t drained;
+        while (read(this->wake_fd, &drained, sizeof(drained)) > 0)
+        {
+        }
+
+        now = Clock::now();
+        for (size_t i = 0; i < watches.size();)
+        {
+            Watch &watch = watches[i];
+            bool exited;
+            if (watch.target.pidfd >= 0)
+                exited = (poll_fds[i + 1].revents & (POLLIN | POLLHUP | POLLERR)) != 0;
+            else
+                exited = ::kill(watch.target.pid, 0) != 0 && errno == ESRCH;
+
+            if (!exited && now >= watch.deadline && !watch.killed)
+            {
+                // Escalate, then give SIGKILL a moment to take effect
+                if (send_signal(watch.target, SIGKILL) != 0 && errno == ESRCH)
+                    exited = true;
+                watch.killed = true;
+                watch.deadline = now + KILL_TIMEOUT;
+            }
+
+            if (!exited && !(watch.killed && now >= watch.deadline))
+            {
+                i++;
+                continue;
+            }
+
+            TerminationState state = !exited       ? TerminationState::UNKILLABLE
+                                     : watch.killed ? TerminationState::KILLED
+                                                    : TerminationState::EXITED;
+            finished.push_back({watch.target.pid, watch.target.name, state,
+                                std::chrono::duration_cast<std::chrono::milliseconds>(now - watch.started)});
+            if (watch.target.pidfd >= 0)
+                close(watch.target.pidfd);
+            // poll_fds lines up with watches, so keep the two in step
+            watches.erase(watches.begin() + i);
+            poll_fds.erase(poll_fds.begin() + i + 1);
+        }
+
+        if (finished.empty())
+            continue;
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            for (auto &outcome : finished)
+            {
+                this->outcomes.push_back(std::move(outcome));
+                if (this->outcomes.size() > MAX_OUTCOMES)
+                    this->outcomes.pop_front();
+            }
+            this->pending -= std::min(this->pending, finished.size());
+        }
+        if (this->on_update)
+            this->on_update();
+    }
+
+    for (auto &watch : watches)
+    {
+        if (watch.target.pidfd >= 0)
+            close(watch.target.pidfd);
+    }
+}
@@ -0,0 +1,97 @@
+#ifndef __TERMINATION_REAPER_HPP
+#define __TERMINATION_REAPER_HPP
+
+#include "signal_batch.hpp"
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+enum class TerminationState
+{
+    EXITED,         // Exited within the grace period after SIGTERM
+    KILLED,         // Ignored SIGTERM for the grace period and exited after SIGKILL
+    ALREADY_EXITED, // Gone before SIGTERM was sent
+    DENIED,         // Not ours to signal
+    UNKILLABLE      // Still there after SIGKILL (e.g. stuck in uninterruptible sleep)
+};
+
+struct TerminationOutcome
+{
+    pid_t pid = 0;
+    std::string name;
+    TerminationState state = TerminationState::EXITED;
+    std::chrono::milliseconds exit_time{0}; // From SIGTERM until the process was gone
+};
+
+// e.g. "nginx (1234) exited 0.4 s after SIGTERM"
+std::string describe_termination(const TerminationOutcome &outcome);
+// One line for a batch: the outcome itself for one process, counts for more
+std::string summarize_terminations(const std::vector<TerminationOutcome> &outcomes);
+
+// Terminates processes politely and then firmly: SIGTERM, a grace period to
+// exit, SIGKILL if they are still there. Every process being terminated is
+// watched on one background thread that polls all their pidfds at once
+// (a pidfd turns readable when its process exits), so thousands can be in
+// flight without a thread or a sleep loop each.
+class TerminationReaper
+{
+public:
+    using Clock = std::chrono::steady_clock;
+    // How long to wait for a process to disappear after SIGKILL
+    static constexpr std::chrono::milliseconds KILL_TIMEOUT{2000};
+    static constexpr size_t MAX_OUTCOMES = 256;
+
+private:
+    struct Watch
+    {
+        SignalTarget target;
+        Clock::time_point started;
+        Clock::time_point deadline;
+        bool killed = false;
+    };
+
+    std::function<void()> on_update;
+    std::chrono::milliseconds grace_period;
+
+    // Guarded by mutex
+    std::vector<SignalTarget> incoming;
+    std::deque<TerminationOutcome> outcomes;
+    size_t pending = 0;
+    bool running = true;
+    mutable std::mutex mutex;
+
+    int wake_fd = -1; // eventfd that interrupts poll() for new targets and stop
+    std::thread worker;
+
+    void wake();
+    void run_loop();
+    void start_watch(SignalTarget &target, std::vector<Watch> &watches, std::vector<TerminationOutcome> &finished);
+
+public:
+    explicit TerminationReaper(std::function<void()> on_update = nullptr,
+                               std::chrono::milliseconds grace_period = std::chrono::milliseconds(3000));
+    ~TerminationReaper();
+    TerminationReaper(const TerminationReaper &) = delete;
+    TerminationReaper &operator=(const TerminationReaper &) = delete;
+
+    // Takes ownership of the targets' pidfds; returns immediately
+    void terminate(std::vector<SignalTarget> targets);
+
+    // Processes signalled but not yet gone
+    size_t get_pending_count() const;
+    // Finished terminations, oldest first, up to MAX_OUTCOMES
+    std::vector<TerminationOutcome> get_outcomes() const;
+    void clear_outcomes();
+
+    std::chrono::milliseconds get_grace_period() const
+    {
+        return this->grace_period;
+    }
+};
+
+#endif /* __TERMINATION_REAPER_HPP */
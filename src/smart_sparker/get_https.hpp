@@ -1,9 +0,0 @@
-#ifndef GET_HTTPS_HPP
-#define GET_HTTPS_HPP
-
-#include "json.hpp"
-#include <string>
-
-std::string get_https();
-
-#endif
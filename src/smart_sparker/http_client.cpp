@@ -0,0 +1,78 @@
+#include "http_client.hpp"
+#include <curl/curl.h>
+
+static std::once_flag curl_init_flag;
+
+static size_t append_body(void *contents, size_t size, size_t nmemb, void *userp)
+{
+    static_cast<std::string *>(userp)->append(static_cast<char *>(contents), size * nmemb);
+    return size * nmemb;
+}
+
+HttpClient::HttpClient(HttpClientOptions options) : options(options)
+{
+    std::call_once(curl_init_flag, []
+                   { curl_global_init(CURL_GLOBAL_DEFAULT); });
+    this->handle = curl_easy_init();
+}
+
+HttpClient::~HttpClient()
+{
+    if (this->handle)
+        curl_easy_cleanup(this->handle);
+}
+
+HttpResponse HttpClient::post(const std::string &url, const std::string &body, const std::vector<std::string> &headers)
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    HttpResponse response;
+    if (!this->handle)
+    {
+        response.error = "curl init failed";
+        return response;
+    }
+
+    struct curl_slist *header_list = nullptr;
+    for (const auto &header : headers)
+        header_list = curl_slist_append(header_list, header.c_str());
+    // Without this curl sends "Expect: 100-continue" for bodies over 1 KB and
+    // waits a round trip (or a second, if the server ignores it) before the body
+    header_list = curl_slist_append(header_list, "Expect:");
+
+    // Options stick to the handle between requests; these are reset each time
+    // so one request's settings never leak into the next
+    CURL *curl = this->handle;
+    curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, header_list);
+    curl_easy_setopt(curl, CURLOPT_POSTFIELDS, body.data());
+    curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE_LARGE, static_cast<curl_off_t>(body.size()));
+    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, append_body);
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response.body);
+    curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT_MS, static_cast<long>(this->options.connect_timeout.count()));
+    curl_easy_setopt(curl, CURLOPT_TIMEOUT_MS, static_cast<long>(this->options.timeout.count()));
+    curl_easy_setopt(curl, CURLOPT_TCP_KEEPALIVE, 1L);
+    // Timeouts must not use SIGALRM: this runs off the main thread
+    curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
+
+    CURLcode result = curl_easy_perform(curl);
+    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, nullptr);
+    curl_slist_free_all(header_list);
+
+    long new_connections = 0;
+    curl_easy_getinfo(curl, CURLINFO_NUM_CONNECTS, &new_connections);
+    this->connections_opened += static_cast<uint64_t>(new_connections);
+
+    if (result != CURLE_OK)
+    {
+        response.error = curl_easy_strerror(result);
+        return response;
+    }
+    curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &response.status);
+    return response;
+}
+
+uint64_t HttpClient::get_connections_opened()
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return this->connections_opened;
+}
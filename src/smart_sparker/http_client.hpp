@@ -0,0 +1,49 @@
+#ifndef __HTTP_CLIENT_HPP
+#define __HTTP_CLIENT_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+typedef void CURL;
+
+struct HttpResponse
+{
+    long status = 0;   // 0 if the request never got a response
+    std::string body;
+    std::string error; // Transport error (timeout, refused, TLS), empty otherwise
+};
+
+struct HttpClientOptions
+{
+    std::chrono::milliseconds connect_timeout{3000};
+    std::chrono::milliseconds timeout{15000}; // Whole request, including the connect
+};
+
+// A libcurl easy handle kept for the lifetime of the client, so consecutive
+// requests to the same host reuse its connection (and TLS session) instead
+// of handshaking every time. Requests are serialized on the one handle.
+class HttpClient
+{
+private:
+    HttpClientOptions options;
+    CURL *handle = nullptr;
+    uint64_t connections_opened = 0;
+    std::mutex mutex;
+
+public:
+    explicit HttpClient(HttpClientOptions options = HttpClientOptions{});
+    ~HttpClient();
+    HttpClient(const HttpClient &) = delete;
+    HttpClient &operator=(const HttpClient &) = delete;
+
+    // headers are complete lines, e.g. "Content-Type: application/json"
+    HttpResponse post(const std::string &url, const std::string &body, const std::vector<std::string> &headers);
+
+    // New connections made so far; stays put while the connection is reused
+    uint64_t get_connections_opened();
+};
+
+#endif /* __HTTP_CLIENT_HPP */
@@ -0,0 +1,192 @@
+#include "gemini_backend.hpp"
+#include "../load_env.hpp"
+#include "../process_sorter.hpp"
+#include "../json.hpp"
+#include <cmath>
+
+using json = nlohmann::json;
+
+static const char *const FIXED_PROMPT =
+    "You are a resource optimization AI.\n"
+    "Analyze the following processes based on:\n"
+    "- CPU usage\n"
+    "- Memory usage\n"
+    "- Network usage\n"
+    "- Process name significance\n\n"
+    "Return ONLY the PID (just the number) of the single process that is the best candidate to kill.\n"
+    "No explanation. No extra text. Only return the PID.\n"
+    "Avoid killing critical system processes.";
+
+GeminiOptions GeminiOptions::from_environment()
+{
+    static std::once_flag env_loaded;
+    std::call_once(env_loaded, []
+                   { env::load_env_file(".env"); });
+
+    GeminiOptions options;
+    if (const char *key = std::getenv("GEMINI_API_KEY"))
+        options.api_key = key;
+    return options;
+}
+
+uint64_t snapshot_fingerprint(const std::vector<Process> &top_processes)
+{
+    // FNV-1a over the fields the payload is built from
+    uint64_t hash = 14695981039346656037ull;
+    auto mix = [&hash](const void *data, size_t size)
+    {
+        const unsigned char *bytes = static_cast<const unsigned char *>(data);
+        for (size_t i = 0; i < size; i++)
+        {
+            hash ^= bytes[i];
+            hash *= 1099511628211ull;
+        }
+    };
+
+    for (const auto &proc : top_processes)
+    {
+        pid_t pid = proc.get_pid();
+        long cpu = std::lround(proc.get_cpu_usage());
+        unsigned long memory_mb = proc.get_memory_usage() / 1024;
+        mix(&pid, sizeof(pid));
+        mix(proc.get_process_name().data(), proc.get_process_name().size());
+        mix(&cpu, sizeof(cpu));
+        mix(&memory_mb, sizeof(memory_mb));
+    }
+    return hash;
+}
+
+GeminiBackend::GeminiBackend(GeminiOptions options)
+    : options(std::move(options)), client(this->options.http)
+{
+}
+
+bool GeminiBackend::lookup(uint64_t fingerprint, std::string &pid_text)
+{
+    std::lock_guard<std::mutex> lock(this->cache_mutex);
+    auto it = this->cache.find(fingerprint);
+    if (it == this->cache.end())
+        return false;
+    if (std::chrono::steady_clock::now() - it->second.stored > this->options.cache_ttl)
+    {
+        this->lru.erase(it->second.lru_position);
+        this->cache.erase(it);
+        return false;
+    }
+    this->lru.splice(this->lru.begin(), this->lru, it->second.lru_position);
+    pid_text = it->second.pid_text;
+    return true;
+}
+
+void GeminiBackend::store(uint64_t fingerprint, const std::string &pid_text)
+{
+    std::lock_guard<std::mutex> lock(this->cache_mutex);
+    if (this->options.cache_entries == 0)
+        return;
+
+    auto it = this->cache.find(fingerprint);
+    if (it != this->cache.end())
+    {
+        this->lru.erase(it->second.lru_position);
+        this->cache.erase(it);
+    }
+    while (this->cache.size() >= this->options.cache_entries)
+    {
+        this->cache.erase(this->lru.back());
+        this->lru.pop_back();
+    }
+    this->lru.push_front(fingerprint);
+    this->cache[fingerprint] = CachedAnswer{pid_text, std::chrono::steady_clock::now(), this->lru.begin()};
+}
+
+std::string GeminiBackend::request(const std::vector<Process> &top_processes, std::string &error)
+{
+    // {"contents":[{"parts":[{"text":"<prompt + snapshot>"}]}]}, streamed
+    // straight into the reused buffers instead of through a JSON DOM
+    std::lock_guard<std::mutex> lock(this->request_mutex);
+    std::string_view snapshot = this->writer.write(top_processes, SnapshotFormat::JSON,
+                                                   SNAPSHOT_PID | SNAPSHOT_NAME | SNAPSHOT_CPU | SNAPSHOT_MEMORY |
+                                                       SNAPSHOT_NETWORK | SNAPSHOT_UPTIME);
+    this->payload.clear();
+    this->payload.append("{\"contents\":[{\"parts\":[{\"text\":\"");
+    append_json_escaped(this->payload, FIXED_PROMPT);
+    append_json_escaped(this->payload, "\n\nProcesses:\n");
+    append_json_escaped(this->payload, snapshot);
+    this->payload.append("\"}]}]}");
+
+    HttpResponse response = this->client.post(this->options.endpoint, this->payload,
+                                              {"Content-Type: application/json",
+                                               "x-goog-api-key: " + this->options.api_key});
+    if (!response.error.empty())
+    {
+        error = response.error;
+        return "";
+    }
+    if (response.status != 200)
+    {
+        error = "HTTP " + std::to_string(response.status);
+        return "";
+    }
+
+    try
+    {
+        json resp_json = json::parse(response.body);
+        return resp_json["candidates"][0]["content"]["parts"][0]["text"].get<std::string>();
+    }
+    catch (const std::exception &e)
+    {
+        error = std::string("Failed to parse Gemini response: ") + e.what();
+        return "";
+    }
+}
+
+KillRecommendation GeminiBackend::recommend(const std::vector<Process> &processes)
+{
+    KillRecommendation recommendation;
+    if (this->options.api_key.empty())
+    {
+        recommendation.error = "GEMINI_API_KEY not set";
+        return recommendation;
+    }
+
+    // Selected once; the cache key and the prompt are both built from it
+    std::vector<Process> top = select_top_processes(processes);
+    if (top.empty())
+    {
+        recommendation.error = "No processes found";
+        return recommendation;
+    }
+
+    uint64_t fingerprint = snapshot_fingerprint(top);
+    std::string pid_str;
+    if (!this->lookup(fingerprint, pid_str))
+    {
+        pid_str = this->request(top, recommendation.error);
+        if (!recommendation.error.empty())
+            return recommendation;
+        this->store(fingerprint, pid_str);
+    }
+
+    pid_t target_pid;
+    try
+    {
+        target_pid = std::stoi(pid_str);
+    }
+    catch (...)
+    {
+        recommendation.error = "Invalid PID: " + pid_str;
+        return recommendation;
+    }
+
+    recommendation.pid = target_pid;
+    recommendation.name = "Unknown Process";
+    for (const auto &proc : processes)
+    {
+        if (proc.get_pid() == target_pid)
+        {
+            recommendation.name = proc.get_process_name();
+            break;
+        }
+    }
+    return recommendation;
+}
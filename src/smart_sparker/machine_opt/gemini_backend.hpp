@@ -0,0 +1,74 @@
+#ifndef __GEMINI_BACKEND_HPP
+#define __GEMINI_BACKEND_HPP
+
+#include "optimizer_backend.hpp"
+#include "../http_client.hpp"
+#include "../../processes_list/snapshot_writer.hpp"
+#include <chrono>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+struct GeminiOptions
+{
+    std::string endpoint =
+        "https://generativelanguage.googleapis.com/v1beta/models/gemini-2.5-flash:generateContent";
+    std::string api_key;
+    HttpClientOptions http;
+    size_t cache_entries = 32;
+    std::chrono::seconds cache_ttl{120};
+
+    // API key from GEMINI_API_KEY, after loading .env once
+    static GeminiOptions from_environment();
+};
+
+// Identifies what the model is shown: the top processes from
+// select_top_processes, with CPU rounded to whole percent and memory to MB, so
+// snapshots a tick apart that look the same to the model share an answer.
+uint64_t snapshot_fingerprint(const std::vector<Process> &top_processes);
+
+// Asks the Gemini API (or anything answering in its format, such as a local
+// stand-in) for a PID to kill. The HTTP connection is kept open between
+// requests and answers are cached by snapshot fingerprint.
+class GeminiBackend : public OptimizerBackend
+{
+private:
+    struct CachedAnswer
+    {
+        std::string pid_text;
+        std::chrono::steady_clock::time_point stored;
+        std::list<uint64_t>::iterator lru_position;
+    };
+
+    GeminiOptions options;
+    HttpClient client;
+    std::unordered_map<uint64_t, CachedAnswer> cache;
+    std::list<uint64_t> lru; // Most recently used first
+    std::mutex cache_mutex;
+    // Request bodies are built in these, reused between requests
+    SnapshotWriter writer;
+    std::string payload;
+    std::mutex request_mutex;
+
+    bool lookup(uint64_t fingerprint, std::string &pid_text);
+    void store(uint64_t fingerprint, const std::string &pid_text);
+    std::string request(const std::vector<Process> &top_processes, std::string &error);
+
+public:
+    explicit GeminiBackend(GeminiOptions options = GeminiOptions::from_environment());
+
+    std::string get_name() const override
+    {
+        return "Gemini";
+    }
+    KillRecommendation recommend(const std::vector<Process> &processes) override;
+
+    HttpClient &get_client()
+    {
+        return this->client;
+    }
+};
+
+#endif /* __GEMINI_BACKEND_HPP */
@@ -0,0 +1,162 @@
+#include "kill_candidate_scorer.hpp"
+#include "../../proc_io/proc_file.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <unistd.h>
+
+static std::string format_kb(double kb)
+{
+    char buffer[32];
+    if (kb >= 1024.0 * 1024.0)
+        snprintf(buffer, sizeof(buffer), "%.1f GB", kb / (1024.0 * 1024.0));
+    else
+        snprintf(buffer, sizeof(buffer), "%.0f MB", kb / 1024.0);
+    return buffer;
+}
+
+KillCandidateScorer::KillCandidateScorer(std::shared_ptr<const ProcessHistoryStore> history, ScoringRules rules,
+                                         std::string proc_root)
+    : history(std::move(history)), rules(std::move(rules)), proc_root(std::move(proc_root)), own_pid(getpid())
+{
+}
+
+bool KillCandidateScorer::is_protected(const Process &process) const
+{
+    pid_t pid = process.get_pid();
+    // init, kthreadd, ourselves, and kernel threads (children of kthreadd,
+    // or no memory and no command line when the backend has no parent)
+    if (pid <= 2 || pid == this->own_pid || process.get_parent_pid() == 2)
+        return true;
+    if (process.get_memory_usage() == 0 && process.get_command().empty())
+        return true;
+
+    const auto &uids = this->rules.protected_uids;
+    if (std::find(uids.begin(), uids.end(), process.get_uid()) != uids.end())
+        return true;
+    const auto &names = this->rules.protected_names;
+    return std::find(names.begin(), names.end(), process.get_process_name()) != names.end();
+}
+
+bool KillCandidateScorer::in_protected_cgroup(pid_t pid) const
+{
+    if (this->rules.protected_cgroups.empty())
+        return false;
+
+    // One "hierarchy:controllers:path" line per hierarchy; cgroup v2 has one
+    ProcFile file(this->proc_root + "/" + std::to_string(pid) + "/cgroup", 4096);
+    std::string_view contents = file.read();
+    size_t pos = 0;
+    while (pos < contents.size())
+    {
+        size_t end = contents.find('\n', pos);
+        if (end == std::string_view::npos)
+            end = contents.size();
+        std::string_view line = contents.substr(pos, end - pos);
+        pos = end + 1;
+
+        size_t first = line.find(':');
+        size_t second = first == std::string_view::npos ? first : line.find(':', first + 1);
+        if (second == std::string_view::npos)
+            continue;
+        std::string_view path = line.substr(second + 1);
+        for (const auto &prefix : this->rules.protected_cgroups)
+        {
+            if (path.starts_with(prefix))
+                return true;
+        }
+    }
+    return false;
+}
+
+double KillCandidateScorer::score(const Process &process, unsigned long total_memory_kb,
+                                  std::vector<std::string> *reasons) const
+{
+    double cpu = process.get_cpu_usage();
+    double score = this->rules.cpu_weight * cpu / 100.0;
+    if (reasons && cpu >= 5.0)
+        reasons->push_back(std::to_string(static_cast<int>(cpu + 0.5)) + "% CPU");
+
+    double share = total_memory_kb > 0 ? static_cast<double>(process.get_memory_usage()) / total_memory_kb : 0.0;
+    score += this->rules.memory_weight * share;
+    if (reasons && share >= 0.05)
+        reasons->push_back(format_kb(process.get_memory_usage()) + " RSS (" +
+                           std::to_string(static_cast<int>(share * 100 + 0.5)) + "% of all)");
+
+    if (this->history)
+    {
+        MemoryTrend trend = this->history->get_memory_trend(process.get_pid());
+        if (trend.samples >= 2 && trend.oldest_kb > 0.0f && trend.newest_kb > trend.oldest_kb)
+        {
+            double growth = std::min(1.0, trend.newest_kb / trend.oldest_kb - 1.0);
+            score += this->rules.growth_weight * growth;
+            if (reasons && growth >= 0.1)
+                reasons->push_back("RSS +" + std::to_string(static_cast<int>(growth * 100 + 0.5)) + "% over " +
+                                   std::to_string(trend.samples) + " samples");
+        }
+    }
+
+    int nice = process.get_nice();
+    score += this->rules.nice_weight * nice / (nice > 0 ? 19.0 : 20.0);
+    if (reasons && nice > 0)
+        reasons->push_back("nice " + std::to_string(nice));
+
+    if (process.get_cpu_time() < this->rules.min_age_seconds)
+    {
+        score *= this->rules.young_factor;
+        if (reasons)
+            reasons->push_back("started " + std::to_string(process.get_cpu_time()) + " s ago");
+    }
+    return score;
+}
+
+std::vector<KillCandidate> KillCandidateScorer::rank(const std::vector<Process> &processes, size_t limit) const
+{
+    unsigned long total_memory_kb = 0;
+    for (const auto &process : processes)
+        total_memory_kb += process.get_memory_usage();
+
+    // Scores first, without building any strings; reasons only for the winners
+    std::vector<std::pair<double, size_t>> scored;
+    scored.reserve(processes.size());
+    for (size_t i = 0; i < processes.size(); i++)
+    {
+        if (this->is_protected(processes[i]))
+            continue;
+        double score = this->score(processes[i], total_memory_kb, nullptr);
+        if (score >= this->rules.min_score)
+            scored.emplace_back(score, i);
+    }
+
+    size_t considered = std::min(scored.size(), std::max(limit, this->rules.cgroup_checks));
+    std::partial_sort(scored.begin(), scored.begin() + considered, scored.end(),
+                      [](const auto &a, const auto &b)
+                      { return a.first > b.first; });
+
+    std::vector<KillCandidate> candidates;
+    for (size_t i = 0; i < considered && candidates.size() < limit; i++)
+    {
+        const Process &process = processes[scored[i].second];
+        if (this->in_protected_cgroup(process.get_pid()))
+            continue;
+
+        KillCandidate candidate{process, scored[i].first, {}};
+        this->score(process, total_memory_kb, &candidate.reasons);
+        candidates.push_back(std::move(candidate));
+    }
+    return candidates;
+}
+
+KillRecommendation KillCandidateScorer::recommend(const std::vector<Process> &processes)
+{
+    KillRecommendation recommendation;
+    std::vector<KillCandidate> candidates = this->rank(processes, 1);
+    if (candidates.empty())
+        return recommendation;
+
+    KillCandidate &best = candidates.front();
+    recommendation.pid = best.process.get_pid();
+    recommendation.name = best.process.get_process_name();
+    recommendation.score = best.score;
+    recommendation.reasons = std::move(best.reasons);
+    return recommendation;
+}
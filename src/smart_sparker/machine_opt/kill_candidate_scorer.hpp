@@ -0,0 +1,75 @@
+#ifndef __KILL_CANDIDATE_SCORER_HPP
+#define __KILL_CANDIDATE_SCORER_HPP
+
+#include "optimizer_backend.hpp"
+#include "../../metrics/process_history.hpp"
+#include <memory>
+#include <string>
+#include <vector>
+
+// What makes a process a good kill candidate, and what must never be one
+struct ScoringRules
+{
+    // Compared against the process name (the kernel's 15-character comm)
+    std::vector<std::string> protected_names = {
+        "systemd", "init", "kthreadd", "sshd", "dbus-daemon", "dbus-broker", "systemd-journal",
+        "systemd-udevd", "systemd-logind", "agetty", "login", "containerd", "dockerd", "kubelet",
+        "Xorg", "Xwayland", "gnome-shell", "NetworkManager", "houston"};
+    std::vector<uid_t> protected_uids = {0};
+    // Prefixes of the paths in /proc/<pid>/cgroup
+    std::vector<std::string> protected_cgroups = {"/init.scope", "/system.slice/sshd.service",
+                                                  "/system.slice/systemd-", "/system.slice/dbus"};
+
+    double cpu_weight = 1.0;    // Per 100% of one CPU
+    double memory_weight = 2.0; // Per share of the snapshot's total RSS
+    double growth_weight = 1.5; // Per doubling of RSS across the kept history
+    double nice_weight = 0.25;  // At nice 19; negative niceness counts against
+    // Processes younger than this have their score scaled by young_factor
+    unsigned long min_age_seconds = 60;
+    double young_factor = 0.5;
+    // Below this nothing is worth killing
+    double min_score = 0.1;
+    // Reading cgroups costs a file open, so only this many of the best
+    // scoring processes are checked (and considered) at all
+    size_t cgroup_checks = 16;
+};
+
+struct KillCandidate
+{
+    Process process;
+    double score = 0.0;
+    std::vector<std::string> reasons;
+};
+
+// Ranks kill candidates on the machine itself from the snapshot and the
+// per-process history: CPU, share of resident memory, RSS growth, niceness
+// and age, with allow-lists for processes that must never be suggested.
+// Ranking a few thousand processes takes microseconds and needs no network.
+class KillCandidateScorer : public OptimizerBackend
+{
+private:
+    std::shared_ptr<const ProcessHistoryStore> history;
+    ScoringRules rules;
+    std::string proc_root;
+    pid_t own_pid;
+
+    bool is_protected(const Process &process) const;
+    bool in_protected_cgroup(pid_t pid) const;
+    // reasons may be null when only the score is needed
+    double score(const Process &process, unsigned long total_memory_kb, std::vector<std::string> *reasons) const;
+
+public:
+    explicit KillCandidateScorer(std::shared_ptr<const ProcessHistoryStore> history = nullptr,
+                                 ScoringRules rules = ScoringRules{}, std::string proc_root = "/proc");
+
+    // Best candidates first, at most limit of them
+    std::vector<KillCandidate> rank(const std::vector<Process> &processes, size_t limit) const;
+
+    std::string get_name() const override
+    {
+        return "Local scorer";
+    }
+    KillRecommendation recommend(const std::vector<Process> &processes) override;
+};
+
+#endif /* __KILL_CANDIDATE_SCORER_HPP */
@@ -1,14 +1,22 @@
 #pragma once
 #include <future>
+#include <memory>
 #include <string>
 #include <vector>
-#include <utility>
-#include <sys/types.h>
+#include "optimizer_backend.hpp"
+#include "../process_sorter.hpp"
 #include "../../processes_list/process.hpp"
 
 class MachineOptimizer {
 public:
-    // Returns a pair: <display_string, pid>
-    std::future<std::pair<std::string, pid_t>> run_async(const std::vector<Process>& processes);
-};
+    explicit MachineOptimizer(std::shared_ptr<OptimizerBackend> backend);
+
+    // Runs the backend on its own thread so a slow one never blocks the UI.
+    // The snapshot is shared, not copied, and must not be modified.
+    std::future<KillRecommendation> run_async(ProcessSnapshot processes);
 
+    std::string get_backend_name() const;
+
+private:
+    std::shared_ptr<OptimizerBackend> backend;
+};
@@ -0,0 +1,32 @@
+#ifndef __OPTIMIZER_BACKEND_HPP
+#define __OPTIMIZER_BACKEND_HPP
+
+#include "../../processes_list/process.hpp"
+#include <chrono>
+#include <string>
+#include <sys/types.h>
+#include <vector>
+
+// The process an optimizer backend suggests killing, and why
+struct KillRecommendation
+{
+    pid_t pid = -1; // -1 if nothing was recommended
+    std::string name;
+    double score = 0.0;
+    std::vector<std::string> reasons;
+    std::string error; // Set instead of pid when the backend failed
+    std::chrono::microseconds elapsed{0};
+};
+
+// Something that picks a kill candidate from a process snapshot. recommend
+// may block and is always called off the UI thread.
+class OptimizerBackend
+{
+public:
+    virtual ~OptimizerBackend() = default;
+
+    virtual std::string get_name() const = 0;
+    virtual KillRecommendation recommend(const std::vector<Process> &processes) = 0;
+};
+
+#endif /* __OPTIMIZER_BACKEND_HPP */
@@ -1,56 +1,49 @@
 #include "process_sorter.hpp"
 #include <algorithm>
+#include <numeric>
 #include <unordered_set>
-#include "json.hpp"
-#include "../processes_list/processes_list.hpp"
-using json = nlohmann::json;
 
-json get_top_processes_json()
+static double metric_value(const Process &p, SortMetric metric)
 {
-    std::vector<Process> all = get_processes_list();
-    if (all.empty())
-        return json{ {"processes", json::array()} };
-
-    std::vector<Process> by_cpu = all;
-    std::sort(by_cpu.begin(), by_cpu.end(),
-        [](const Process &a, const Process &b){
-            return a.get_cpu_usage() > b.get_cpu_usage();
-        });
-    if (by_cpu.size() > 20)
-        by_cpu.erase(by_cpu.begin() + 20, by_cpu.end());
-
-    std::vector<Process> by_mem = all;
-    std::sort(by_mem.begin(), by_mem.end(),
-        [](const Process &a, const Process &b){
-            return a.get_memory_usage() > b.get_memory_usage();
-        });
-    if (by_mem.size() > 20)
-        by_mem.erase(by_mem.begin() + 20, by_mem.end());
+    switch (metric)
+    {
+    case SortMetric::MEMORY:
+        return static_cast<double>(p.get_memory_usage());
+    case SortMetric::NETWORK:
+        return static_cast<double>(p.get_network_usage());
+    case SortMetric::UPTIME:
+        return static_cast<double>(p.get_cpu_time());
+    default:
+        return p.get_cpu_usage();
+    }
+}
 
-    std::unordered_set<pid_t> seen;
+std::vector<Process> select_top_processes(const std::vector<Process> &processes,
+                                          const std::vector<SortMetric> &metrics, size_t per_metric)
+{
     std::vector<Process> merged;
+    if (processes.empty() || per_metric == 0)
+        return merged;
 
-    for (const auto& p : by_cpu)
-        if (seen.insert(p.get_pid()).second)
-            merged.push_back(p);
-
-    for (const auto& p : by_mem)
-        if (seen.insert(p.get_pid()).second)
-            merged.push_back(p);
+    std::vector<size_t> order(processes.size());
+    size_t k = std::min(per_metric, processes.size());
+    std::unordered_set<pid_t> seen;
 
-    json processes_json = json::array();
-    for (const auto& p : merged) {
-        processes_json.push_back({
-            {"pid", p.get_pid()},
-            {"name", p.get_process_name()},
-            {"cpu_usage", p.get_cpu_usage()},
-            {"memory_usage", p.get_memory_usage()},
-            {"network_usage", p.get_network_usage()},
-            {"cpu_time", p.get_cpu_time()}
-        });
+    for (SortMetric metric : metrics)
+    {
+        // Only the first k positions are ordered; the rest are left as they fall
+        std::iota(order.begin(), order.end(), 0);
+        std::partial_sort(order.begin(), order.begin() + k, order.end(),
+            [&](size_t a, size_t b){
+                return metric_value(processes[a], metric) > metric_value(processes[b], metric);
+            });
+
+        for (size_t i = 0; i < k; i++)
+        {
+            const Process &p = processes[order[i]];
+            if (seen.insert(p.get_pid()).second)
+                merged.push_back(p);
+        }
     }
-
-    return json{
-        {"processes", processes_json}
-    };
+    return merged;
 }
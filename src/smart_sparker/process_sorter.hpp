@@ -1,14 +1,27 @@
 #ifndef PROCESS_SORTER_HPP
 #define PROCESS_SORTER_HPP
-#include <iostream>
-#include "json.hpp"  // nlohmann::json
 #include "../processes_list/process.hpp"
+#include <cstddef>
+#include <memory>
 #include <vector>
 
-// Return full list of processes (CPU + memory + merged top 20)
-std::vector<Process> get_top_processes();
+// A process snapshot shared read-only between the UI and background work
+using ProcessSnapshot = std::shared_ptr<const std::vector<Process>>;
 
-// Return JSON ready to send to AI
-nlohmann::json get_top_processes_json();
+enum class SortMetric
+{
+    CPU,
+    MEMORY,
+    NETWORK,
+    UPTIME
+};
+
+// The top per_metric processes by each metric in turn, merged without
+// duplicates: everything in the top per_metric by CPU, then anything new
+// from the top by memory, and so on. Selects with partial_sort over indices
+// instead of sorting copies of the whole snapshot.
+std::vector<Process> select_top_processes(const std::vector<Process> &processes,
+                                          const std::vector<SortMetric> &metrics = {SortMetric::CPU, SortMetric::MEMORY},
+                                          size_t per_metric = 20);
 
 #endif
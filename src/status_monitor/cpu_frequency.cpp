@@ -0,0 +1,194 @@
+#include "cpu_frequency.hpp"
+#include <algorithm>
+#include <charconv>
+#include <filesystem>
+
+// Parses the single integer value of a sysfs attribute
+static bool read_long(ProcFile &file, long long &value)
+{
+    uint64_t parsed = 0;
+    if (!parse_u64(file.read(), parsed))
+        return false;
+    value = static_cast<long long>(parsed);
+    return true;
+}
+
+// Reads a sysfs attribute that is only needed once
+static bool read_long_once(const std::string &path, long long &value)
+{
+    ProcFile file(path, 64);
+    return read_long(file, value);
+}
+
+CpuFrequencyMonitor::CpuFrequencyMonitor()
+{
+    this->open_core_files();
+}
+
+CpuFrequencyMonitor::~CpuFrequencyMonitor()
+{
+}
+
+void CpuFrequencyMonitor::open_core_files()
+{
+    namespace fs = std::filesystem;
+    std::vector<int> cpu_ids;
+
+    std::error_code ec;
+    for (const auto &entry : fs::directory_iterator("/sys/devices/system/cpu", ec))
+    {
+        std::string name = entry.path().filename().string();
+        if (name.size() <= 3 || name.rfind("cpu", 0) != 0)
+            continue;
+        if (!std::all_of(name.begin() + 3, name.end(), ::isdigit))
+            continue;
+        cpu_ids.push_back(std::stoi(name.substr(3)));
+    }
+    std::sort(cpu_ids.begin(), cpu_ids.end());
+
+    for (int cpu_id : cpu_ids)
+    {
+        std::string base = "/sys/devices/system/cpu/cpu" + std::to_string(cpu_id);
+        ProcFile cur_freq(base + "/cpufreq/scaling_cur_freq", 64);
+        if (!cur_freq.is_open())
+            continue;
+
+        CoreFrequency core;
+        core.cpu_id = cpu_id;
+
+        long long khz = 0;
+        if (read_long_once(base + "/cpufreq/cpuinfo_min_freq", khz))
+            core.min_mhz = khz / 1000.0;
+        if (read_long_once(base + "/cpufreq/cpuinfo_max_freq", khz))
+            core.max_mhz = khz / 1000.0;
+
+        this->cores.push_back(core);
+        // core_throttle_count is only exposed on Intel machines; absent elsewhere, which is fine.
+        this->files.push_back(CoreFiles{std::move(cur_freq),
+                                        ProcFile(base + "/cpufreq/scaling_max_freq", 64),
+                                        ProcFile(base + "/thermal_throttle/core_throttle_count", 64)});
+    }
+
+    this->cpufreq_available = !this->cores.empty();
+    if (!this->cpufreq_available)
+        this->cpuinfo = ProcFile("/proc/cpuinfo", 65536);
+}
+
+void CpuFrequencyMonitor::rescan()
+{
+    // Keep the history of CPUs that are still present after a hotplug event
+    std::vector<CoreFrequency> previous = std::move(this->cores);
+    this->cores.clear();
+    this->files.clear();
+    this->cpuinfo.close();
+    this->open_core_files();
+
+    for (auto &core : this->cores)
+    {
+        auto it = std::find_if(previous.begin(), previous.end(),
+                               [&core](const CoreFrequency &old) { return old.cpu_id == core.cpu_id; });
+        if (it != previous.end())
+            core.history_mhz = std::move(it->history_mhz);
+    }
+}
+
+void CpuFrequencyMonitor::push_history(CoreFrequency &core)
+{
+    core.history_mhz.push(core.current_mhz);
+}
+
+void CpuFrequencyMonitor::update()
+{
+    if (!this->cpufreq_available)
+    {
+        this->update_from_cpuinfo();
+        return;
+    }
+
+    for (size_t i = 0; i < this->cores.size(); i++)
+    {
+        CoreFrequency &core = this->cores[i];
+        CoreFiles &core_files = this->files[i];
+
+        long long khz = 0;
+        if (read_long(core_files.cur_freq, khz))
+            core.current_mhz = khz / 1000.0;
+
+        // A policy cap below the hardware maximum means the kernel (thermal or
+        // power management) is holding the core back.
+        bool capped = false;
+        long long scaling_max_khz = 0;
+        if (core.max_mhz > 0.0 && read_long(core_files.scaling_max, scaling_max_khz))
+            capped = (scaling_max_khz / 1000.0) < core.max_mhz;
+
+        bool throttle_event = false;
+        long long throttle_count = 0;
+        if (read_long(core_files.throttle_count, throttle_count))
+        {
+            throttle_event = core_files.last_throttle_count >= 0 && throttle_count > core_files.last_throttle_count;
+            core_files.last_throttle_count = throttle_count;
+        }
+
+        core.throttled = capped || throttle_event;
+        this->push_history(core);
+    }
+}
+
+// Fallback for machines without cpufreq (most VMs): the only source of clock
+// speeds is /proc/cpuinfo, which has no min/max or throttling information.
+void CpuFrequencyMonitor::update_from_cpuinfo()
+{
+    if (!this->cpuinfo.is_open())
+        return;
+
+    std::string_view contents = this->cpuinfo.read();
+    size_t index = 0;
+    int cpu_id = -1;
+    size_t pos = 0;
+
+    while (pos < contents.size())
+    {
+        size_t end = contents.find('\n', pos);
+        if (end == std::string_view::npos)
+            end = contents.size();
+        std::string_view line = contents.substr(pos, end - pos);
+        pos = end + 1;
+
+        size_t colon = line.find(':');
+        if (colon == std::string_view::npos)
+            continue;
+        std::string_view value = line.substr(colon + 1);
+        while (!value.empty() && value.front() == ' ')
+            value.remove_prefix(1);
+
+        if (line.starts_with("processor"))
+        {
+            std::from_chars(value.data(), value.data() + value.size(), cpu_id);
+        }
+        else if (line.starts_with("cpu MHz"))
+        {
+            double val;
+            if (std::from_chars(value.data(), value.data() + value.size(), val).ec != std::errc())
+                continue;
+
+            if (index >= this->cores.size())
+                this->cores.emplace_back();
+
+            CoreFrequency &core = this->cores[index++];
+            core.cpu_id = cpu_id >= 0 ? cpu_id : static_cast<int>(index - 1);
+            core.current_mhz = val;
+            this->push_history(core);
+        }
+    }
+
+    if (index < this->cores.size())
+        this->cores.resize(index);
+}
+
+double CpuFrequencyMonitor::get_max_current_mhz() const
+{
+    double max_mhz = 0.0;
+    for (const auto &core : this->cores)
+        max_mhz = std::max(max_mhz, core.current_mhz);
+    return max_mhz;
+}
@@ -0,0 +1,64 @@
+#ifndef __CPU_FREQUENCY_HPP
+#define __CPU_FREQUENCY_HPP
+
+#include <string>
+#include <vector>
+#include "../proc_io/proc_file.hpp"
+#include "../metrics/time_series.hpp"
+
+struct CoreFrequency
+{
+    int cpu_id = 0;
+    double current_mhz = 0.0;
+    double min_mhz = 0.0;
+    double max_mhz = 0.0;
+    bool throttled = false;
+    TimeSeries<double> history_mhz;
+};
+
+// Samples per-core clock speeds from sysfs cpufreq. The scaling_cur_freq files are
+// opened once and re-read with pread() on every update, so a tick costs one syscall
+// per core instead of a full /proc/cpuinfo parse. Without cpufreq, /proc/cpuinfo
+// is kept open instead.
+class CpuFrequencyMonitor
+{
+private:
+    struct CoreFiles
+    {
+        ProcFile cur_freq;
+        ProcFile scaling_max;
+        ProcFile throttle_count;
+        long long last_throttle_count = -1;
+    };
+
+    std::vector<CoreFrequency> cores;
+    std::vector<CoreFiles> files;
+    bool cpufreq_available = false;
+    ProcFile cpuinfo{""};
+
+    void open_core_files();
+    void update_from_cpuinfo();
+    void push_history(CoreFrequency &core);
+
+public:
+    CpuFrequencyMonitor();
+    ~CpuFrequencyMonitor();
+    CpuFrequencyMonitor(const CpuFrequencyMonitor &) = delete;
+    CpuFrequencyMonitor &operator=(const CpuFrequencyMonitor &) = delete;
+
+    void update();
+    // Re-enumerates the cpufreq files after CPUs come online or go offline
+    void rescan();
+
+    const std::vector<CoreFrequency> *get_cores() const
+    {
+        return &this->cores;
+    }
+    bool is_cpufreq_available() const
+    {
+        return this->cpufreq_available;
+    }
+    double get_max_current_mhz() const;
+};
+
+#endif /* __CPU_FREQUENCY_HPP */
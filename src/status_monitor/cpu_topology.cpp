@@ -0,0 +1,207 @@
+#include "cpu_topology.hpp"
+#include <algorithm>
+#include <charconv>
+#include <filesystem>
+#include <map>
+
+std::vector<int> parse_cpu_list(std::string_view list)
+{
+    std::vector<int> ids;
+    size_t pos = 0;
+    while (pos < list.size())
+    {
+        size_t end = list.find(',', pos);
+        if (end == std::string_view::npos)
+            end = list.size();
+        std::string_view range = list.substr(pos, end - pos);
+        pos = end + 1;
+
+        while (!range.empty() && (range.back() == '\n' || range.back() == ' '))
+            range.remove_suffix(1);
+        if (range.empty())
+            continue;
+
+        int first = 0;
+        int last = 0;
+        auto result = std::from_chars(range.data(), range.data() + range.size(), first);
+        if (result.ec != std::errc())
+            continue;
+        last = first;
+        if (result.ptr < range.data() + range.size() && *result.ptr == '-')
+            std::from_chars(result.ptr + 1, range.data() + range.size(), last);
+
+        for (int id = first; id <= last; id++)
+            ids.push_back(id);
+    }
+    return ids;
+}
+
+// Reads a single integer sysfs attribute, returning fallback if it is missing
+static int read_int(const std::string &path, int fallback)
+{
+    ProcFile file(path, 64);
+    std::string_view contents = file.read();
+    int value = fallback;
+    if (!contents.empty())
+        std::from_chars(contents.data(), contents.data() + contents.size(), value);
+    return value;
+}
+
+static bool is_numbered_entry(const std::string &name, const std::string &prefix)
+{
+    return name.size() > prefix.size() && name.rfind(prefix, 0) == 0 &&
+           std::all_of(name.begin() + prefix.size(), name.end(), ::isdigit);
+}
+
+CpuTopology::CpuTopology(const std::string &sysfs_root)
+{
+    namespace fs = std::filesystem;
+    std::error_code ec;
+
+    for (const auto &entry : fs::directory_iterator(sysfs_root + "/cpu", ec))
+    {
+        std::string name = entry.path().filename().string();
+        if (!is_numbered_entry(name, "cpu"))
+            continue;
+
+        CpuPlacement cpu;
+        cpu.cpu_id = std::stoi(name.substr(3));
+        std::string topology = entry.path().string() + "/topology";
+        cpu.package_id = read_int(topology + "/physical_package_id", 0);
+        cpu.core_id = read_int(topology + "/core_id", cpu.cpu_id);
+        this->cpus.push_back(cpu);
+    }
+    std::sort(this->cpus.begin(), this->cpus.end(),
+              [](const CpuPlacement &a, const CpuPlacement &b) { return a.cpu_id < b.cpu_id; });
+
+    // Kernels without NUMA support have no node directory: everything is node 0
+    std::vector<int> node_ids;
+    for (const auto &entry : fs::directory_iterator(sysfs_root + "/node", ec))
+    {
+        std::string name = entry.path().filename().string();
+        if (is_numbered_entry(name, "node"))
+            node_ids.push_back(std::stoi(name.substr(4)));
+    }
+    std::sort(node_ids.begin(), node_ids.end());
+
+    for (int node_id : node_ids)
+    {
+        std::string node_path = sysfs_root + "/node/node" + std::to_string(node_id);
+        ProcFile cpulist(node_path + "/cpulist", 256);
+        for (int cpu_id : parse_cpu_list(cpulist.read()))
+        {
+            for (auto &cpu : this->cpus)
+            {
+                if (cpu.cpu_id == cpu_id)
+                    cpu.node_id = node_id;
+            }
+        }
+
+        this->node_meminfo_files.emplace_back(node_path + "/meminfo", 4096);
+        NodeMemory memory;
+        memory.node_id = node_id;
+        this->node_memory.push_back(memory);
+    }
+
+    this->build_groups();
+    this->update_node_memory();
+}
+
+void CpuTopology::build_groups()
+{
+    // Ordered maps keep the groups sorted by socket / node / (socket, core)
+    std::map<int, TopologyGroup> sockets;
+    std::map<int, TopologyGroup> nodes;
+    std::map<std::pair<int, int>, TopologyGroup> cores;
+
+    for (const auto &cpu : this->cpus)
+    {
+        TopologyGroup &socket = sockets[cpu.package_id];
+        socket.id = cpu.package_id;
+        socket.label = "Socket " + std::to_string(cpu.package_id);
+        socket.cpu_ids.push_back(cpu.cpu_id);
+
+        TopologyGroup &node = nodes[cpu.node_id];
+        node.id = cpu.node_id;
+        node.label = "Node " + std::to_string(cpu.node_id);
+        node.cpu_ids.push_back(cpu.cpu_id);
+
+        TopologyGroup &core = cores[{cpu.package_id, cpu.core_id}];
+        core.id = cpu.core_id;
+        core.label = "Core " + std::to_string(cpu.package_id) + "/" + std::to_string(cpu.core_id);
+        core.cpu_ids.push_back(cpu.cpu_id);
+    }
+
+    for (auto &[id, group] : sockets)
+        this->socket_groups.push_back(std::move(group));
+    for (auto &[id, group] : nodes)
+        this->node_groups.push_back(std::move(group));
+    for (auto &[id, group] : cores)
+        this->core_groups.push_back(std::move(group));
+}
+
+void CpuTopology::update_node_memory()
+{
+    for (size_t i = 0; i < this->node_meminfo_files.size(); i++)
+    {
+        NodeMemory &memory = this->node_memory[i];
+        std::string_view contents = this->node_meminfo_files[i].read();
+        if (contents.empty())
+            continue;
+
+        // Lines look like "Node 0 MemTotal:       16310000 kB"
+        std::string prefix = "Node " + std::to_string(memory.node_id) + " ";
+        uint64_t total_kb = 0;
+        uint64_t free_kb = 0;
+        parse_u64(find_field(contents, prefix + "MemTotal:"), total_kb);
+        parse_u64(find_field(contents, prefix + "MemFree:"), free_kb);
+
+        memory.total_mb = total_kb / 1000.0;
+        memory.free_mb = free_kb / 1000.0;
+        memory.used_mb = memory.total_mb - memory.free_mb;
+    }
+}
+
+std::vector<TopologyGroup> CpuTopology::aggregate(TopologyLevel level, const std::vector<double> &utilization_by_cpu) const
+{
+    std::vector<TopologyGroup> groups;
+    switch (level)
+    {
+    case TopologyLevel::SOCKET:
+        groups = this->socket_groups;
+        break;
+    case TopologyLevel::NODE:
+        groups = this->node_groups;
+        break;
+    case TopologyLevel::CORE:
+        groups = this->core_groups;
+        break;
+    case TopologyLevel::THREAD:
+        for (const auto &cpu : this->cpus)
+        {
+            TopologyGroup thread;
+            thread.id = cpu.cpu_id;
+            thread.label = "CPU" + std::to_string(cpu.cpu_id);
+            thread.cpu_ids.push_back(cpu.cpu_id);
+            groups.push_back(thread);
+        }
+        break;
+    }
+
+    for (auto &group : groups)
+    {
+        double sum = 0.0;
+        int samples = 0;
+        for (int cpu_id : group.cpu_ids)
+        {
+            if (cpu_id < 0 || cpu_id >= static_cast<int>(utilization_by_cpu.size()))
+                continue;
+            if (utilization_by_cpu[cpu_id] < 0.0)
+                continue;
+            sum += utilization_by_cpu[cpu_id];
+            samples++;
+        }
+        group.utilization = samples > 0 ? sum / samples : 0.0;
+    }
+    return groups;
+}
@@ -0,0 +1,93 @@
+#ifndef __CPU_TOPOLOGY_HPP
+#define __CPU_TOPOLOGY_HPP
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include "../proc_io/proc_file.hpp"
+
+enum class TopologyLevel
+{
+    THREAD,
+    CORE,
+    NODE,
+    SOCKET
+};
+
+// Where one logical CPU sits in the machine
+struct CpuPlacement
+{
+    int cpu_id = 0;
+    int package_id = 0;
+    int core_id = 0;
+    int node_id = 0;
+};
+
+// A set of logical CPUs that share a socket, NUMA node or physical core
+struct TopologyGroup
+{
+    std::string label;
+    int id = 0;
+    std::vector<int> cpu_ids;
+    double utilization = 0.0;
+};
+
+struct NodeMemory
+{
+    int node_id = 0;
+    double total_mb = 0.0;
+    double free_mb = 0.0;
+    double used_mb = 0.0;
+};
+
+// Parses a kernel cpulist such as "0-3,8,10-11" into individual ids
+std::vector<int> parse_cpu_list(std::string_view list);
+
+// Socket / NUMA node / SMT layout read once from sysfs. Utilization is
+// aggregated from per-CPU values on demand; per-node memory is refreshed
+// through node meminfo files kept open between ticks.
+class CpuTopology
+{
+private:
+    std::vector<CpuPlacement> cpus;
+    std::vector<TopologyGroup> core_groups;
+    std::vector<TopologyGroup> node_groups;
+    std::vector<TopologyGroup> socket_groups;
+    std::vector<ProcFile> node_meminfo_files;
+    std::vector<NodeMemory> node_memory;
+
+    void build_groups();
+
+public:
+    explicit CpuTopology(const std::string &sysfs_root = "/sys/devices/system");
+
+    void update_node_memory();
+
+    // Average utilization per group at the given level. utilization_by_cpu is
+    // indexed by CPU id; ids beyond its size or with negative values (no sample
+    // yet) are skipped.
+    std::vector<TopologyGroup> aggregate(TopologyLevel level, const std::vector<double> &utilization_by_cpu) const;
+
+    const std::vector<CpuPlacement> &get_cpus() const
+    {
+        return this->cpus;
+    }
+    const std::vector<NodeMemory> &get_node_memory() const
+    {
+        return this->node_memory;
+    }
+    size_t get_socket_count() const
+    {
+        return this->socket_groups.size();
+    }
+    size_t get_node_count() const
+    {
+        return this->node_groups.size();
+    }
+    size_t get_core_count() const
+    {
+        return this->core_groups.size();
+    }
+};
+
+#endif /* __CPU_TOPOLOGY_HPP */
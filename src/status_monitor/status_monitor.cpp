@@ -1,4 +1,5 @@
 #include "status_monitor.hpp"
+#include "../metrics/self_monitor.hpp"
 #include <fstream>
 #include <string>
 #include <sys/sysinfo.h>
@@ -14,6 +15,8 @@
 #include <thread>
 #include <unordered_map>
 #include <algorithm>
+#include <charconv>
+#include <sched.h>
 
 // Trims leading and trailing whitespace from a string
 std::string trim(const std::string &str)
@@ -123,17 +126,7 @@ StatusMonitor::StatusMonitor()
     this->network_adapters = std::vector<ifaddrs *>{};
     this->pci_database_loaded = false;
     this->hardware_resources = std::vector<std::string>{};
-    this->determine_hardware_resources();
-
-    int logical_cores = std::thread::hardware_concurrency();
-    this->cpu_logical_core_count = logical_cores;
-    this->logical_core_utilizations.resize(logical_cores);
-
-    for (int i = 0; i < logical_core_utilizations.size(); i++)
-    {
-        logical_core_utilizations[i] = new double;
-    }
-
+    this->refresh_core_set();
     this->update();
 }
 
@@ -157,37 +150,53 @@ StatusMonitor::~StatusMonitor()
 
 void StatusMonitor::update()
 {
-    this->hardware_resources.clear();
-    this->determine_hardware_resources();
+    this->update_hardware();
+    this->update_cpu();
+    this->update_system();
+}
+
+bool StatusMonitor::update_cpu()
+{
+    bool cores_changed = this->refresh_core_set();
+    if (cores_changed)
+    {
+        std::lock_guard<std::mutex> lock(this->core_frequencies_mutex);
+        this->cpu_frequency_monitor.rescan();
+    }
     this->compute_cpu_utilization();
+    return cores_changed;
+}
+
+void StatusMonitor::update_system()
+{
     this->compute_process_and_thread_counts();
     this->compute_max_cpu_clock_speeds();
     this->update_memory_info();
 }
 
+void StatusMonitor::update_hardware()
+{
+    StageTimer timer(Stage::HARDWARE);
+    this->hardware_resources.clear();
+    this->determine_hardware_resources();
+}
+
 std::string StatusMonitor::get_cpu_model()
 {
-    std::ifstream f("/proc/cpuinfo");
-    std::string line;
-    while (std::getline(f, line))
-    {
-        if (line.rfind("model name", 0) == 0)
-        {
-            auto pos = line.find(':');
-            if (pos != std::string::npos)
-                return line.substr(pos + 2);
-        }
-    }
-    return "Unknown CPU";
+    // The model never changes, and /proc/cpuinfo is large on big machines, so
+    // it is only parsed until the first successful lookup.
+    if (!this->cpu_model.empty())
+        return this->cpu_model;
+
+    ProcFile cpuinfo("/proc/cpuinfo", 65536);
+    std::string_view model = find_field(cpuinfo.read(), "model name");
+    this->cpu_model = model.empty() ? "Unknown CPU" : std::string(model);
+    return this->cpu_model;
 }
 
 std::string StatusMonitor::read_file(const std::string &path)
 {
-    std::ifstream f(path);
-    if (!f)
-        return "";
-    return std::string((std::istreambuf_iterator<char>(f)),
-                       std::istreambuf_iterator<char>());
+    return std::string(this->sysfs_files.read(path));
 }
 
 std::string StatusMonitor::get_gpu_model()
@@ -384,136 +393,195 @@ double calculate_utilization(const CpuTime &prev_times, const CpuTime &current_t
     return utilization;
 }
 
-void StatusMonitor::compute_cpu_utilization()
+// Parses the "cpu" and "cpuN" lines at the top of /proc/stat. The aggregate
+// line is stored under id -1; offline CPUs have no line at all.
+static void parse_cpu_times(std::string_view contents, std::unordered_map<int, CpuTime> &cpu_data)
 {
-    std::unordered_map<std::string, CpuTime> cpu_data_1;
-    std::ifstream file("/proc/stat");
-    std::string line;
-
-    if (!file.is_open())
-    {
-        std::cerr << "Error: Could not open /proc/stat" << std::endl;
-    }
-
-    // Read the file line by line
-    while (std::getline(file, line))
+    size_t pos = 0;
+    while (pos < contents.size())
     {
-        std::stringstream ss(line);
-        std::string cpu_label;
-        ss >> cpu_label;
+        size_t end = contents.find('\n', pos);
+        if (end == std::string_view::npos)
+            end = contents.size();
+        std::string_view line = contents.substr(pos, end - pos);
+        pos = end + 1;
+
+        // The cpu lines come first; stop reading once they are done to save time
+        if (!line.starts_with("cpu"))
+            break;
 
-        // Check if the line starts with "cpu" (total) or "cpuN" (individual core)
-        if (cpu_label.rfind("cpu", 0) == 0)
+        size_t label_end = line.find(' ');
+        if (label_end == std::string_view::npos)
+            continue;
+        std::string_view cpu_label = line.substr(0, label_end);
+        int cpu_id = -1;
+        if (cpu_label.length() > 3)
         {
-            if (cpu_label.length() > 3 && !isdigit(cpu_label[3]))
+            if (!isdigit(cpu_label[3]))
             {
                 // Ignore non-standard cpu labels like cpuidle, cpusets etc if they exist
                 continue;
             }
+            std::from_chars(cpu_label.data() + 3, cpu_label.data() + cpu_label.size(), cpu_id);
+        }
 
-            CpuTime times;
-            // Extract Jiffy values
-            ss >> times.user >> times.nice >> times.system >> times.idle >> times.iowait >> times.irq >> times.softirq >> times.steal >> times.guest >> times.guest_nice;
+        // Extract Jiffy values
+        CpuTime times;
+        long long *fields[] = {&times.user, &times.nice, &times.system, &times.idle, &times.iowait,
+                               &times.irq, &times.softirq, &times.steal, &times.guest, &times.guest_nice};
+        const char *cursor = line.data() + label_end;
+        const char *line_end = line.data() + line.size();
+        for (long long *field : fields)
+        {
+            while (cursor < line_end && *cursor == ' ')
+                cursor++;
+            auto result = std::from_chars(cursor, line_end, *field);
+            if (result.ec != std::errc())
+                break;
+            cursor = result.ptr;
+        }
+
+        cpu_data[cpu_id] = times;
+    }
+}
+
+// Returns true when the set of tracked CPUs changed (hotplug or cpuset change)
+bool StatusMonitor::refresh_core_set()
+{
+    std::vector<int> cpu_ids = parse_cpu_list(this->cpu_online.read());
+    if (cpu_ids.empty())
+    {
+        // No sysfs (unusual container setups): fall back to the affinity-free count
+        for (int i = 0; i < static_cast<int>(std::thread::hardware_concurrency()); i++)
+            cpu_ids.push_back(i);
+    }
 
-            cpu_data_1[cpu_label] = times;
+    if (this->cpuset_only.load())
+    {
+        // The affinity mask reflects both the cgroup cpuset and taskset
+        cpu_set_t allowed;
+        CPU_ZERO(&allowed);
+        if (sched_getaffinity(0, sizeof(allowed), &allowed) == 0)
+        {
+            std::erase_if(cpu_ids, [&allowed](int cpu_id)
+                          { return cpu_id >= CPU_SETSIZE || !CPU_ISSET(cpu_id, &allowed); });
         }
-        // Stop reading after all "cpu" lines are processed to save time
-        if (cpu_label.rfind("cpu", 0) != 0 && !cpu_data_1.empty())
+    }
+
+    std::lock_guard<std::mutex> lock(this->core_metrics_mutex);
+    bool unchanged = cpu_ids.size() == this->core_metrics.size() &&
+                     std::equal(cpu_ids.begin(), cpu_ids.end(), this->core_metrics.begin(),
+                                [](int cpu_id, const CoreMetrics &core) { return cpu_id == core.cpu_id; });
+    if (unchanged)
+        return false;
+
+    // Keep the samples of CPUs that stay so their utilization doesn't reset
+    std::vector<CoreMetrics> resized;
+    resized.reserve(cpu_ids.size());
+    for (int cpu_id : cpu_ids)
+    {
+        auto it = std::find_if(this->core_metrics.begin(), this->core_metrics.end(),
+                               [cpu_id](const CoreMetrics &core) { return core.cpu_id == cpu_id; });
+        if (it != this->core_metrics.end())
         {
-            break;
+            resized.push_back(*it);
+        }
+        else
+        {
+            CoreMetrics core;
+            core.cpu_id = cpu_id;
+            resized.push_back(core);
         }
     }
 
-    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    this->core_metrics = std::move(resized);
+    this->cpu_logical_core_count = this->core_metrics.size();
+    return true;
+}
 
-    std::unordered_map<std::string, CpuTime> cpu_data_2;
-    file.close();
-    file.open("/proc/stat");
+void StatusMonitor::compute_cpu_utilization()
+{
+    StageTimer timer(Stage::CPU_UTILIZATION);
+    std::unordered_map<int, CpuTime> cpu_data;
+    std::string_view contents = this->proc_stat.read();
 
-    if (!file.is_open())
+    if (contents.empty())
     {
-        std::cerr << "Error: Could not open /proc/stat" << std::endl;
+        std::cerr << "Error: Could not read /proc/stat" << std::endl;
         return;
     }
 
-    // Read the file line by line again
-    // Read the file line by line
-    while (std::getline(file, line))
+    if (!this->has_last_total_times)
     {
-        std::stringstream ss(line);
-        std::string cpu_label;
-        ss >> cpu_label;
-
-        // Check if the line starts with "cpu" (total) or "cpuN" (individual core)
-        if (cpu_label.rfind("cpu", 0) == 0)
+        // First tick: there is no previous sample yet, so take a short baseline.
+        // Every later tick measures against the previous tick instead of sleeping.
+        parse_cpu_times(contents, cpu_data);
         {
-            if (cpu_label.length() > 3 && !isdigit(cpu_label[3]))
+            std::lock_guard<std::mutex> lock(this->core_metrics_mutex);
+            for (auto &core : this->core_metrics)
             {
-                // Ignore non-standard cpu labels like cpuidle, cpusets etc if they exist
-                continue;
+                auto it = cpu_data.find(core.cpu_id);
+                if (it == cpu_data.end())
+                    continue;
+                core.last_times = it->second;
+                core.has_last_times = true;
             }
-
-            CpuTime times;
-            // Extract Jiffy values
-            ss >> times.user >> times.nice >> times.system >> times.idle >> times.iowait >> times.irq >> times.softirq >> times.steal >> times.guest >> times.guest_nice;
-
-            cpu_data_2[cpu_label] = times;
-        }
-        // Stop reading after all "cpu" lines are processed to save time
-        if (cpu_label.rfind("cpu", 0) != 0 && !cpu_data_2.empty())
-        {
-            break;
         }
+        this->last_total_times = cpu_data[-1];
+        this->has_last_total_times = true;
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        cpu_data.clear();
+        contents = this->proc_stat.read();
     }
+    parse_cpu_times(contents, cpu_data);
 
     // Calculate overall CPU utilization
-    this->overall_cpu_utilization_percent = calculate_utilization(cpu_data_1["cpu"], cpu_data_2["cpu"]);
+    this->overall_cpu_utilization_percent = calculate_utilization(this->last_total_times, cpu_data[-1]);
+    this->last_total_times = cpu_data[-1];
+
     // Calculate per-core utilizations
-    for (int i = 0; i < this->cpu_logical_core_count; ++i)
+    std::vector<double> utilization_by_cpu;
     {
-        std::string core_label = "cpu" + std::to_string(i);
-        *this->logical_core_utilizations[i] = calculate_utilization(cpu_data_1[core_label], cpu_data_2[core_label]);
+        std::lock_guard<std::mutex> lock(this->core_metrics_mutex);
+        for (auto &core : this->core_metrics)
+        {
+            if (core.cpu_id >= static_cast<int>(utilization_by_cpu.size()))
+                utilization_by_cpu.resize(core.cpu_id + 1, -1.0);
+
+            auto it = cpu_data.find(core.cpu_id);
+            if (it == cpu_data.end())
+            {
+                // Went offline between the online read and /proc/stat
+                core.utilization = -1.0;
+                core.has_last_times = false;
+                continue;
+            }
+
+            core.utilization = core.has_last_times ? calculate_utilization(core.last_times, it->second) : -1.0;
+            core.last_times = it->second;
+            core.has_last_times = true;
+            utilization_by_cpu[core.cpu_id] = core.utilization;
+        }
     }
+    this->core_history.push(utilization_by_cpu);
 }
 
 void StatusMonitor::compute_process_and_thread_counts()
 {
+    StageTimer timer(Stage::PROCESS_COUNT);
     this->process_count = 0;
     std::string proc_path = "/proc";
 
-    for (const auto &entry : std::filesystem::directory_iterator(proc_path))
+    // Every numeric directory is a live process; opening each /proc/<PID>/status
+    // just to confirm that cost one open/read/close per process per tick.
+    std::error_code ec;
+    for (const auto &entry : std::filesystem::directory_iterator(proc_path, ec))
     {
-        if (entry.is_directory())
+        std::string dir_name = entry.path().filename().string();
+        if (!dir_name.empty() && std::all_of(dir_name.begin(), dir_name.end(), ::isdigit))
         {
-            std::string dir_name = entry.path().filename().string();
-            // Check if the directory name is a number (PID)
-            if (std::all_of(dir_name.begin(), dir_name.end(), ::isdigit))
-            {
-                // This is a process directory
-                int pid = std::stoi(dir_name);
-
-                // Optionally, read /proc/<PID>/status to check process state
-                std::string status_file_path = proc_path + "/" + dir_name + "/status";
-                std::ifstream status_file(status_file_path);
-                if (status_file.is_open())
-                {
-                    std::string line;
-                    while (std::getline(status_file, line))
-                    {
-                        if (line.rfind("State:", 0) == 0)
-                        { // Check if line starts with "State:"
-                            // Extract state (e.g., "S (sleeping)", "R (running)")
-                            // You can parse this to count only specific states if needed
-                            // For a simple count of "running" processes (not zombies/stopped),
-                            // you can check for 'R' or 'S' (running/sleeping)
-                            // A more robust check would involve parsing the full state string.
-                            this->process_count++;
-                            break; // Move to next process after finding state
-                        }
-                    }
-                    status_file.close();
-                }
-            }
+            this->process_count++;
         }
     }
 
@@ -523,29 +591,15 @@ void StatusMonitor::compute_process_and_thread_counts()
 
 void StatusMonitor::compute_max_cpu_clock_speeds()
 {
-    std::ifstream f("/proc/cpuinfo");
-    std::string line;
-    std::vector<double> mhz;
-
-    while (std::getline(f, line))
-    {
-        if (line.find("cpu MHz") != std::string::npos)
-        {
-            double val;
-            if (sscanf(line.c_str(), "cpu MHz\t: %lf", &val) == 1)
-                mhz.push_back(val);
-        }
-    }
-
-    if (!mhz.empty())
-    {
-        this->cpu_logical_core_count = mhz.size();
-        this->cpu_max_clock_speed_mhz = *std::max_element(mhz.begin(), mhz.end());
-    }
+    StageTimer timer(Stage::CPU_CLOCK_SPEED);
+    std::lock_guard<std::mutex> lock(this->core_frequencies_mutex);
+    this->cpu_frequency_monitor.update();
+    this->cpu_max_clock_speed_mhz = this->cpu_frequency_monitor.get_max_current_mhz();
 }
 
 void StatusMonitor::update_memory_info()
 {
+    StageTimer timer(Stage::MEMORY_INFO);
     struct sysinfo memory_info;
 
     if (!sysinfo(&memory_info))
@@ -559,10 +613,8 @@ void StatusMonitor::update_memory_info()
         this->memory_swap_used_mb = (memory_info.totalswap - memory_info.freeswap) / (1000.0 * 1000.0);
 
         // Update history
-        this->memory_used_history.push_back(this->memory_used_mb);
-        if (this->memory_used_history.size() > 60) // Keep last 60 entries
-        {
-            this->memory_used_history.erase(this->memory_used_history.begin());
-        }
+        this->memory_used_history.push(this->memory_used_mb);
     }
+
+    this->cpu_topology.update_node_memory();
 }
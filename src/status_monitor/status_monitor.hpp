@@ -7,8 +7,15 @@
 #include <netinet/in.h>
 #include <vector>
 #include <string>
+#include <atomic>
 #include <map>
+#include <mutex>
 #include <thread>
+#include "cpu_frequency.hpp"
+#include "cpu_topology.hpp"
+#include "../proc_io/proc_file.hpp"
+#include "../metrics/time_series.hpp"
+#include "../metrics/core_history.hpp"
 
 // A map to store the device names associated with a vendor
 using DeviceMap = std::map<std::string, std::string>;
@@ -49,6 +56,15 @@ struct CpuTime
     }
 };
 
+// Per logical CPU metrics, keyed by the kernel's CPU id
+struct CoreMetrics
+{
+    int cpu_id = 0;
+    double utilization = -1.0; // Negative until two samples have been taken
+    CpuTime last_times;
+    bool has_last_times = false;
+};
+
 class StatusMonitor
 {
 private:
@@ -60,12 +76,31 @@ private:
     int cpu_logical_core_count = 0;
     int process_count = 0;
     int thread_count = 0;
-    std::vector<double *> logical_core_utilizations;
+
+    // One contiguous entry per tracked CPU, sorted by cpu_id. Rebuilt when the
+    // online set (hotplug) or the allowed cpuset changes; guarded by
+    // core_metrics_mutex because the UI reads it while update() runs.
+    std::vector<CoreMetrics> core_metrics;
+    mutable std::mutex core_metrics_mutex;
+    CpuTime last_total_times;
+    bool has_last_total_times = false;
+    std::atomic<bool> cpuset_only{false}; // Set by the UI, read by the CPU collector
+    ProcFile cpu_online{"/sys/devices/system/cpu/online", 256};
+    // rescan() and update() rebuild and refill the per-core list while the UI reads it
+    CpuFrequencyMonitor cpu_frequency_monitor;
+    mutable std::mutex core_frequencies_mutex;
+    CpuTopology cpu_topology;
+    CoreHistory core_history;
+    std::string cpu_model;
+
+    // Hot system files kept open across ticks
+    ProcFile proc_stat{"/proc/stat", 16384};
+    ProcFileCache sysfs_files{256};
 
     PciIdDatabase pci_id_database;
     bool pci_database_loaded = false;
 
-    std::vector<double> memory_used_history;
+    TimeSeries<double> memory_used_history;
     double memory_total_mb = 0.0;
     double memory_used_mb = 0.0;
     double memory_free_mb = 0.0;
@@ -86,6 +121,7 @@ private:
     std::string read_file(const std::string &path);
     void determine_hardware_resources();
 
+    bool refresh_core_set();
     void compute_cpu_utilization();
     void compute_process_and_thread_counts();
     void compute_max_cpu_clock_speeds();
@@ -95,6 +131,13 @@ public:
     StatusMonitor(/* args */);
     ~StatusMonitor();
     void update();
+
+    // The pieces of update(), so collectors can run them at their own rates.
+    // update_cpu() returns true when the set of tracked CPUs changed.
+    bool update_cpu();
+    void update_system();
+    void update_hardware();
+
     std::vector<std::string> *get_hardware_resources()
     {
         return &this->hardware_resources;
@@ -104,17 +147,39 @@ public:
     {
         return &this->overall_cpu_utilization_percent;
     }
-    const std::vector<double *> &get_logical_core_utilizations()
+    // Copy of the per-core metrics, safe to use while update() runs
+    std::vector<CoreMetrics> get_core_metrics() const
+    {
+        std::lock_guard<std::mutex> lock(this->core_metrics_mutex);
+        return this->core_metrics;
+    }
+    // When set, only CPUs in Houston's own cpuset / affinity mask are tracked
+    std::atomic<bool> *get_cpuset_only()
+    {
+        return &this->cpuset_only;
+    }
+    const CpuTopology *get_cpu_topology()
     {
-        return this->logical_core_utilizations;
+        return &this->cpu_topology;
+    }
+    // Per-core utilization over time, one column per CPU tick
+    const CoreHistory *get_core_history()
+    {
+        return &this->core_history;
     }
     double *get_cpu_max_clock_speed_mhz()
     {
         return &this->cpu_max_clock_speed_mhz;
     }
-    int get_cpu_logical_core_count()
+    // Copy of the per-core clock speeds, safe to use while a collector updates them
+    std::vector<CoreFrequency> get_core_frequencies() const
+    {
+        std::lock_guard<std::mutex> lock(this->core_frequencies_mutex);
+        return *this->cpu_frequency_monitor.get_cores();
+    }
+    int *get_cpu_logical_core_count()
     {
-        return this->cpu_logical_core_count;
+        return &this->cpu_logical_core_count;
     }
     int *get_cpu_process_count()
     {
@@ -153,7 +218,7 @@ public:
     {
         return &this->memory_swap_used_mb;
     };
-    std::vector<double> *get_history_memory_used_mb()
+    TimeSeries<double> *get_history_memory_used_mb()
     {
         return &this->memory_used_history;
     };
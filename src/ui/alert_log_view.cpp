@@ -0,0 +1,67 @@
+#include "alert_log_view.hpp"
+#include <ctime>
+#include <string>
+
+// Rows shown by the overlay; older alerts stay in the log but off screen
+static constexpr size_t MAX_LOG_ROWS = 30;
+
+static std::string format_clock(std::chrono::system_clock::time_point time)
+{
+    std::time_t seconds = std::chrono::system_clock::to_time_t(time);
+    std::tm local{};
+    localtime_r(&seconds, &local);
+    char s[16];
+    std::strftime(s, sizeof(s), "%H:%M:%S", &local);
+    return s;
+}
+
+static Color kind_color(AnomalyKind kind)
+{
+    switch (kind)
+    {
+    case AnomalyKind::SATURATION:
+        return Color::Red;
+    case AnomalyKind::HEAVY_HITTER:
+        return Color::Magenta;
+    default:
+        return Color::Yellow;
+    }
+}
+
+Element create_alert_status_bar(const AnomalyDetector &detector)
+{
+    AnomalyAlert latest;
+    if (!detector.get_latest_alert(latest))
+        return text("No anomalies  F3: alert log") | dim;
+
+    uint64_t total = detector.get_total_alerts();
+    std::string count = std::to_string(total) + (total == 1 ? " anomaly" : " anomalies");
+    return hbox({
+        text(count + "  ") | bold,
+        text(format_clock(latest.time) + " " + describe_anomaly(latest)) | color(kind_color(latest.kind)),
+        filler(),
+        text("  F3: alert log") | dim,
+    });
+}
+
+Element create_alert_log_overlay(const std::vector<AnomalyAlert> &alerts)
+{
+    Elements rows;
+    if (alerts.empty())
+        rows.push_back(text("No anomalies detected yet") | dim);
+
+    size_t shown = 0;
+    for (auto it = alerts.rbegin(); it != alerts.rend() && shown < MAX_LOG_ROWS; ++it, ++shown)
+    {
+        rows.push_back(hbox({
+            text(format_clock(it->time) + "  ") | dim,
+            text(describe_anomaly(*it)) | color(kind_color(it->kind)),
+        }));
+    }
+    if (alerts.size() > shown)
+        rows.push_back(text("... " + std::to_string(alerts.size() - shown) + " older") | dim);
+
+    rows.push_back(separator());
+    rows.push_back(text("F4: clear  F3: close") | dim);
+    return window(text(" Anomaly alerts (F3) "), vbox(rows));
+}
@@ -0,0 +1,16 @@
+#ifndef __ALERT_LOG_VIEW_HPP
+#define __ALERT_LOG_VIEW_HPP
+
+#include "ftxui/dom/elements.hpp"
+#include "../metrics/anomaly_detector.hpp"
+#include <vector>
+
+using namespace ftxui;
+
+// One line under the tabs: how many anomalies have been raised and the newest one
+Element create_alert_status_bar(const AnomalyDetector &detector);
+
+// The logged alerts, newest first, as an overlay toggled with F3
+Element create_alert_log_overlay(const std::vector<AnomalyAlert> &alerts);
+
+#endif /* __ALERT_LOG_VIEW_HPP */
@@ -0,0 +1,124 @@
+#include "frame_pacer.hpp"
+#include <algorithm>
+
+FramePacer::FramePacer(std::function<void()> request_redraw, int max_fps)
+    : frame_interval(std::chrono::microseconds(1000000 / std::max(1, max_fps))),
+      request_redraw(std::move(request_redraw))
+{
+}
+
+FramePacer::~FramePacer()
+{
+    this->stop();
+}
+
+void FramePacer::start()
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    if (this->running)
+        return;
+    this->running = true;
+    this->worker = std::thread([this]
+                               { this->run_loop(); });
+}
+
+void FramePacer::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        if (!this->running)
+            return;
+        this->running = false;
+    }
+    this->wake.notify_all();
+    if (this->worker.joinable())
+        this->worker.join();
+}
+
+// Asks the worker for one redraw at the next frame boundary. Must hold the mutex.
+void FramePacer::request_redraw_locked()
+{
+    if (this->redraw_pending)
+        return;
+    this->redraw_pending = true;
+    this->wake.notify_all();
+}
+
+void FramePacer::run_loop()
+{
+    std::unique_lock<std::mutex> lock(this->mutex);
+    while (this->running)
+    {
+        this->wake.wait(lock, [this]
+                        { return !this->running || this->redraw_pending; });
+        if (!this->running)
+            break;
+
+        // Hold the request until the frame budget allows a new frame, so a
+        // burst of invalidations turns into a single redraw
+        auto next_frame = this->last_frame_start + this->frame_interval;
+        this->wake.wait_until(lock, next_frame, [this]
+                              { return !this->running; });
+        if (!this->running)
+            break;
+
+        this->redraw_pending = false;
+        lock.unlock();
+        if (this->request_redraw)
+            this->request_redraw();
+        lock.lock();
+    }
+}
+
+void FramePacer::invalidate()
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->dirty = true;
+    this->request_redraw_locked();
+}
+
+void FramePacer::mark_dirty()
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->dirty = true;
+}
+
+bool FramePacer::begin_frame()
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    if (!this->dirty)
+    {
+        this->stats.reused_frames++;
+        return false;
+    }
+
+    auto now = Clock::now();
+    if (now - this->last_frame_start < this->frame_interval)
+    {
+        this->stats.dropped_frames++;
+        this->request_redraw_locked();
+        return false;
+    }
+
+    this->dirty = false;
+    this->last_frame_start = now;
+    return true;
+}
+
+void FramePacer::end_frame()
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    auto frame_time = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - this->last_frame_start);
+    this->stats.frames++;
+    this->stats.last_frame_time = frame_time;
+    this->stats.max_frame_time = std::max(this->stats.max_frame_time, frame_time);
+    this->stats.total_frame_time += frame_time;
+    if (frame_time > this->frame_interval)
+        this->stats.late_frames++;
+}
+
+FrameStats FramePacer::get_stats() const
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return this->stats;
+}
@@ -0,0 +1,84 @@
+#ifndef __FRAME_PACER_HPP
+#define __FRAME_PACER_HPP
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+// Frame timing as measured by the FramePacer
+struct FrameStats
+{
+    uint64_t frames = 0;         // Frames actually built
+    uint64_t reused_frames = 0;  // Redraws with nothing changed, served from the last frame
+    uint64_t dropped_frames = 0; // Redraws that came too soon and were folded into a later frame
+    uint64_t late_frames = 0;    // Frames that took longer than the frame budget to build
+    std::chrono::microseconds last_frame_time{0};
+    std::chrono::microseconds max_frame_time{0};
+    std::chrono::microseconds total_frame_time{0};
+
+    std::chrono::microseconds average_frame_time() const
+    {
+        return this->frames == 0 ? std::chrono::microseconds(0) : this->total_frame_time / static_cast<std::chrono::microseconds::rep>(this->frames);
+    }
+};
+
+// Decouples how often the UI is rebuilt from how often data and input arrive.
+// Changes only mark the UI dirty; a frame is built when something is dirty
+// and at least one frame interval has passed since the previous one. Redraws
+// that come sooner reuse the previous frame, and a single deferred redraw is
+// requested for the end of the interval so the last change still shows up.
+class FramePacer
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+private:
+    std::chrono::microseconds frame_interval;
+    std::function<void()> request_redraw;
+
+    mutable std::mutex mutex;
+    std::condition_variable wake;
+    std::thread worker;
+    bool running = false;
+
+    bool dirty = true;
+    bool redraw_pending = false;
+    Clock::time_point last_frame_start;
+    FrameStats stats;
+
+    void run_loop();
+    void request_redraw_locked();
+
+public:
+    // request_redraw is called from the pacer's thread and must be safe to
+    // call from any thread (e.g. posting an event to the screen).
+    FramePacer(std::function<void()> request_redraw, int max_fps = 30);
+    ~FramePacer();
+    FramePacer(const FramePacer &) = delete;
+    FramePacer &operator=(const FramePacer &) = delete;
+
+    void start();
+    void stop();
+
+    // Something the UI shows changed on another thread; a redraw is requested
+    void invalidate();
+    // The UI thread changed view state and is about to redraw anyway
+    void mark_dirty();
+
+    // Called at the start of a redraw. Returns true if a new frame should be
+    // built, false if the previous frame should be shown again.
+    bool begin_frame();
+    // Called once the frame begin_frame allowed has been built
+    void end_frame();
+
+    std::chrono::microseconds get_frame_interval() const
+    {
+        return this->frame_interval;
+    }
+    FrameStats get_stats() const;
+};
+
+#endif /* __FRAME_PACER_HPP */
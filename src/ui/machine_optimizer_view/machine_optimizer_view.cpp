@@ -7,39 +7,41 @@
 #include <signal.h>
 #include <utility>
 #include <memory>
+#include <optional>
 
 using namespace ftxui;
 
 Component create_machine_optimizer_view(
     std::vector<Process>& processes,
-    std::mutex& processes_mutex
+    std::mutex& processes_mutex,
+    std::shared_ptr<OptimizerBackend> backend
 ) {
-    auto machine_optimizer = std::make_shared<MachineOptimizer>();
-    auto optimize_future = std::make_shared<std::future<std::pair<std::string, pid_t>>>();
+    auto machine_optimizer = std::make_shared<MachineOptimizer>(std::move(backend));
+    auto optimize_future = std::make_shared<std::future<KillRecommendation>>();
     auto optimize_running = std::make_shared<bool>(false);
-    auto optimize_result = std::make_shared<std::string>("");
+    auto optimize_result = std::make_shared<std::optional<KillRecommendation>>();
     auto target_pid = std::make_shared<pid_t>(-1);
     auto process_killed = std::make_shared<bool>(false);
     auto kill_success = std::make_shared<bool>(false);
 
-    auto optimize_button = Button("Optimize resource allocation with artificial intelligence",
+    auto optimize_button = Button("Optimize resource allocation",
                                   [machine_optimizer, optimize_future, optimize_running, optimize_result, target_pid, process_killed, &processes, &processes_mutex]
                                   {
                                       if (!*optimize_running)
                                       {
                                           *optimize_running = true;
-                                          *optimize_result = "";
+                                          optimize_result->reset();
                                           *target_pid = -1;
                                           *process_killed = false;
 
-                                          // Get a snapshot of current processes
-                                          std::vector<Process> processes_snapshot;
+                                          // One copy of the current processes, shared read-only with the backend
+                                          ProcessSnapshot processes_snapshot;
                                           {
                                               std::lock_guard<std::mutex> lock(processes_mutex);
-                                              processes_snapshot = processes;
+                                              processes_snapshot = std::make_shared<const std::vector<Process>>(processes);
                                           }
 
-                                          *optimize_future = machine_optimizer->run_async(processes_snapshot);
+                                          *optimize_future = machine_optimizer->run_async(std::move(processes_snapshot));
                                       }
                                   });
 
@@ -63,63 +65,73 @@ Component create_machine_optimizer_view(
 
     auto optimize_container = Container::Vertical({optimize_button, kill_button});
 
-    auto optimize_renderer = Renderer(optimize_container, [optimize_button, kill_button, optimize_running, optimize_result, optimize_future, target_pid, process_killed, kill_success]
+    auto optimize_renderer = Renderer(optimize_container, [machine_optimizer, optimize_button, kill_button, optimize_running, optimize_result, optimize_future, target_pid, process_killed, kill_success]
                                       {
         // Check if the async operation completed
         if (*optimize_running && optimize_future->valid() &&
             optimize_future->wait_for(std::chrono::milliseconds(0)) == std::future_status::ready)
         {
-            auto result = optimize_future->get();
-            *optimize_result = result.first;
-            *target_pid = result.second;
+            *optimize_result = optimize_future->get();
+            *target_pid = (*optimize_result)->pid;
             *optimize_running = false;
         }
 
-        auto elements = vbox({
+        Elements elements = {
             text("") | center,
             optimize_button->Render() | center,
             text("") | center,
-        });
+        };
 
         if (*optimize_running)
         {
-            elements = vbox({
-                text("") | center,
-                optimize_button->Render() | center,
-                text("") | center,
-                text("AI Optimization Running...") | center | bold | color(Color::Yellow),
-            });
+            elements.push_back(text(machine_optimizer->get_backend_name() + " running...") | center | bold | color(Color::Yellow));
         }
-        else if (!optimize_result->empty())
+        else if (*optimize_result)
         {
-            if (*process_killed)
+            const KillRecommendation& result = **optimize_result;
+            long long micros = result.elapsed.count();
+            std::string took = micros < 10000 ? std::to_string(micros) + " µs" : std::to_string(micros / 1000) + " ms";
+            Element footer = text("Ranked by " + machine_optimizer->get_backend_name() + " in " + took) | dim | center;
+
+            if (!result.error.empty())
+            {
+                elements.push_back(text("Optimization Failed: " + result.error) | center | bold | color(Color::Red));
+                elements.push_back(footer);
+            }
+            else if (result.pid < 0)
             {
-                elements = vbox({
-                    text("") | center,
-                    optimize_button->Render() | center,
-                    text("") | center,
-                    text("Optimization Complete!") | center | bold | color(Color::Green),
-                    text("AI Recommended Process to Kill: " + *optimize_result) | center,
-                    text("") | center,
-                    text(*kill_success ? "✓ Process killed successfully" : "✗ Failed to kill process") |
-                        center | bold | color(*kill_success ? Color::Green : Color::Red),
-                });
+                elements.push_back(text("Nothing is worth killing right now") | center | bold | color(Color::Green));
+                elements.push_back(footer);
             }
             else
             {
-                elements = vbox({
-                    text("") | center,
-                    optimize_button->Render() | center,
-                    text("") | center,
-                    text("Optimization Complete!") | center | bold | color(Color::Green),
-                    text("AI Recommended Process to Kill: " + *optimize_result) | center,
-                    text("") | center,
-                    kill_button->Render() | center,
-                });
+                std::string reasons;
+                for (const auto& reason : result.reasons)
+                {
+                    reasons += (reasons.empty() ? "" : ", ") + reason;
+                }
+
+                elements.push_back(text("Optimization Complete!") | center | bold | color(Color::Green));
+                elements.push_back(text("Recommended Process to Kill: " + result.name + " (PID: " + std::to_string(result.pid) + ")") | center);
+                if (!reasons.empty())
+                {
+                    elements.push_back(text(reasons) | center);
+                }
+                elements.push_back(footer);
+                elements.push_back(text("") | center);
+                if (*process_killed)
+                {
+                    elements.push_back(text(*kill_success ? "✓ Process killed successfully" : "✗ Failed to kill process") |
+                                       center | bold | color(*kill_success ? Color::Green : Color::Red));
+                }
+                else
+                {
+                    elements.push_back(kill_button->Render() | center);
+                }
             }
         }
 
-        return elements;
+        return vbox(std::move(elements));
     });
 
     return optimize_renderer;
@@ -2,6 +2,8 @@
 
 #include "ftxui/component/component_base.hpp"
 #include "../../processes_list/process.hpp"
+#include "../../smart_sparker/machine_opt/optimizer_backend.hpp"
+#include <memory>
 #include <vector>
 #include <mutex>
 
@@ -11,8 +13,10 @@ namespace ftxui {
 
 using ftxui::Component;
 
+// backend picks the kill candidate: the local scorer, or a remote model
 Component create_machine_optimizer_view(
     std::vector<Process>& processes,
-    std::mutex& processes_mutex
+    std::mutex& processes_mutex,
+    std::shared_ptr<OptimizerBackend> backend
 );
 
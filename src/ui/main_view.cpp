@@ -4,27 +4,75 @@
 #include "status_view/cpu_info_view.hpp"
 #include "status_view/mem_info_view.hpp"
 #include "machine_optimizer_view/machine_optimizer_view.hpp"
+#include "../collectors/collector_scheduler.hpp"
+#include "../collectors/system_collectors.hpp"
+#include "frame_pacer.hpp"
+#include "redraw_filter.hpp"
+#include "self_monitor_view.hpp"
+#include "alert_log_view.hpp"
+#include "../processes_list/procfs_processes.hpp"
+#include "../smart_sparker/machine_opt/kill_candidate_scorer.hpp"
+#include "../smart_sparker/machine_opt/gemini_backend.hpp"
 #include <chrono>
-#include <atomic>
-#include <condition_variable>
 
-void start_ui(double refresh_rate_seconds)
+void start_ui(const HoustonConfig &config)
 {
     std::vector<std::string> function_tabs = {"System Status", "Running Processes", "Machine Optimize"};
     int selected_function = 0;
     auto function_select = Toggle(&function_tabs, &selected_function);
 
-    auto processes = get_processes_list();
-    std::mutex processes_mutex;
+    auto screen = ScreenInteractive::Fullscreen();
 
-    auto processes_renderer = create_processes_view(processes, processes_mutex, refresh_rate_seconds);
+    // Data ticks and input only invalidate the UI; frames are built at most
+    // max_fps times a second however fast either arrives
+    FramePacer frame_pacer([&screen]
+                           { screen.PostEvent(Event::Custom); },
+                           config.max_fps);
+
+    std::function<std::vector<Process>()> list_processes;
+    bool track_network = config.collect_network;
+    if (config.backend == ProcessBackend::PROCFS)
+    {
+        auto reader = std::make_shared<ProcfsProcessReader>();
+        list_processes = [reader, track_network]
+        { return reader->read(track_network); };
+    }
+    else
+    {
+        list_processes = [track_network]
+        { return get_processes_list(track_network); };
+    }
+
+    auto processes = list_processes();
+    std::mutex processes_mutex;
+    std::atomic<uint64_t> processes_version{0};
+    auto process_history = std::make_shared<ProcessHistoryStore>(config.history_length);
+    process_history->record(processes);
+    // Always on: every snapshot the collector takes is checked, whichever tab is open
+    AnomalyOptions anomaly_options;
+    anomaly_options.spike_threshold = config.anomaly_threshold;
+    auto anomaly_detector = std::make_shared<AnomalyDetector>(anomaly_options);
+    anomaly_detector->observe(processes);
+
+    auto termination_grace = std::chrono::milliseconds(
+        static_cast<int64_t>(config.termination_grace_seconds * 1000));
+    auto processes_renderer = create_processes_view(processes, processes_mutex, processes_version, process_history,
+                                                    [&frame_pacer]
+                                                    { frame_pacer.invalidate(); },
+                                                    termination_grace);
 
     std::shared_ptr<StatusMonitor> status_monitor = std::make_shared<StatusMonitor>();
     std::vector<std::string> *hardware_resources = status_monitor->get_hardware_resources();
     std::vector<Component> status_tab_contents;
 
     status_tab_contents.push_back(create_cpu_info_view(
-        status_monitor->get_logical_core_utilizations(),
+        [status_monitor]
+        { return status_monitor->get_core_metrics(); },
+        status_monitor->get_cpuset_only(),
+        [status_monitor]
+        { return status_monitor->get_core_frequencies(); },
+        status_monitor->get_cpu_topology(),
+        status_monitor->get_core_history(),
         status_monitor->get_cpu_max_clock_speed_mhz(),
         status_monitor->get_overall_cpu_utilization(),
         status_monitor->get_cpu_logical_core_count(),
@@ -53,7 +101,19 @@ void start_ui(double refresh_rate_seconds)
     auto status_renderer = create_status_view(*hardware_resources, status_tab_contents, split_state);
 
     // Machine Optimize tab
-    auto optimize_renderer = create_machine_optimizer_view(processes, processes_mutex);
+    std::shared_ptr<OptimizerBackend> optimizer_backend;
+    if (config.optimizer == OptimizerKind::GEMINI)
+    {
+        GeminiOptions gemini = GeminiOptions::from_environment();
+        if (!config.optimizer_endpoint.empty())
+            gemini.endpoint = config.optimizer_endpoint;
+        gemini.http.timeout = std::chrono::milliseconds(
+            static_cast<int64_t>(config.optimizer_timeout_seconds * 1000));
+        optimizer_backend = std::make_shared<GeminiBackend>(std::move(gemini));
+    }
+    else
+        optimizer_backend = std::make_shared<KillCandidateScorer>(process_history);
+    auto optimize_renderer = create_machine_optimizer_view(processes, processes_mutex, optimizer_backend);
 
     auto tab_container = Container::Tab(
         {status_renderer,
@@ -66,8 +126,35 @@ void start_ui(double refresh_rate_seconds)
         tab_container,
     });
 
+    Element last_frame = text("");
+    bool show_self_monitor = false;
+    bool show_alert_log = false;
+    // Declared before the handlers below so the overlay can read its stats
+    CollectorScheduler scheduler(std::chrono::milliseconds(50), 64, config.collector_threads);
+
+    RedrawFilter redraw_filter;
     auto main_container = CatchEvent(main_container_base, [&](Event event)
                                      {
+        if (redraw_filter.needs_frame(event))
+            frame_pacer.mark_dirty();
+
+        if (event == Event::F2)
+        {
+            show_self_monitor = !show_self_monitor;
+            return true;
+        }
+        if (event == Event::F3)
+        {
+            show_alert_log = !show_alert_log;
+            return true;
+        }
+        // A function key, so nothing typed into the process search is taken
+        if (show_alert_log && event == Event::F4)
+        {
+            anomaly_detector->clear_alerts();
+            return true;
+        }
+
         if (selected_function == 1)
         {
             if (event == Event::ArrowUp || event == Event::ArrowDown ||
@@ -82,62 +169,69 @@ void start_ui(double refresh_rate_seconds)
         return false; });
 
     auto main_view = Renderer(main_container, [&]
-                              { return vbox({
-                                           text("Houston - Machine Learning Powered System Monitor and Optimizer, MIT LICENSED 2025") | bold | center,
-                                           separator(),
-                                           function_select->Render(),
-                                           separator(),
-                                           tab_container->Render(),
-                                       }) |
-                                       border; });
-
-    auto screen = ScreenInteractive::Fullscreen();
-
-    std::atomic<bool> should_exit(false);
-    std::mutex refresh_mutex;
-    std::condition_variable refresh_cv;
-
-    std::thread refresh_thread([&]()
-                               {
-        while (!should_exit)
+                              {
+        if (!frame_pacer.begin_frame())
+            return last_frame;
+
+        StageTimer timer(Stage::RENDER);
+        last_frame = vbox({
+                         text("Houston - Machine Learning Powered System Monitor and Optimizer, MIT LICENSED 2025") | bold | center,
+                         separator(),
+                         function_select->Render(),
+                         separator(),
+                         tab_container->Render() | flex,
+                         separator(),
+                         create_alert_status_bar(*anomaly_detector),
+                     }) |
+                     border;
+        if (show_self_monitor)
         {
-            std::unique_lock<std::mutex> lock(refresh_mutex);
-            if (refresh_cv.wait_for(lock, std::chrono::milliseconds(static_cast<int>(refresh_rate_seconds * 1000)),
-                                   [&]() { return should_exit.load(); }))
-            {
-                break; // Exit if should_exit was set
-            }
-
-            if (should_exit) break;
-
-            // Update status monitor
-            status_monitor->update();
-
-            // Update processes with timeout protection
-            auto new_processes = get_processes_list();
-            {
-                std::unique_lock<std::mutex> proc_lock(processes_mutex, std::try_to_lock);
-                if (proc_lock.owns_lock() && !should_exit)
-                {
-                    processes = new_processes;
-                }
-            }
-
-            if (!should_exit)
-            {
-                screen.PostEvent(Event::Custom);
-            }
-        } });
+            auto overlay = create_self_monitor_overlay(SelfMonitor::getInstance().sample(),
+                                                       SelfMonitor::getInstance(),
+                                                       scheduler.get_stats(),
+                                                       scheduler.get_measured_overhead(),
+                                                       scheduler.get_interval_scale(),
+                                                       frame_pacer.get_stats());
+            last_frame = dbox({last_frame, overlay | clear_under | center});
+        }
+        if (show_alert_log)
+        {
+            auto overlay = create_alert_log_overlay(anomaly_detector->get_alerts());
+            last_frame = dbox({last_frame, overlay | clear_under | center});
+        }
+        frame_pacer.end_frame();
+        return last_frame; });
+
+    // Each source refreshes at its own cadence: CPU is cheap and benefits from
+    // finer sampling, the process walk and memory stats are not.
+    auto refresh_interval = std::chrono::milliseconds(static_cast<int>(config.refresh_interval_seconds * 1000));
+    auto cpu_interval = std::chrono::milliseconds(static_cast<int>(config.cpu_interval_seconds * 1000));
+    scheduler.set_cpu_budget(config.cpu_budget_percent);
+    if (config.collect_cpu)
+    {
+        std::function<void()> on_hotplug = nullptr;
+        if (config.collect_hardware)
+            on_hotplug = [&scheduler]
+            { scheduler.trigger("hardware"); };
+        scheduler.add(std::make_shared<CpuCollector>(status_monitor, cpu_interval, on_hotplug));
+    }
+    if (config.collect_memory)
+        scheduler.add(std::make_shared<MemoryCollector>(status_monitor, refresh_interval));
+    if (config.collect_hardware)
+        scheduler.add(std::make_shared<HardwareCollector>(status_monitor));
+    if (config.collect_processes)
+        scheduler.add(std::make_shared<ProcessCollector>(list_processes, processes, processes_mutex, processes_version,
+                                                         process_history, refresh_interval, anomaly_detector));
+    scheduler.set_on_collected([&frame_pacer]
+                               {
+                                   SelfMonitor::getInstance().record_tick();
+                                   frame_pacer.invalidate(); });
+    frame_pacer.start();
+    scheduler.start();
 
     screen.Loop(main_view);
 
-    // cleanup sequence
-    should_exit = true;
-    refresh_cv.notify_all(); // Wake up refresh thread immediately
-
-    if (refresh_thread.joinable())
-    {
-        refresh_thread.join();
-    }
-    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    // Stop collecting before the state the collectors write into goes away
+    scheduler.stop();
+    frame_pacer.stop();
 }
\ No newline at end of file
@@ -4,12 +4,13 @@
 #include "ftxui/component/component.hpp"
 #include "ftxui/component/screen_interactive.hpp"
 #include "../processes_list/processes_list.hpp"
+#include "../config/houston_config.hpp"
 #include <vector>
 #include <mutex>
 #include <thread>
 
 using namespace ftxui;
 
-void start_ui(double refresh_rate_seconds);
+void start_ui(const HoustonConfig &config);
 
 #endif
@@ -3,12 +3,37 @@
 #include <iomanip>
 #include <algorithm>
 
+// Largest unit that still leaves a two-digit count, e.g. "90s", "60m", "24h"
+static std::string format_span(std::chrono::seconds span)
+{
+    long long seconds = span.count();
+    if (seconds <= 0) {
+        return "";
+    }
+    if (seconds < 120) {
+        return std::to_string(seconds) + "s";
+    }
+    if (seconds < 2 * 3600) {
+        return std::to_string(seconds / 60) + "m";
+    }
+    if (seconds < 2 * 86400) {
+        return std::to_string(seconds / 3600) + "h";
+    }
+    return std::to_string(seconds / 86400) + "d";
+}
+
 Element create_process_detail_view(const Process& process,
                                    const std::vector<float>& cpu_history,
                                    const std::vector<float>& memory_history,
                                    const std::vector<float>& network_history,
-                                   int history_size)
+                                   int history_size,
+                                   std::chrono::seconds history_span,
+                                   Element inspection_panel)
 {
+    // Axis labels for the oldest and middle points of the selected time range
+    std::string range_oldest = format_span(history_span);
+    std::string range_middle = format_span(history_span / 2);
+
     unsigned long uptime_seconds = process.get_cpu_time();
     unsigned long days = uptime_seconds / 86400;
     unsigned long hours = (uptime_seconds % 86400) / 3600;
@@ -148,9 +173,9 @@ Element create_process_detail_view(const Process& process,
             vbox({
                 graph(cpu_func) | color(Color::Green) | flex,
                 hbox({
-                    text("60s") | dim,
+                    text(range_oldest) | dim,
                     filler(),
-                    text("30s") | dim,
+                    text(range_middle) | dim,
                     filler(),
                     text("now") | dim,
                 }) | size(HEIGHT, EQUAL, 1),
@@ -172,9 +197,9 @@ Element create_process_detail_view(const Process& process,
             vbox({
                 graph(mem_func) | color(Color::Blue) | flex,
                 hbox({
-                    text("60s") | dim,
+                    text(range_oldest) | dim,
                     filler(),
-                    text("30s") | dim,
+                    text(range_middle) | dim,
                     filler(),
                     text("now") | dim,
                 }) | size(HEIGHT, EQUAL, 1),
@@ -196,9 +221,9 @@ Element create_process_detail_view(const Process& process,
             vbox({
                 graph(net_func) | color(Color::Cyan) | flex,
                 hbox({
-                    text("60s") | dim,
+                    text(range_oldest) | dim,
                     filler(),
-                    text("30s") | dim,
+                    text(range_middle) | dim,
                     filler(),
                     text("now") | dim,
                 }) | size(HEIGHT, EQUAL, 1),
@@ -217,7 +242,7 @@ Element create_process_detail_view(const Process& process,
                 text(""),
                 hbox({text("Command: ") | bold, text(process.get_command())}),
             }) | border | size(WIDTH, GREATER_THAN, 40),
-            filler(),
+            inspection_panel ? inspection_panel : filler(),
         }),
         separator(),
         hbox({
@@ -229,6 +254,10 @@ Element create_process_detail_view(const Process& process,
         hbox({
             text("ESC: Return") | dim,
             text(" | ") | dim,
+            text("t: Time range") | dim,
+            text(" | ") | dim,
+            text("i: Inspect") | dim,
+            text(" | ") | dim,
             text("Backspace: SIGTERM") | dim,
             text(" | ") | dim,
             text("Delete: SIGKILL") | dim,
@@ -236,3 +265,30 @@ Element create_process_detail_view(const Process& process,
     }) | flex;
 }
 
+
+Element create_inspection_panel(InspectionSection section, const std::optional<InspectionResult>& result)
+{
+    Elements tabs;
+    for (int i = 0; i < INSPECTION_SECTION_COUNT; i++) {
+        auto tab_section = static_cast<InspectionSection>(i);
+        Element tab = text(std::string(" ") + inspection_section_name(tab_section) + " ");
+        tabs.push_back(tab_section == section ? tab | inverted : tab | dim);
+    }
+
+    Elements rows;
+    if (!result) {
+        rows.push_back(text("Loading...") | dim);
+    } else if (!result->error.empty()) {
+        rows.push_back(text(result->error) | color(Color::Red));
+    } else {
+        for (const auto& [label, value] : result->rows) {
+            rows.push_back(hbox({text(label + ": ") | bold, text(value)}));
+        }
+    }
+
+    return vbox({
+        hbox(std::move(tabs)),
+        separator(),
+        vbox(std::move(rows)) | yframe | size(HEIGHT, LESS_THAN, 12),
+    }) | border | flex;
+}
@@ -4,15 +4,26 @@
 #include "ftxui/component/component.hpp"
 #include "ftxui/dom/elements.hpp"
 #include "../../processes_list/process.hpp"
+#include "../../metrics/time_series.hpp"
+#include "../../processes_list/process_inspector.hpp"
+#include <chrono>
+#include <optional>
 #include <vector>
 
 using namespace ftxui;
 
+// history_span is the time covered by history_size points, used for the axis
+// labels; zero leaves them blank
 Element create_process_detail_view(const Process& process,
                                    const std::vector<float>& cpu_history,
                                    const std::vector<float>& memory_history,
                                    const std::vector<float>& network_history,
-                                   int history_size);
+                                   int history_size,
+                                   std::chrono::seconds history_span = std::chrono::seconds(0),
+                                   Element inspection_panel = nullptr);
+
+// Panel for one inspection section; result is empty while it is still loading
+Element create_inspection_panel(InspectionSection section, const std::optional<InspectionResult>& result);
 
 #endif
 
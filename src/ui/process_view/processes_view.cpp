@@ -1,5 +1,6 @@
 #include "processes_view.hpp"
 #include "processes_view_state.hpp"
+#include "processes_view_model.hpp"
 #include "processes_view_table.hpp"
 #include "processes_view_event_handler.hpp"
 #include "process_detail_view.hpp"
@@ -8,46 +9,66 @@
 
 using namespace ProcessesView;
 
-Component create_processes_view(std::vector<Process>& processes, std::mutex& processes_mutex, double& refresh_rate_seconds)
+// Time covered by capacity raw samples, extrapolated from the interval between
+// the stored ones: the collector period varies with the profile and the CPU budget
+static std::chrono::seconds raw_history_span(const std::vector<std::chrono::steady_clock::time_point>& times,
+                                             int capacity)
+{
+    if (times.size() < 2) {
+        return std::chrono::seconds(0);
+    }
+    auto stored = times.back() - times.front();
+    return std::chrono::duration_cast<std::chrono::seconds>(stored * capacity / static_cast<int>(times.size() - 1));
+}
+
+Component create_processes_view(std::vector<Process>& processes, std::mutex& processes_mutex,
+                                const std::atomic<uint64_t>& processes_version,
+                                std::shared_ptr<ProcessHistoryStore> process_history,
+                                std::function<void()> request_redraw,
+                                std::chrono::milliseconds termination_grace)
 {
     auto state = std::make_shared<ViewState>();
+    auto view_model = std::make_shared<ProcessesViewModel>(processes, processes_mutex, processes_version);
+    auto inspector = std::make_shared<ProcessInspector>(request_redraw);
+    auto signal_dispatcher = std::make_shared<SignalDispatcher>(request_redraw);
+    auto reaper = std::make_shared<TerminationReaper>(std::move(request_redraw), termination_grace);
 
-    auto base_component = Renderer([&processes, &processes_mutex, &refresh_rate_seconds, state] {
+    auto base_component = Renderer([process_history, state, view_model, inspector, signal_dispatcher, reaper] {
         if (*state->show_detail_view) {
-            std::vector<Process> processes_copy;
-            {
-                std::lock_guard<std::mutex> lock(processes_mutex);
-                processes_copy = processes;
-            }
-
-            auto it = std::find_if(processes_copy.begin(), processes_copy.end(),
-                [&](const Process& p) { return p.get_pid() == *state->detail_process_pid; });
+            std::optional<Process> proc = view_model->find_process(*state->detail_process_pid);
 
-            if (it != processes_copy.end()) {
-                auto now = std::chrono::steady_clock::now();
-                auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - *state->last_sample_time).count();
-                auto sample_interval_ms = static_cast<long long>(refresh_rate_seconds * 1000);
+            if (proc) {
+                ProcessHistory history = process_history->get(*state->detail_process_pid);
 
-                if (elapsed >= sample_interval_ms) {
-                    state->cpu_history->push_back(static_cast<float>(it->get_cpu_usage()));
-                    state->memory_history->push_back(static_cast<float>(it->get_memory_usage()));
-                    state->network_history->push_back(static_cast<float>(it->get_network_usage()));
+                // Roll up the samples the collector took since the last frame; on the
+                // first frame that is everything it has kept for this pid
+                uint64_t fresh = std::min<uint64_t>(history.total_samples - *state->history_samples_seen,
+                                                    history.cpu.size());
+                for (size_t i = history.cpu.size() - fresh; i < history.cpu.size(); i++) {
+                    state->cpu_history->push(history.cpu[i], history.times[i]);
+                    state->memory_history->push(history.memory[i], history.times[i]);
+                    state->network_history->push(history.network[i], history.times[i]);
+                }
+                *state->history_samples_seen = history.total_samples;
 
-                    if (state->cpu_history->size() > ViewState::HISTORY_SIZE) {
-                        state->cpu_history->erase(state->cpu_history->begin());
-                    }
-                    if (state->memory_history->size() > ViewState::HISTORY_SIZE) {
-                        state->memory_history->erase(state->memory_history->begin());
-                    }
-                    if (state->network_history->size() > ViewState::HISTORY_SIZE) {
-                        state->network_history->erase(state->network_history->begin());
-                    }
+                // Only the section on screen is read, in the background
+                auto section = static_cast<InspectionSection>(*state->inspection_section);
+                Element inspection_panel = create_inspection_panel(
+                    section, inspector->get(*state->detail_process_pid, section));
 
-                    *state->last_sample_time = now;
+                Resolution resolution = *state->history_resolution;
+                if (resolution == Resolution::SECONDS) {
+                    int capacity = static_cast<int>(process_history->get_capacity());
+                    return create_process_detail_view(*proc, history.cpu, history.memory, history.network,
+                                                      capacity, raw_history_span(history.times, capacity),
+                                                      inspection_panel);
                 }
-
-                return create_process_detail_view(*it, *state->cpu_history, *state->memory_history,
-                                                  *state->network_history, ViewState::HISTORY_SIZE);
+                int capacity = static_cast<int>(state->cpu_history->capacity(resolution));
+                auto point_span = resolution == Resolution::MINUTES ? std::chrono::seconds(60) : std::chrono::seconds(3600);
+                return create_process_detail_view(*proc, state->cpu_history->values(resolution),
+                                                  state->memory_history->values(resolution),
+                                                  state->network_history->values(resolution),
+                                                  capacity, point_span * capacity, inspection_panel);
             } else {
                 return vbox({
                     text("Process Not Found") | bold | center,
@@ -60,16 +81,38 @@ Component create_processes_view(std::vector<Process>& processes, std::mutex& pro
             }
         }
 
-        std::vector<Process> processes_copy;
-        {
-            std::lock_guard<std::mutex> lock(processes_mutex);
-            processes_copy = processes;
-        }
+        Element table = render_process_table(view_model->get_rows(*state, compute_needed_rows(*state)), *state);
 
-        return create_process_table(processes_copy, *state);
+        // Selection size while tagging, then terminations in flight, then the
+        // outcome of the last termination or batch signal
+        Element status;
+        std::vector<TerminationOutcome> terminations;
+        if (signal_dispatcher->is_busy()) {
+            status = text("Sending signals...") | color(Color::Yellow);
+        } else if (!state->selection->empty()) {
+            status = text(std::to_string(state->selection->size()) +
+                          " selected  Backspace: SIGTERM  Delete: SIGKILL  T: terminate  Esc: clear") |
+                     color(Color::Yellow) | bold;
+        } else if (size_t pending = reaper->get_pending_count(); pending > 0) {
+            status = text("Terminating " + std::to_string(pending) + " process" + (pending == 1 ? "" : "es") +
+                          ", SIGKILL after " + std::to_string(reaper->get_grace_period().count()) + " ms") |
+                     color(Color::Yellow);
+        } else if (!(terminations = reaper->get_outcomes()).empty()) {
+            bool clean = std::all_of(terminations.begin(), terminations.end(), [](const TerminationOutcome& outcome) {
+                return outcome.state == TerminationState::EXITED || outcome.state == TerminationState::KILLED;
+            });
+            status = text(summarize_terminations(terminations)) | color(clean ? Color::Green : Color::Red);
+        } else if (auto result = signal_dispatcher->get_last_result()) {
+            status = text(summarize_signal_result(*result)) | color(result->sent == result->requested ? Color::Green : Color::Red);
+        }
+        if (!status) {
+            return table;
+        }
+        return vbox({table | flex, separator(), status});
     });
 
-    return CatchEvent(base_component, [&processes, &processes_mutex, state](Event event) {
-        return handle_all_events(event, *state, processes, processes_mutex);
+    return CatchEvent(base_component, [&processes, &processes_mutex, state, view_model, signal_dispatcher,
+                                       reaper](Event event) {
+        return handle_all_events(event, *state, processes, processes_mutex, *view_model, *signal_dispatcher, *reaper);
     });
 }
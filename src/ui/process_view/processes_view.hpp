@@ -4,12 +4,27 @@
 #include "ftxui/component/component.hpp"
 #include "ftxui/dom/elements.hpp"
 #include "../../processes_list/process.hpp"
+#include "../../metrics/process_history.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
 #include <vector>
 #include <mutex>
 
 using namespace ftxui;
 
-Component create_processes_view(std::vector<Process>& processes, std::mutex& processes_mutex, double& refresh_rate_seconds);
+// processes_version must be incremented whenever processes is replaced.
+// process_history is filled by the process collector and feeds the detail view.
+// request_redraw is called from background threads when lazily loaded detail
+// data arrives. termination_grace is how long 'T' waits for SIGTERM to work
+// before escalating to SIGKILL.
+Component create_processes_view(std::vector<Process>& processes, std::mutex& processes_mutex,
+                                const std::atomic<uint64_t>& processes_version,
+                                std::shared_ptr<ProcessHistoryStore> process_history,
+                                std::function<void()> request_redraw,
+                                std::chrono::milliseconds termination_grace = std::chrono::milliseconds(3000));
 
 #endif
 
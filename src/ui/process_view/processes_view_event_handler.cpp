@@ -1,6 +1,7 @@
 #include "processes_view_event_handler.hpp"
 #include "processes_view_inputs.hpp"
 #include "processes_view_table.hpp"
+#include "../../processes_list/process_inspector.hpp"
 #include <algorithm>
 
 namespace ProcessesView {
@@ -8,31 +9,36 @@ namespace ProcessesView {
 bool handle_detail_view_events(
     Event& event,
     ViewState& state,
-    std::vector<Process>& processes,
-    std::mutex& processes_mutex
+    ProcessesViewModel& view_model
 ) {
+    if (event == Event::Character('t')) {
+        // Cycle the graphs through the last minute, hour and day
+        switch (*state.history_resolution) {
+            case Resolution::SECONDS: *state.history_resolution = Resolution::MINUTES; break;
+            case Resolution::MINUTES: *state.history_resolution = Resolution::HOURS; break;
+            default: *state.history_resolution = Resolution::SECONDS; break;
+        }
+        return true;
+    }
+
+    if (event == Event::Character('i')) {
+        *state.inspection_section = (*state.inspection_section + 1) % INSPECTION_SECTION_COUNT;
+        return true;
+    }
+
     if (event == Event::Escape) {
         *state.show_detail_view = false;
         *state.detail_process_pid = 0;
         state.cpu_history->clear();
         state.memory_history->clear();
         state.network_history->clear();
-        *state.last_sample_time = std::chrono::steady_clock::now();
+        *state.history_samples_seen = 0;
         return true;
     }
 
     if (event == Event::Backspace) {
-        std::vector<Process> processes_copy;
-        {
-            std::lock_guard<std::mutex> lock(processes_mutex);
-            processes_copy = processes;
-        }
-
-        auto it = std::find_if(processes_copy.begin(), processes_copy.end(),
-            [&](const Process& p) { return p.get_pid() == *state.detail_process_pid; });
-
-        if (it != processes_copy.end()) {
-            it->kill(15);
+        if (auto proc = view_model.find_process(*state.detail_process_pid)) {
+            proc->kill(15);
         }
 
         *state.show_detail_view = false;
@@ -40,22 +46,13 @@ bool handle_detail_view_events(
         state.cpu_history->clear();
         state.memory_history->clear();
         state.network_history->clear();
-        *state.last_sample_time = std::chrono::steady_clock::now();
+        *state.history_samples_seen = 0;
         return true;
     }
 
     if (event == Event::Delete) {
-        std::vector<Process> processes_copy;
-        {
-            std::lock_guard<std::mutex> lock(processes_mutex);
-            processes_copy = processes;
-        }
-
-        auto it = std::find_if(processes_copy.begin(), processes_copy.end(),
-            [&](const Process& p) { return p.get_pid() == *state.detail_process_pid; });
-
-        if (it != processes_copy.end()) {
-            it->kill(9);
+        if (auto proc = view_model.find_process(*state.detail_process_pid)) {
+            proc->kill(9);
         }
 
         *state.show_detail_view = false;
@@ -63,7 +60,7 @@ bool handle_detail_view_events(
         state.cpu_history->clear();
         state.memory_history->clear();
         state.network_history->clear();
-        *state.last_sample_time = std::chrono::steady_clock::now();
+        *state.history_samples_seen = 0;
         return true;
     }
 
@@ -105,23 +102,94 @@ bool handle_header_click_events(
 bool handle_process_list_events(
     Event& event,
     ViewState& state,
-    std::vector<Process>& processes,
-    std::mutex& processes_mutex
+    ProcessesViewModel& view_model
 ) {
     if (event == Event::Return && !*state.search_mode) {
-        std::vector<Process> processes_copy;
-        {
-            std::lock_guard<std::mutex> lock(processes_mutex);
-            processes_copy = processes;
+        const std::vector<Process>& rows = view_model.get_rows(state, *state.selected_index + 1);
+
+        if (*state.selected_index >= 0 && *state.selected_index < static_cast<int>(rows.size())) {
+            *state.detail_process_pid = rows[*state.selected_index].get_pid();
+            *state.show_detail_view = true;
+            return true;
         }
+    }
 
-        processes_copy = prepare_process_list(processes_copy, state);
+    return false;
+}
 
-        if (*state.selected_index >= 0 && *state.selected_index < static_cast<int>(processes_copy.size())) {
-            *state.detail_process_pid = processes_copy[*state.selected_index].get_pid();
-            *state.show_detail_view = true;
+bool handle_selection_events(
+    Event& event,
+    ViewState& state,
+    ProcessesViewModel& view_model,
+    SignalDispatcher& signal_dispatcher,
+    TerminationReaper& reaper
+) {
+    if (*state.search_mode) {
+        return false;
+    }
+    ProcessSelection& selection = *state.selection;
+
+    if (event == Event::Character(' ')) {
+        // Tag and move on, so holding Space tags a run of rows
+        const std::vector<Process>& rows = view_model.get_rows(state, *state.selected_index + 1);
+        if (*state.selected_index >= 0 && *state.selected_index < static_cast<int>(rows.size())) {
+            selection.toggle(rows[*state.selected_index]);
+            (*state.selected_index)++;
+        }
+        return true;
+    }
+
+    if (event == Event::Character('a')) {
+        // Everything the current search or filter matches
+        for (const auto& proc : view_model.get_rows(state)) {
+            selection.add(proc);
+        }
+        return true;
+    }
+
+    if (event == Event::Character('s')) {
+        const std::vector<Process>& rows = view_model.get_rows(state, *state.selected_index + 1);
+        if (*state.selected_index >= 0 && *state.selected_index < static_cast<int>(rows.size())) {
+            for (const auto& proc : view_model.find_subtree(rows[*state.selected_index].get_pid())) {
+                selection.add(proc);
+            }
+        }
+        return true;
+    }
+
+    // Escape clears the search first, then the selection, then the last results
+    if (event == Event::Escape && state.search_phrase->empty()) {
+        if (!selection.empty()) {
+            selection.clear();
             return true;
         }
+        if (signal_dispatcher.get_last_result() || !reaper.get_outcomes().empty()) {
+            signal_dispatcher.clear_last_result();
+            reaper.clear_outcomes();
+            return true;
+        }
+        return false;
+    }
+
+    if (!selection.empty() && (event == Event::Backspace || event == Event::Delete)) {
+        reaper.clear_outcomes();
+        signal_dispatcher.submit(selection.take(), event == Event::Backspace ? SIGTERM : SIGKILL);
+        return true;
+    }
+
+    if (event == Event::Character('T')) {
+        if (selection.empty()) {
+            // Pin the highlighted row the same way tagging does
+            const std::vector<Process>& rows = view_model.get_rows(state, *state.selected_index + 1);
+            if (*state.selected_index < 0 || *state.selected_index >= static_cast<int>(rows.size())) {
+                return true;
+            }
+            selection.add(rows[*state.selected_index]);
+        }
+        signal_dispatcher.clear_last_result();
+        reaper.clear_outcomes();
+        reaper.terminate(selection.take());
+        return true;
     }
 
     return false;
@@ -131,13 +199,20 @@ bool handle_all_events(
     Event& event,
     ViewState& state,
     std::vector<Process>& processes,
-    std::mutex& processes_mutex
+    std::mutex& processes_mutex,
+    ProcessesViewModel& view_model,
+    SignalDispatcher& signal_dispatcher,
+    TerminationReaper& reaper
 ) {
     if (*state.show_detail_view) {
-        return handle_detail_view_events(event, state, processes, processes_mutex);
+        return handle_detail_view_events(event, state, view_model);
+    }
+
+    if (handle_process_list_events(event, state, view_model)) {
+        return true;
     }
 
-    if (handle_process_list_events(event, state, processes, processes_mutex)) {
+    if (handle_selection_events(event, state, view_model, signal_dispatcher, reaper)) {
         return true;
     }
 
@@ -162,7 +237,9 @@ bool handle_all_events(
         state.detail_process_pid,
         state.last_click_time,
         state.last_clicked_index,
-        state.displayed_pids
+        state.displayed_pids,
+        state.first_visible_index,
+        &view_model.get_displayed_rows()
     );
 }
 
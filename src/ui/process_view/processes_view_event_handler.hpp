@@ -3,7 +3,10 @@
 
 #include "ftxui/component/event.hpp"
 #include "processes_view_state.hpp"
+#include "processes_view_model.hpp"
 #include "../../processes_list/process.hpp"
+#include "../../processes_list/signal_batch.hpp"
+#include "../../processes_list/termination_reaper.hpp"
 #include <vector>
 #include <mutex>
 
@@ -15,8 +18,7 @@ namespace ProcessesView {
 bool handle_detail_view_events(
     Event& event,
     ViewState& state,
-    std::vector<Process>& processes,
-    std::mutex& processes_mutex
+    ProcessesViewModel& view_model
 );
 
 // Handle header click events for sorting
@@ -29,8 +31,19 @@ bool handle_header_click_events(
 bool handle_process_list_events(
     Event& event,
     ViewState& state,
-    std::vector<Process>& processes,
-    std::mutex& processes_mutex
+    ProcessesViewModel& view_model
+);
+
+// Handle multi-select (Space, 'a', 's', Esc) and signalling the selection
+// (Backspace for SIGTERM, Delete for SIGKILL) on the dispatcher's thread.
+// 'T' hands the selection, or the highlighted row, to the reaper to be
+// terminated with SIGTERM and escalated to SIGKILL after the grace period.
+bool handle_selection_events(
+    Event& event,
+    ViewState& state,
+    ProcessesViewModel& view_model,
+    SignalDispatcher& signal_dispatcher,
+    TerminationReaper& reaper
 );
 
 // Main event handler that coordinates all event handling
@@ -38,7 +51,10 @@ bool handle_all_events(
     Event& event,
     ViewState& state,
     std::vector<Process>& processes,
-    std::mutex& processes_mutex
+    std::mutex& processes_mutex,
+    ProcessesViewModel& view_model,
+    SignalDispatcher& signal_dispatcher,
+    TerminationReaper& reaper
 );
 
 } // namespace ProcessesView
@@ -1,6 +1,30 @@
 #include "processes_view_inputs.hpp"
+#include "processes_view_search.hpp"
+#include "../../processes_list/process_filter.hpp"
 #include <algorithm>
 
+// Keeps only the processes matching the search phrase, like the table does
+static void filter_by_search(std::vector<Process>& processes, const std::string& search_phrase) {
+    if (search_phrase.empty()) {
+        return;
+    }
+
+    if (ProcessFilter::looks_like_filter(search_phrase)) {
+        ProcessFilter filter;
+        bool valid = filter.compile(search_phrase);
+        std::erase_if(processes, [&](const Process& proc) { return !valid || !filter.matches(proc); });
+        return;
+    }
+
+    ProcessesView::SearchIndex index;
+    index.update(processes);
+    std::vector<Process> matches;
+    for (uint32_t idx : index.search(search_phrase)) {
+        matches.push_back(std::move(processes[idx]));
+    }
+    processes = std::move(matches);
+}
+
 bool handle_processes_view_event(
     Event event,
     std::shared_ptr<int> selected_index,
@@ -18,9 +42,28 @@ bool handle_processes_view_event(
     std::shared_ptr<pid_t> detail_process_pid,
     std::shared_ptr<std::chrono::steady_clock::time_point> last_click_time,
     std::shared_ptr<int> last_clicked_index,
-    std::shared_ptr<std::vector<pid_t>> displayed_pids
+    std::shared_ptr<std::vector<pid_t>> displayed_pids,
+    std::shared_ptr<int> first_visible_index,
+    const std::vector<Process>* displayed_rows
 )
 {
+    // Kills must hit the row that is on screen. Without the table's rows,
+    // rebuild them from the snapshot in the default memory order.
+    std::vector<Process> fallback_rows;
+    auto load_rows = [&]() -> const std::vector<Process>& {
+        {
+            std::lock_guard<std::mutex> lock(processes_mutex);
+            fallback_rows = processes;
+        }
+
+        std::sort(fallback_rows.begin(), fallback_rows.end(), [](const Process& a, const Process& b) {
+            return a.get_memory_usage() > b.get_memory_usage();
+        });
+
+        filter_by_search(fallback_rows, *search_phrase);
+        return fallback_rows;
+    };
+
     if (*search_mode) {
         if (event == Event::Escape) {
             *search_mode = false;
@@ -63,72 +106,20 @@ bool handle_processes_view_event(
     }
 
     if (event == Event::Backspace) {
-        std::vector<Process> processes_copy;
-        {
-            std::lock_guard<std::mutex> lock(processes_mutex);
-            processes_copy = processes;
-        }
-
-        std::sort(processes_copy.begin(), processes_copy.end(), [](const Process& a, const Process& b) {
-            return a.get_memory_usage() > b.get_memory_usage();
-        });
-
-        if (!search_phrase->empty()) {
-            std::string search_lower = *search_phrase;
-            std::transform(search_lower.begin(), search_lower.end(), search_lower.begin(), ::tolower);
+        const std::vector<Process>& rows = displayed_rows ? *displayed_rows : load_rows();
 
-            processes_copy.erase(
-                std::remove_if(processes_copy.begin(), processes_copy.end(),
-                    [&search_lower](const Process& proc) {
-                        std::string name_lower = proc.get_process_name();
-                        std::transform(name_lower.begin(), name_lower.end(), name_lower.begin(), ::tolower);
-                        std::string pid_str = std::to_string(proc.get_pid());
-                        return name_lower.find(search_lower) == std::string::npos &&
-                               pid_str.find(search_lower) == std::string::npos;
-                    }
-                ),
-                processes_copy.end()
-            );
-        }
-
-        if (*selected_index >= 0 && *selected_index < static_cast<int>(processes_copy.size())) {
-            Process proc = processes_copy[*selected_index];
+        if (*selected_index >= 0 && *selected_index < static_cast<int>(rows.size())) {
+            Process proc = rows[*selected_index];
             proc.kill(15);
             return true;
         }
     }
 
     if (event == Event::Delete) {
-        std::vector<Process> processes_copy;
-        {
-            std::lock_guard<std::mutex> lock(processes_mutex);
-            processes_copy = processes;
-        }
+        const std::vector<Process>& rows = displayed_rows ? *displayed_rows : load_rows();
 
-        std::sort(processes_copy.begin(), processes_copy.end(), [](const Process& a, const Process& b) {
-            return a.get_memory_usage() > b.get_memory_usage();
-        });
-
-        if (!search_phrase->empty()) {
-            std::string search_lower = *search_phrase;
-            std::transform(search_lower.begin(), search_lower.end(), search_lower.begin(), ::tolower);
-
-            processes_copy.erase(
-                std::remove_if(processes_copy.begin(), processes_copy.end(),
-                    [&search_lower](const Process& proc) {
-                        std::string name_lower = proc.get_process_name();
-                        std::transform(name_lower.begin(), name_lower.end(), name_lower.begin(), ::tolower);
-                        std::string pid_str = std::to_string(proc.get_pid());
-                        return name_lower.find(search_lower) == std::string::npos &&
-                               pid_str.find(search_lower) == std::string::npos;
-                    }
-                ),
-                processes_copy.end()
-            );
-        }
-
-        if (*selected_index >= 0 && *selected_index < static_cast<int>(processes_copy.size())) {
-            Process proc = processes_copy[*selected_index];
+        if (*selected_index >= 0 && *selected_index < static_cast<int>(rows.size())) {
+            Process proc = rows[*selected_index];
             proc.kill(9);
             return true;
         }
@@ -158,73 +149,55 @@ bool handle_processes_view_event(
     }
     if (event.is_mouse()) {
         auto mouse = event.mouse();
+        // Row boxes only cover the rendered window, which starts at first_visible_index
+        int offset = first_visible_index ? *first_visible_index : 0;
 
         if (mouse.button == Mouse::Left && mouse.motion == Mouse::Released) {
-            std::vector<Process> processes_copy;
-            {
-                std::lock_guard<std::mutex> lock(processes_mutex);
-                processes_copy = processes;
-            }
-
-            std::sort(processes_copy.begin(), processes_copy.end(), [](const Process& a, const Process& b) {
-                return a.get_memory_usage() > b.get_memory_usage();
-            });
-
-            if (!search_phrase->empty()) {
-                std::string search_lower = *search_phrase;
-                std::transform(search_lower.begin(), search_lower.end(), search_lower.begin(), ::tolower);
-
-                processes_copy.erase(
-                    std::remove_if(processes_copy.begin(), processes_copy.end(),
-                        [&search_lower](const Process& proc) {
-                            std::string name_lower = proc.get_process_name();
-                            std::transform(name_lower.begin(), name_lower.end(), name_lower.begin(), ::tolower);
-                            std::string pid_str = std::to_string(proc.get_pid());
-                            return name_lower.find(search_lower) == std::string::npos &&
-                                   pid_str.find(search_lower) == std::string::npos;
-                        }
-                    ),
-                    processes_copy.end()
-                );
-            }
+            const std::vector<Process>& rows = displayed_rows ? *displayed_rows : load_rows();
 
             for (int i = 0; i < static_cast<int>(sigterm_boxes->size()); ++i) {
+                if (offset + i >= static_cast<int>(rows.size())) {
+                    break;
+                }
                 if ((*sigterm_boxes)[i].Contain(mouse.x, mouse.y)) {
-                    Process proc = processes_copy[i];
+                    Process proc = rows[offset + i];
                     proc.kill(15);
                     return true;
                 }
                 if ((*sigkill_boxes)[i].Contain(mouse.x, mouse.y)) {
-                    Process proc = processes_copy[i];
+                    Process proc = rows[offset + i];
                     proc.kill(9);
                     return true;
                 }
             }
         }
 
+        int previous_hover = *hover_index;
+        int previous_sigterm = *hover_sigterm;
+        int previous_sigkill = *hover_sigkill;
         *hover_index = -1;
         *hover_sigterm = -1;
         *hover_sigkill = -1;
 
         for (int i = 0; i < static_cast<int>(sigterm_boxes->size()); ++i) {
             if ((*sigterm_boxes)[i].Contain(mouse.x, mouse.y)) {
-                *hover_sigterm = i;
+                *hover_sigterm = offset + i;
             }
             if ((*sigkill_boxes)[i].Contain(mouse.x, mouse.y)) {
-                *hover_sigkill = i;
+                *hover_sigkill = offset + i;
             }
         }
 
         for (int i = 0; i < static_cast<int>(boxes->size()); ++i) {
             if ((*boxes)[i].Contain(mouse.x, mouse.y)) {
-                *hover_index = i;
+                *hover_index = offset + i;
 
                 if (mouse.button == Mouse::Left && mouse.motion == Mouse::Released) {
                     auto now = std::chrono::steady_clock::now();
                     auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - *last_click_time).count();
 
                     // Check for double-click: same index, within 300ms
-                    if (*last_clicked_index == i && elapsed < 300) {
+                    if (*last_clicked_index == offset + i && elapsed < 300) {
                         // Double-click detected - open detail view
                         if (i < static_cast<int>(displayed_pids->size())) {
                             *detail_process_pid = (*displayed_pids)[i];
@@ -232,8 +205,8 @@ bool handle_processes_view_event(
                         }
                     }
 
-                    *selected_index = i;
-                    *last_clicked_index = i;
+                    *selected_index = offset + i;
+                    *last_clicked_index = offset + i;
                     *last_click_time = now;
                     return true;
                 }
@@ -253,7 +226,9 @@ bool handle_processes_view_event(
             return true;
         }
 
-        return false;
+        // Plain motion only changes the table when it moves onto another row or button
+        return *hover_index != previous_hover || *hover_sigterm != previous_sigterm ||
+               *hover_sigkill != previous_sigkill;
     }
     return false;
 }
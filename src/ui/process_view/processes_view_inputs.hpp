@@ -29,7 +29,9 @@ bool handle_processes_view_event(
     std::shared_ptr<pid_t> detail_process_pid,
     std::shared_ptr<std::chrono::steady_clock::time_point> last_click_time,
     std::shared_ptr<int> last_clicked_index,
-    std::shared_ptr<std::vector<pid_t>> displayed_pids
+    std::shared_ptr<std::vector<pid_t>> displayed_pids,
+    std::shared_ptr<int> first_visible_index = nullptr,
+    const std::vector<Process>* displayed_rows = nullptr
 );
 
 #endif
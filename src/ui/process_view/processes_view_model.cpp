@@ -0,0 +1,95 @@
+#include "processes_view_model.hpp"
+#include "processes_view_table.hpp"
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace ProcessesView {
+
+ProcessesViewModel::ProcessesViewModel(
+    const std::vector<Process>& processes,
+    std::mutex& processes_mutex,
+    const std::atomic<uint64_t>& snapshot_version
+) : processes(processes), processes_mutex(processes_mutex), snapshot_version(snapshot_version) {}
+
+const std::vector<Process>& ProcessesViewModel::get_rows(const ViewState& state, size_t needed_rows) {
+    std::vector<Process> processes_copy;
+    {
+        std::lock_guard<std::mutex> lock(processes_mutex);
+        uint64_t current_version = snapshot_version.load(std::memory_order_relaxed);
+
+        bool same_key = valid &&
+                        rows_snapshot_version == current_version &&
+                        rows_sort_column == *state.sort_column &&
+                        rows_sort_ascending == *state.sort_ascending &&
+                        rows_search_phrase == *state.search_phrase;
+        if (same_key && needed_rows <= sorted_rows) {
+            hits++;
+            return rows;
+        }
+
+        // Scrolling past the sorted prefix: sort ahead so the next few pages are free
+        if (same_key && sorted_rows > 0) {
+            needed_rows = std::max(needed_rows, sorted_rows * 2);
+        }
+
+        processes_copy = processes;
+        rows_snapshot_version = current_version;
+    }
+
+    rows = prepare_process_list(std::move(processes_copy), state, needed_rows);
+    valid = true;
+    rows_sort_column = *state.sort_column;
+    rows_sort_ascending = *state.sort_ascending;
+    rows_search_phrase = *state.search_phrase;
+    sorted_rows = std::min(needed_rows, rows.size());
+    if (sorted_rows == rows.size()) {
+        sorted_rows = std::numeric_limits<size_t>::max();
+    }
+    version++;
+    return rows;
+}
+
+std::optional<Process> ProcessesViewModel::find_process(pid_t pid) const {
+    std::lock_guard<std::mutex> lock(processes_mutex);
+    auto it = std::find_if(processes.begin(), processes.end(),
+        [&](const Process& p) { return p.get_pid() == pid; });
+    if (it == processes.end()) {
+        return std::nullopt;
+    }
+    return *it;
+}
+
+std::vector<Process> ProcessesViewModel::find_subtree(pid_t root) const {
+    std::lock_guard<std::mutex> lock(processes_mutex);
+    std::unordered_map<pid_t, std::vector<size_t>> children;
+    size_t root_index = processes.size();
+    for (size_t i = 0; i < processes.size(); i++) {
+        children[processes[i].get_parent_pid()].push_back(i);
+        if (processes[i].get_pid() == root) {
+            root_index = i;
+        }
+    }
+    if (root_index == processes.size()) {
+        return {};
+    }
+
+    // Breadth first, so parents come before their children. A snapshot taken
+    // while pids are being reused can contain a cycle, hence the visited set.
+    std::vector<Process> subtree = {processes[root_index]};
+    std::unordered_set<pid_t> visited = {root};
+    for (size_t next = 0; next < subtree.size(); next++) {
+        auto it = children.find(subtree[next].get_pid());
+        if (it == children.end()) {
+            continue;
+        }
+        for (size_t child : it->second) {
+            if (visited.insert(processes[child].get_pid()).second) {
+                subtree.push_back(processes[child]);
+            }
+        }
+    }
+    return subtree;
+}
+
+} // namespace ProcessesView
@@ -0,0 +1,71 @@
+#ifndef __PROCESSES_VIEW_MODEL_HPP
+#define __PROCESSES_VIEW_MODEL_HPP
+
+#include "../../processes_list/process.hpp"
+#include "processes_view_state.hpp"
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace ProcessesView {
+
+// The filtered and sorted rows of the processes view, shared by the renderer
+// and the event handlers. Rows are only recomputed when the key (snapshot
+// version, sort column and direction, search phrase) changes, so redraws
+// caused by mouse movement or key presses don't copy or sort anything.
+class ProcessesViewModel {
+private:
+    const std::vector<Process>& processes;
+    std::mutex& processes_mutex;
+    // Bumped by whoever replaces processes, under processes_mutex
+    const std::atomic<uint64_t>& snapshot_version;
+
+    std::vector<Process> rows;
+    bool valid = false;
+    uint64_t rows_snapshot_version = 0;
+    SortColumn rows_sort_column = SortColumn::CPU;
+    bool rows_sort_ascending = false;
+    std::string rows_search_phrase;
+    size_t sorted_rows = 0; // Prefix of rows that is in display order
+
+    uint64_t version = 0;
+    uint64_t hits = 0;
+
+public:
+    ProcessesViewModel(
+        const std::vector<Process>& processes,
+        std::mutex& processes_mutex,
+        const std::atomic<uint64_t>& snapshot_version
+    );
+
+    // Rows in display order; at least the first needed_rows are sorted.
+    // Only the UI thread may call this, the returned reference is valid
+    // until the next call.
+    const std::vector<Process>& get_rows(
+        const ViewState& state,
+        size_t needed_rows = std::numeric_limits<size_t>::max()
+    );
+
+    // Rows returned by the last get_rows call, i.e. what is on screen
+    const std::vector<Process>& get_displayed_rows() const { return rows; }
+
+    // Looks up one process in the latest snapshot without copying the rest
+    std::optional<Process> find_process(pid_t pid) const;
+
+    // The process and all of its descendants in the latest snapshot, whatever
+    // the current search; empty if root is not running
+    std::vector<Process> find_subtree(pid_t root) const;
+
+    // Incremented every time the rows are recomputed
+    uint64_t get_version() const { return version; }
+    // Number of get_rows calls answered from the cached rows
+    uint64_t get_hits() const { return hits; }
+};
+
+} // namespace ProcessesView
+
+#endif
@@ -0,0 +1,77 @@
+#include "processes_view_row_cache.hpp"
+#include <charconv>
+
+namespace ProcessesView {
+
+// Formats with two decimals, like std::fixed << std::setprecision(2)
+static std::string format_fixed2(double value) {
+    char buffer[32];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), value, std::chars_format::fixed, 2);
+    return std::string(buffer, result.ptr);
+}
+
+static std::string format_integer(unsigned long value) {
+    char buffer[24];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    return std::string(buffer, result.ptr);
+}
+
+// h:mm:ss with the hours unpadded
+static std::string format_cpu_time(unsigned long time_seconds) {
+    unsigned long hours = time_seconds / 3600;
+    unsigned long minutes = (time_seconds % 3600) / 60;
+    unsigned long seconds = time_seconds % 60;
+
+    char buffer[32];
+    char* end = std::to_chars(buffer, buffer + 24, hours).ptr;
+    *end++ = ':';
+    *end++ = static_cast<char>('0' + minutes / 10);
+    *end++ = static_cast<char>('0' + minutes % 10);
+    *end++ = ':';
+    *end++ = static_cast<char>('0' + seconds / 10);
+    *end++ = static_cast<char>('0' + seconds % 10);
+    return std::string(buffer, end);
+}
+
+void RowCellCache::begin_frame() {
+    frame++;
+    if (frame % 64 != 0) {
+        return;
+    }
+
+    for (auto it = rows.begin(); it != rows.end();) {
+        if (frame - it->second.last_used_frame > MAX_IDLE_FRAMES) {
+            it = rows.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+const FormattedRow& RowCellCache::get(const Process& proc) {
+    auto [it, inserted] = rows.try_emplace(proc.get_pid());
+    FormattedRow& row = it->second;
+    row.last_used_frame = frame;
+
+    if (inserted) {
+        row.pid_text = format_integer(static_cast<unsigned long>(proc.get_pid()));
+    } else if (row.memory == proc.get_memory_usage() && row.cpu == proc.get_cpu_usage() &&
+               row.network == proc.get_network_usage() && row.cpu_time == proc.get_cpu_time()) {
+        hits++;
+        return row;
+    }
+
+    misses++;
+    row.memory = proc.get_memory_usage();
+    row.cpu = proc.get_cpu_usage();
+    row.network = proc.get_network_usage();
+    row.cpu_time = proc.get_cpu_time();
+
+    row.memory_text = format_fixed2(row.memory / 1024.0);
+    row.cpu_text = format_fixed2(row.cpu);
+    row.network_text = format_integer(row.network);
+    row.time_text = format_cpu_time(row.cpu_time);
+    return row;
+}
+
+} // namespace ProcessesView
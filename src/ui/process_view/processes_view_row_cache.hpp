@@ -0,0 +1,54 @@
+#ifndef __PROCESSES_VIEW_ROW_CACHE_HPP
+#define __PROCESSES_VIEW_ROW_CACHE_HPP
+
+#include "../../processes_list/process.hpp"
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+namespace ProcessesView {
+
+// Preformatted cell text for one process row, along with the raw values it was
+// formatted from so a new snapshot can tell whether it is still valid.
+struct FormattedRow {
+    unsigned long memory = 0;
+    double cpu = 0.0;
+    unsigned long network = 0;
+    unsigned long cpu_time = 0;
+
+    std::string pid_text;
+    std::string memory_text;
+    std::string cpu_text;
+    std::string network_text;
+    std::string time_text;
+
+    uint64_t last_used_frame = 0;
+};
+
+// Cache of formatted row cells keyed by pid. A row is only reformatted when
+// that pid's values change, so hover and keyboard navigation redraw without
+// formatting anything.
+class RowCellCache {
+private:
+    std::unordered_map<pid_t, FormattedRow> rows;
+    uint64_t frame = 0;
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+
+public:
+    // Rows not drawn for this many frames are dropped
+    static constexpr uint64_t MAX_IDLE_FRAMES = 256;
+
+    // Marks the start of a frame and periodically drops rows that went idle
+    void begin_frame();
+
+    const FormattedRow& get(const Process& proc);
+
+    size_t size() const { return rows.size(); }
+    uint64_t get_hits() const { return hits; }
+    uint64_t get_misses() const { return misses; }
+};
+
+} // namespace ProcessesView
+
+#endif
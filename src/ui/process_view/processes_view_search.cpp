@@ -0,0 +1,178 @@
+#include "processes_view_search.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define HOUSTON_X86_SEARCH 1
+#endif
+
+namespace ProcessesView {
+
+static std::string to_lower(const std::string& text) {
+    std::string lower = text;
+    std::transform(lower.begin(), lower.end(), lower.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return lower;
+}
+
+static bool contains_scalar(std::string_view haystack, std::string_view needle) {
+    return haystack.find(needle) != std::string_view::npos;
+}
+
+#ifdef HOUSTON_X86_SEARCH
+
+// Both SIMD versions compare a block of haystack against the needle's first
+// and last characters at once and only memcmp the positions where both match.
+
+__attribute__((target("sse2")))
+static bool contains_sse2(std::string_view haystack, std::string_view needle) {
+    const size_t k = needle.size();
+    const __m128i first = _mm_set1_epi8(needle.front());
+    const __m128i last = _mm_set1_epi8(needle.back());
+    const char* data = haystack.data();
+
+    size_t i = 0;
+    for (; i + k + 15 <= haystack.size(); i += 16) {
+        __m128i block_first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        __m128i block_last = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + k - 1));
+        unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(
+            _mm_and_si128(_mm_cmpeq_epi8(block_first, first), _mm_cmpeq_epi8(block_last, last))));
+        while (mask != 0) {
+            unsigned bit = static_cast<unsigned>(__builtin_ctz(mask));
+            if (k <= 2 || std::memcmp(data + i + bit + 1, needle.data() + 1, k - 2) == 0) {
+                return true;
+            }
+            mask &= mask - 1;
+        }
+    }
+    return contains_scalar(haystack.substr(i), needle);
+}
+
+__attribute__((target("avx2")))
+static bool contains_avx2(std::string_view haystack, std::string_view needle) {
+    const size_t k = needle.size();
+    const __m256i first = _mm256_set1_epi8(needle.front());
+    const __m256i last = _mm256_set1_epi8(needle.back());
+    const char* data = haystack.data();
+
+    size_t i = 0;
+    for (; i + k + 31 <= haystack.size(); i += 32) {
+        __m256i block_first = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        __m256i block_last = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + k - 1));
+        unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(
+            _mm256_and_si256(_mm256_cmpeq_epi8(block_first, first), _mm256_cmpeq_epi8(block_last, last))));
+        while (mask != 0) {
+            unsigned bit = static_cast<unsigned>(__builtin_ctz(mask));
+            if (k <= 2 || std::memcmp(data + i + bit + 1, needle.data() + 1, k - 2) == 0) {
+                return true;
+            }
+            mask &= mask - 1;
+        }
+    }
+    return contains_sse2(haystack.substr(i), needle);
+}
+
+#endif
+
+bool contains_lowercase(std::string_view haystack, std::string_view needle) {
+    if (needle.empty()) {
+        return true;
+    }
+    if (needle.size() > haystack.size()) {
+        return false;
+    }
+
+#ifdef HOUSTON_X86_SEARCH
+    static const bool has_avx2 = __builtin_cpu_supports("avx2");
+    static const bool has_sse2 = __builtin_cpu_supports("sse2");
+    if (has_avx2) {
+        return contains_avx2(haystack, needle);
+    }
+    if (has_sse2) {
+        return contains_sse2(haystack, needle);
+    }
+#endif
+    return contains_scalar(haystack, needle);
+}
+
+void SearchIndex::update(const std::vector<Process>& processes) {
+    updates++;
+    bool changed = processes.size() != snapshot_pids.size();
+
+    snapshot.resize(processes.size());
+    snapshot_pids.resize(processes.size());
+    for (size_t i = 0; i < processes.size(); i++) {
+        const Process& proc = processes[i];
+        pid_t pid = proc.get_pid();
+
+        auto [it, inserted] = entries.try_emplace(pid);
+        Entry& entry = it->second;
+        if (inserted || entry.name != proc.get_process_name() || entry.command != proc.get_command()) {
+            entry.name = proc.get_process_name();
+            entry.command = proc.get_command();
+            entry.name_lower = to_lower(entry.name);
+            entry.command_lower = to_lower(entry.command);
+            entry.pid_text = std::to_string(pid);
+            changed = true;
+        }
+        entry.last_seen = updates;
+
+        changed = changed || snapshot_pids[i] != pid;
+        snapshot_pids[i] = pid;
+        snapshot[i] = &entry;
+    }
+
+    if (!changed) {
+        return;
+    }
+    generation++;
+
+    // Forget processes that have exited
+    if (entries.size() > processes.size()) {
+        for (auto it = entries.begin(); it != entries.end();) {
+            if (it->second.last_seen != updates) {
+                it = entries.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+}
+
+std::vector<uint32_t> SearchIndex::search(const std::string& query) {
+    std::string needle = to_lower(query);
+
+    auto matches = [&needle](const Entry& entry) {
+        return contains_lowercase(entry.name_lower, needle) ||
+               contains_lowercase(entry.pid_text, needle) ||
+               contains_lowercase(entry.command_lower, needle);
+    };
+
+    std::vector<uint32_t> result;
+    bool narrow = last_generation == generation && !last_query.empty() && needle.starts_with(last_query);
+    if (narrow) {
+        // Anything matching the longer query also matched the shorter one
+        for (uint32_t i : last_matches) {
+            if (matches(*snapshot[i])) {
+                result.push_back(i);
+            }
+        }
+        narrowed_scans++;
+    } else {
+        for (uint32_t i = 0; i < snapshot.size(); i++) {
+            if (matches(*snapshot[i])) {
+                result.push_back(i);
+            }
+        }
+        full_scans++;
+    }
+
+    last_query = needle;
+    last_generation = generation;
+    last_matches = result;
+    return result;
+}
+
+} // namespace ProcessesView
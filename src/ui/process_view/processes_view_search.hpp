@@ -0,0 +1,63 @@
+#ifndef __PROCESSES_VIEW_SEARCH_HPP
+#define __PROCESSES_VIEW_SEARCH_HPP
+
+#include "../../processes_list/process.hpp"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace ProcessesView {
+
+// Case-insensitive substring search of haystack (already lowercase) for
+// needle (already lowercase). Uses AVX2 or SSE2 when the CPU has them and
+// falls back to a scalar search otherwise.
+bool contains_lowercase(std::string_view haystack, std::string_view needle);
+
+// Lowercased name / command / pid text for each process in a snapshot, so
+// searching doesn't lowercase or format anything per keystroke or frame.
+// Entries are cached by pid and only rebuilt when a process's name or
+// command changes (exec) or a new pid appears.
+class SearchIndex {
+private:
+    struct Entry {
+        std::string name;
+        std::string command;
+        std::string name_lower;
+        std::string command_lower;
+        std::string pid_text;
+        uint64_t last_seen = 0;
+    };
+
+    std::unordered_map<pid_t, Entry> entries;
+    std::vector<const Entry*> snapshot; // Aligned with the processes passed to update()
+    std::vector<pid_t> snapshot_pids;
+    uint64_t generation = 0;
+    uint64_t updates = 0;
+
+    // Last query and its matches, reused when the query is extended
+    std::string last_query;
+    uint64_t last_generation = 0;
+    std::vector<uint32_t> last_matches;
+
+    uint64_t full_scans = 0;
+    uint64_t narrowed_scans = 0;
+
+public:
+    // Points the index at a new snapshot. Cheap when nothing changed.
+    void update(const std::vector<Process>& processes);
+
+    // Indices into the snapshot whose name, command or pid contains query
+    // (case-insensitive). Typing another letter only re-checks the previous
+    // matches.
+    std::vector<uint32_t> search(const std::string& query);
+
+    uint64_t get_generation() const { return generation; }
+    uint64_t get_full_scans() const { return full_scans; }
+    uint64_t get_narrowed_scans() const { return narrowed_scans; }
+};
+
+} // namespace ProcessesView
+
+#endif
@@ -0,0 +1,158 @@
+#include "processes_view_sort.hpp"
+#include <algorithm>
+#include <numeric>
+#include <unordered_map>
+
+namespace ProcessesView {
+
+// Three-way comparison of one column, resolved at compile time
+template <SortColumn Column>
+static int compare_column(const Process& a, const Process& b) {
+    if constexpr (Column == SortColumn::NAME) {
+        return a.get_process_name().compare(b.get_process_name());
+    } else if constexpr (Column == SortColumn::COMMAND) {
+        return a.get_command().compare(b.get_command());
+    } else {
+        auto key = [](const Process& p) {
+            if constexpr (Column == SortColumn::PID) return p.get_pid();
+            else if constexpr (Column == SortColumn::MEMORY) return p.get_memory_usage();
+            else if constexpr (Column == SortColumn::CPU) return p.get_cpu_usage();
+            else if constexpr (Column == SortColumn::NETWORK) return p.get_network_usage();
+            else return p.get_cpu_time();
+        };
+        auto ka = key(a);
+        auto kb = key(b);
+        return ka < kb ? -1 : (kb < ka ? 1 : 0);
+    }
+}
+
+template <SortColumn Column, bool Ascending>
+struct RowLess {
+    const std::vector<Process>* rows;
+
+    bool operator()(uint32_t a, uint32_t b) const {
+        const Process& pa = (*rows)[a];
+        const Process& pb = (*rows)[b];
+        int order = compare_column<Column>(pa, pb);
+        if (order != 0) {
+            return Ascending ? order < 0 : order > 0;
+        }
+        return pa.get_pid() < pb.get_pid();
+    }
+};
+
+// Re-sorts an order that was sorted last tick. Between ticks only a few
+// processes change rank, so pulling those out, sorting them and merging them
+// back is O(n + k log k) instead of O(n log n). An element stays in place only
+// if it is in order with both the last kept element and its next neighbour;
+// that catches processes that moved up as well as ones that moved down.
+template <typename Less>
+static bool repair_nearly_sorted(std::vector<uint32_t>& order, Less less) {
+    std::vector<uint32_t> kept;
+    std::vector<uint32_t> displaced;
+    kept.reserve(order.size());
+
+    for (size_t i = 0; i < order.size(); i++) {
+        uint32_t idx = order[i];
+        bool after_previous = kept.empty() || !less(idx, kept.back());
+        bool before_next = i + 1 == order.size() || !less(order[i + 1], idx);
+        if (after_previous && before_next) {
+            kept.push_back(idx);
+        } else {
+            displaced.push_back(idx);
+        }
+
+        // Too much movement for a merge to pay off
+        if (displaced.size() > order.size() / 4) {
+            return false;
+        }
+    }
+
+    std::sort(displaced.begin(), displaced.end(), less);
+    std::merge(kept.begin(), kept.end(), displaced.begin(), displaced.end(), order.begin(), less);
+    return true;
+}
+
+// Calls fn with the comparator specialized for column and direction
+template <typename Fn>
+static void with_comparator(const std::vector<Process>& rows, SortColumn column, bool ascending, Fn&& fn) {
+    auto dispatch = [&]<SortColumn Column>() {
+        if (ascending) fn(RowLess<Column, true>{&rows});
+        else fn(RowLess<Column, false>{&rows});
+    };
+    switch (column) {
+        case SortColumn::PID: dispatch.template operator()<SortColumn::PID>(); break;
+        case SortColumn::NAME: dispatch.template operator()<SortColumn::NAME>(); break;
+        case SortColumn::MEMORY: dispatch.template operator()<SortColumn::MEMORY>(); break;
+        case SortColumn::CPU: dispatch.template operator()<SortColumn::CPU>(); break;
+        case SortColumn::NETWORK: dispatch.template operator()<SortColumn::NETWORK>(); break;
+        case SortColumn::TIME: dispatch.template operator()<SortColumn::TIME>(); break;
+        case SortColumn::COMMAND: dispatch.template operator()<SortColumn::COMMAND>(); break;
+    }
+}
+
+std::vector<uint32_t> SortIndex::sort(
+    const std::vector<Process>& rows,
+    SortColumn column,
+    bool ascending,
+    size_t needed
+) {
+    size_t count = rows.size();
+    needed = std::min(needed, count);
+    std::vector<uint32_t> order;
+    order.reserve(count);
+
+    bool can_repair = fully_sorted && column == previous_column && ascending == previous_ascending &&
+                      !previous_order.empty();
+    if (can_repair) {
+        // Seed with last tick's order; processes that are new go at the end
+        std::unordered_map<pid_t, uint32_t> index_by_pid;
+        index_by_pid.reserve(count);
+        for (uint32_t i = 0; i < count; i++) {
+            index_by_pid.emplace(rows[i].get_pid(), i);
+        }
+        std::vector<bool> placed(count, false);
+        for (pid_t pid : previous_order) {
+            auto it = index_by_pid.find(pid);
+            if (it != index_by_pid.end() && !placed[it->second]) {
+                placed[it->second] = true;
+                order.push_back(it->second);
+            }
+        }
+        for (uint32_t i = 0; i < count; i++) {
+            if (!placed[i]) order.push_back(i);
+        }
+    } else {
+        order.resize(count);
+        std::iota(order.begin(), order.end(), 0u);
+    }
+
+    with_comparator(rows, column, ascending, [&](auto less) {
+        if (can_repair && repair_nearly_sorted(order, less)) {
+            incremental_sorts++;
+            fully_sorted = true;
+        } else if (!can_repair && needed < count / 4) {
+            // Only the top of the table is on screen: order just that prefix
+            std::partial_sort(order.begin(), order.begin() + needed, order.end(), less);
+            partial_sorts++;
+            fully_sorted = false;
+        } else {
+            std::sort(order.begin(), order.end(), less);
+            full_sorts++;
+            fully_sorted = true;
+        }
+    });
+
+    previous_column = column;
+    previous_ascending = ascending;
+    previous_order.clear();
+    if (fully_sorted) {
+        previous_order.reserve(count);
+        for (uint32_t idx : order) {
+            previous_order.push_back(rows[idx].get_pid());
+        }
+    }
+    return order;
+}
+
+} // namespace ProcessesView
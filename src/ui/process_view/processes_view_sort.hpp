@@ -0,0 +1,48 @@
+#ifndef __PROCESSES_VIEW_SORT_HPP
+#define __PROCESSES_VIEW_SORT_HPP
+
+#include "../../processes_list/process.hpp"
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace ProcessesView {
+
+enum class SortColumn { PID, NAME, MEMORY, CPU, NETWORK, TIME, COMMAND };
+
+// Persistent sort order for the process table. The order from the previous
+// tick is kept (by pid) and repaired on the next snapshot, which is cheap
+// because most processes keep their rank between ticks. Comparators are
+// specialized per column at compile time, and ties are broken by pid so the
+// order is deterministic.
+class SortIndex {
+private:
+    std::vector<pid_t> previous_order;
+    SortColumn previous_column = SortColumn::PID;
+    bool previous_ascending = true;
+    bool fully_sorted = false;
+
+    uint64_t full_sorts = 0;
+    uint64_t incremental_sorts = 0;
+    uint64_t partial_sorts = 0;
+
+public:
+    // Returns indices into rows in display order. Only the first needed
+    // positions are guaranteed to be sorted; the rest may be in any order.
+    std::vector<uint32_t> sort(
+        const std::vector<Process>& rows,
+        SortColumn column,
+        bool ascending,
+        size_t needed = std::numeric_limits<size_t>::max()
+    );
+
+    void reset() { previous_order.clear(); fully_sorted = false; }
+
+    uint64_t get_full_sorts() const { return full_sorts; }
+    uint64_t get_incremental_sorts() const { return incremental_sorts; }
+    uint64_t get_partial_sorts() const { return partial_sorts; }
+};
+
+} // namespace ProcessesView
+
+#endif
@@ -7,13 +7,17 @@
 #include <chrono>
 #include "ftxui/screen/box.hpp"
 #include "../../processes_list/process.hpp"
+#include "../../processes_list/process_filter.hpp"
+#include "../../processes_list/signal_batch.hpp"
+#include "../../metrics/time_series.hpp"
+#include "processes_view_row_cache.hpp"
+#include "processes_view_sort.hpp"
+#include "processes_view_search.hpp"
 
 using namespace ftxui;
 
 namespace ProcessesView {
 
-enum class SortColumn { PID, NAME, MEMORY, CPU, NETWORK, TIME, COMMAND };
-
 // Shared state structure for the processes view
 struct ViewState {
     // Constants
@@ -27,35 +31,54 @@ struct ViewState {
     static constexpr int COL_NETWORK_WIDTH = 12;
     static constexpr int COL_TIME_WIDTH = 12;
     static constexpr int HISTORY_SIZE = 60;
+    // Rows built past the bottom of the viewport, covering a terminal that grew
+    // since the viewport was last measured
+    static constexpr int OVERSCAN_ROWS = 4;
 
     // Selection and interaction state
     std::shared_ptr<int> selected_index;
     std::shared_ptr<int> hover_index;
     std::shared_ptr<int> hover_sigterm;
     std::shared_ptr<int> hover_sigkill;
+    // Rows tagged for a batch signal (Space, 'a' for all matches, 's' for a subtree)
+    std::shared_ptr<ProcessSelection> selection;
 
     // Search state
     std::shared_ptr<bool> search_mode;
     std::shared_ptr<std::string> search_phrase;
+    std::shared_ptr<SearchIndex> search_index;
+    // Structured filter compiled from search_phrase (e.g. "cpu>20 name~^java")
+    std::shared_ptr<ProcessFilter> filter;
+    std::shared_ptr<std::string> filter_query;
+    std::shared_ptr<bool> filter_active;
 
     // Sort state
     std::shared_ptr<SortColumn> sort_column;
     std::shared_ptr<bool> sort_ascending;
+    std::shared_ptr<SortIndex> sort_index;
 
-    // Detail view state
+    // Detail view state. The last couple of minutes come straight from the
+    // collector's per-pid history; the minute and hour roll-ups are built from
+    // those samples while the view is open.
     std::shared_ptr<bool> show_detail_view;
     std::shared_ptr<pid_t> detail_process_pid;
-    std::shared_ptr<std::vector<float>> cpu_history;
-    std::shared_ptr<std::vector<float>> memory_history;
-    std::shared_ptr<std::vector<float>> network_history;
-    std::shared_ptr<std::chrono::steady_clock::time_point> last_sample_time;
+    std::shared_ptr<TimeSeries<float>> cpu_history;
+    std::shared_ptr<TimeSeries<float>> memory_history;
+    std::shared_ptr<TimeSeries<float>> network_history;
+    std::shared_ptr<Resolution> history_resolution;
+    std::shared_ptr<uint64_t> history_samples_seen;
+    std::shared_ptr<int> inspection_section; // InspectionSection shown in the detail view
 
     // Click tracking for double-click detection
     std::shared_ptr<std::chrono::steady_clock::time_point> last_click_time;
     std::shared_ptr<int> last_clicked_index;
 
-    // Display tracking
+    // Display tracking. Only the visible window of rows is built: displayed_pids
+    // and the row boxes are relative to first_visible_index.
     std::shared_ptr<std::vector<pid_t>> displayed_pids;
+    std::shared_ptr<int> first_visible_index;
+    std::shared_ptr<Box> table_box;
+    std::shared_ptr<RowCellCache> row_cache;
 
     // Bounding boxes for mouse interaction
     std::shared_ptr<std::vector<Box>> boxes;
@@ -74,19 +97,30 @@ struct ViewState {
         hover_index = std::make_shared<int>(-1);
         hover_sigterm = std::make_shared<int>(-1);
         hover_sigkill = std::make_shared<int>(-1);
+        selection = std::make_shared<ProcessSelection>();
         search_mode = std::make_shared<bool>(false);
         search_phrase = std::make_shared<std::string>("");
+        search_index = std::make_shared<SearchIndex>();
+        filter = std::make_shared<ProcessFilter>();
+        filter_query = std::make_shared<std::string>("");
+        filter_active = std::make_shared<bool>(false);
         sort_column = std::make_shared<SortColumn>(SortColumn::CPU);
         sort_ascending = std::make_shared<bool>(false);
+        sort_index = std::make_shared<SortIndex>();
         show_detail_view = std::make_shared<bool>(false);
         detail_process_pid = std::make_shared<pid_t>(0);
-        cpu_history = std::make_shared<std::vector<float>>();
-        memory_history = std::make_shared<std::vector<float>>();
-        network_history = std::make_shared<std::vector<float>>();
-        last_sample_time = std::make_shared<std::chrono::steady_clock::time_point>(std::chrono::steady_clock::now());
+        cpu_history = std::make_shared<TimeSeries<float>>(HISTORY_SIZE);
+        memory_history = std::make_shared<TimeSeries<float>>(HISTORY_SIZE);
+        network_history = std::make_shared<TimeSeries<float>>(HISTORY_SIZE);
+        history_resolution = std::make_shared<Resolution>(Resolution::SECONDS);
+        history_samples_seen = std::make_shared<uint64_t>(0);
+        inspection_section = std::make_shared<int>(0);
         last_click_time = std::make_shared<std::chrono::steady_clock::time_point>(std::chrono::steady_clock::now());
         last_clicked_index = std::make_shared<int>(-1);
         displayed_pids = std::make_shared<std::vector<pid_t>>();
+        first_visible_index = std::make_shared<int>(0);
+        table_box = std::make_shared<Box>();
+        row_cache = std::make_shared<RowCellCache>();
         boxes = std::make_shared<std::vector<Box>>();
         sigterm_boxes = std::make_shared<std::vector<Box>>();
         sigkill_boxes = std::make_shared<std::vector<Box>>();
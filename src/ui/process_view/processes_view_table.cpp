@@ -1,74 +1,132 @@
 #include "processes_view_table.hpp"
 #include <algorithm>
-#include <sstream>
-#include <iomanip>
+#include "ftxui/screen/terminal.hpp"
 
 namespace ProcessesView {
 
+// Recompiles the structured filter only when the search phrase changes
+static void update_filter(const ViewState& state) {
+    if (*state.filter_query == *state.search_phrase) {
+        return;
+    }
+    *state.filter_query = *state.search_phrase;
+    *state.filter_active = ProcessFilter::looks_like_filter(*state.search_phrase);
+    if (*state.filter_active) {
+        state.filter->compile(*state.search_phrase);
+    }
+}
+
 std::vector<Process> prepare_process_list(
-    const std::vector<Process>& processes,
-    const ViewState& state
+    std::vector<Process>&& processes,
+    const ViewState& state,
+    size_t needed_rows
 ) {
-    std::vector<Process> processes_copy = processes;
-
-    if (processes_copy.size() > 0 && processes_copy.size() < 10000) {
-        SortColumn current_sort = *state.sort_column;
-        bool ascending = *state.sort_ascending;
-
-        std::stable_sort(processes_copy.begin(), processes_copy.end(),
-            [current_sort, ascending](const Process& a, const Process& b) {
-                switch (current_sort) {
-                    case SortColumn::PID:
-                        return ascending ? (a.get_pid() < b.get_pid()) : (a.get_pid() > b.get_pid());
-                    case SortColumn::NAME:
-                        return ascending ? (a.get_process_name() < b.get_process_name()) : (a.get_process_name() > b.get_process_name());
-                    case SortColumn::MEMORY:
-                        return ascending ? (a.get_memory_usage() < b.get_memory_usage()) : (a.get_memory_usage() > b.get_memory_usage());
-                    case SortColumn::CPU:
-                        return ascending ? (a.get_cpu_usage() < b.get_cpu_usage()) : (a.get_cpu_usage() > b.get_cpu_usage());
-                    case SortColumn::NETWORK:
-                        return ascending ? (a.get_network_usage() < b.get_network_usage()) : (a.get_network_usage() > b.get_network_usage());
-                    case SortColumn::TIME:
-                        return ascending ? (a.get_cpu_time() < b.get_cpu_time()) : (a.get_cpu_time() > b.get_cpu_time());
-                    case SortColumn::COMMAND:
-                        return ascending ? (a.get_command() < b.get_command()) : (a.get_command() > b.get_command());
-                    default:
-                        return false;
+    // Filter first so only the matches get sorted
+    update_filter(state);
+    if (!state.search_phrase->empty()) {
+        std::vector<Process> matches;
+        if (*state.filter_active) {
+            // A filter that fails to parse matches nothing; the error is shown in the search bar
+            if (state.filter->get_error().empty()) {
+                for (auto& proc : processes) {
+                    if (state.filter->matches(proc)) {
+                        matches.push_back(std::move(proc));
+                    }
                 }
-            });
+            }
+        } else {
+            state.search_index->update(processes);
+            for (uint32_t idx : state.search_index->search(*state.search_phrase)) {
+                matches.push_back(std::move(processes[idx]));
+            }
+        }
+        processes = std::move(matches);
     }
 
-    if (!state.search_phrase->empty()) {
-        std::string search_lower = *state.search_phrase;
-        std::transform(search_lower.begin(), search_lower.end(), search_lower.begin(), ::tolower);
+    std::vector<uint32_t> order = state.sort_index->sort(processes, *state.sort_column, *state.sort_ascending, needed_rows);
+
+    std::vector<Process> processes_copy;
+    processes_copy.reserve(processes.size());
+    for (uint32_t idx : order) {
+        processes_copy.push_back(std::move(processes[idx]));
+    }
+    return processes_copy;
+}
 
-        processes_copy.erase(
-            std::remove_if(processes_copy.begin(), processes_copy.end(),
-                [&search_lower](const Process& proc) {
-                    std::string name_lower = proc.get_process_name();
-                    std::transform(name_lower.begin(), name_lower.end(), name_lower.begin(), ::tolower);
+std::vector<Process> prepare_process_list(
+    const std::vector<Process>& processes,
+    const ViewState& state,
+    size_t needed_rows
+) {
+    return prepare_process_list(std::vector<Process>(processes), state, needed_rows);
+}
 
-                    std::string pid_str = std::to_string(proc.get_pid());
+TableWindow compute_table_window(int total, int selected_index, int first_visible, int viewport_rows, int overscan) {
+    viewport_rows = std::max(1, viewport_rows);
 
-                    return name_lower.find(search_lower) == std::string::npos &&
-                           pid_str.find(search_lower) == std::string::npos;
-                }
-            ),
-            processes_copy.end()
-        );
+    if (selected_index < first_visible) {
+        first_visible = selected_index;
+    } else if (selected_index >= first_visible + viewport_rows) {
+        first_visible = selected_index - viewport_rows + 1;
     }
+    // Don't leave empty space at the bottom when the list shrinks
+    first_visible = std::clamp(first_visible, 0, std::max(0, total - viewport_rows));
 
-    return processes_copy;
+    TableWindow window;
+    window.first = first_visible;
+    window.end = std::min(total, first_visible + viewport_rows + std::max(0, overscan));
+    return window;
+}
+
+// Scrollbar sized to the viewport whose thumb reflects the position in the full list
+static Element create_scrollbar(int total, int first_visible, int viewport_rows) {
+    if (total <= viewport_rows) {
+        return text("");
+    }
+
+    int thumb_size = std::max(1, viewport_rows * viewport_rows / total);
+    int thumb_start = static_cast<int>(static_cast<long long>(first_visible) * (viewport_rows - thumb_size) /
+                                       std::max(1, total - viewport_rows));
+
+    Elements cells;
+    for (int row = 0; row < viewport_rows; row++) {
+        bool in_thumb = row >= thumb_start && row < thumb_start + thumb_size;
+        cells.push_back(text(in_thumb ? "┃" : "│") | (in_thumb ? color(Color::White) : color(Color::GrayDark)));
+    }
+    return vbox(cells);
+}
+
+// Viewport height comes from the list's box in the previous frame; before the
+// first frame, estimate it from the terminal height minus the surrounding chrome.
+static int get_viewport_rows(const ViewState& state) {
+    int viewport_rows = state.table_box->y_max - state.table_box->y_min + 1;
+    if (viewport_rows <= 1) {
+        viewport_rows = std::max(1, Terminal::Size().dimy - 10);
+    }
+    return viewport_rows;
+}
+
+size_t compute_needed_rows(const ViewState& state) {
+    return static_cast<size_t>(std::max(*state.first_visible_index, *state.selected_index)) +
+           get_viewport_rows(state) + ViewState::OVERSCAN_ROWS;
 }
 
 Element create_process_table(
     const std::vector<Process>& processes,
     ViewState& state
+) {
+    return render_process_table(prepare_process_list(processes, state, compute_needed_rows(state)), state);
+}
+
+Element render_process_table(
+    const std::vector<Process>& processes_copy,
+    ViewState& state
 ) {
     state.boxes->clear();
     state.sigterm_boxes->clear();
     state.sigkill_boxes->clear();
-    std::vector<Process> processes_copy = prepare_process_list(processes, state);
+
+    int viewport_rows = get_viewport_rows(state);
 
     if (*state.selected_index >= static_cast<int>(processes_copy.size())) {
         *state.selected_index = std::max(0, static_cast<int>(processes_copy.size()) - 1);
@@ -106,76 +164,92 @@ Element create_process_table(
 
     rows.push_back(separator());
 
-    state.boxes->resize(processes_copy.size());
-    state.sigterm_boxes->resize(processes_copy.size());
-    state.sigkill_boxes->resize(processes_copy.size());
-    state.displayed_pids->resize(processes_copy.size());
+    int total = static_cast<int>(processes_copy.size());
+    TableWindow window = compute_table_window(total, *state.selected_index, *state.first_visible_index,
+                                              viewport_rows, ViewState::OVERSCAN_ROWS);
+    *state.first_visible_index = window.first;
+
+    size_t window_size = static_cast<size_t>(window.end - window.first);
+    state.boxes->resize(window_size);
+    state.sigterm_boxes->resize(window_size);
+    state.sigkill_boxes->resize(window_size);
+    state.displayed_pids->resize(window_size);
 
-    for (size_t i = 0; i < processes_copy.size(); i++) {
+    std::vector<Element> list_rows;
+    list_rows.reserve(window_size);
+    state.row_cache->begin_frame();
+
+    for (int i = window.first; i < window.end; i++) {
         const auto& proc = processes_copy[i];
-        (*state.displayed_pids)[i] = proc.get_pid();
-        std::stringstream pid_ss, mem_ss, cpu_ss, net_ss, time_ss;
-        pid_ss << proc.get_pid();
-        mem_ss << std::fixed << std::setprecision(2) << (proc.get_memory_usage() / 1024.0);
-        cpu_ss << std::fixed << std::setprecision(2) << proc.get_cpu_usage();
-        net_ss << proc.get_network_usage();
-
-        unsigned long time_seconds = proc.get_cpu_time();
-        unsigned long hours = time_seconds / 3600;
-        unsigned long minutes = (time_seconds % 3600) / 60;
-        unsigned long seconds = time_seconds % 60;
-        time_ss << hours << ":" << std::setfill('0') << std::setw(2) << minutes << ":" << std::setw(2) << seconds;
+        size_t slot = static_cast<size_t>(i - window.first);
+        (*state.displayed_pids)[slot] = proc.get_pid();
+        const FormattedRow& cells = state.row_cache->get(proc);
 
         Element sigterm_btn = text("x") | color(Color::Red);
-        if (static_cast<int>(i) == *state.hover_sigterm) {
+        if (i == *state.hover_sigterm) {
             sigterm_btn = sigterm_btn | bgcolor(Color::White) | bold;
         }
-        sigterm_btn = sigterm_btn | size(WIDTH, EQUAL, ViewState::COL_SIGTERM_WIDTH) | reflect((*state.sigterm_boxes)[i]);
+        sigterm_btn = sigterm_btn | size(WIDTH, EQUAL, ViewState::COL_SIGTERM_WIDTH) | reflect((*state.sigterm_boxes)[slot]);
 
         Element sigkill_btn = text("☠ ") | color(Color::RedLight);
-        if (static_cast<int>(i) == *state.hover_sigkill) {
+        if (i == *state.hover_sigkill) {
             sigkill_btn = sigkill_btn | bgcolor(Color::White) | bold;
         }
-        sigkill_btn = sigkill_btn | size(WIDTH, EQUAL, ViewState::COL_SIGKILL_WIDTH) | reflect((*state.sigkill_boxes)[i]);
+        sigkill_btn = sigkill_btn | size(WIDTH, EQUAL, ViewState::COL_SIGKILL_WIDTH) | reflect((*state.sigkill_boxes)[slot]);
 
         auto row = hbox({
             sigterm_btn,
             text(" "),
             sigkill_btn,
             separator(),
-            text(pid_ss.str()) | size(WIDTH, EQUAL, ViewState::COL_PID_WIDTH),
+            text(cells.pid_text) | size(WIDTH, EQUAL, ViewState::COL_PID_WIDTH),
             separator(),
             text(proc.get_process_name()) | size(WIDTH, EQUAL, ViewState::COL_NAME_WIDTH),
             separator(),
-            text(mem_ss.str()) | size(WIDTH, EQUAL, ViewState::COL_MEMORY_WIDTH),
+            text(cells.memory_text) | size(WIDTH, EQUAL, ViewState::COL_MEMORY_WIDTH),
             separator(),
-            text(cpu_ss.str()) | size(WIDTH, EQUAL, ViewState::COL_CPU_WIDTH),
+            text(cells.cpu_text) | size(WIDTH, EQUAL, ViewState::COL_CPU_WIDTH),
             separator(),
-            text(net_ss.str()) | size(WIDTH, EQUAL, ViewState::COL_NETWORK_WIDTH),
+            text(cells.network_text) | size(WIDTH, EQUAL, ViewState::COL_NETWORK_WIDTH),
             separator(),
-            text(time_ss.str()) | size(WIDTH, EQUAL, ViewState::COL_TIME_WIDTH),
+            text(cells.time_text) | size(WIDTH, EQUAL, ViewState::COL_TIME_WIDTH),
             separator(),
             text(proc.get_command()) | flex,
         });
 
-        if (static_cast<int>(i) == *state.selected_index) {
-            row = row | bgcolor(Color::Blue) | bold | focus;
-        } else if (static_cast<int>(i) == *state.hover_index) {
+        // Tagged for a batch signal
+        if (state.selection->contains(proc.get_pid())) {
+            row = row | color(Color::Yellow) | bold;
+        }
+
+        if (i == *state.selected_index) {
+            row = row | bgcolor(Color::Blue) | bold;
+        } else if (i == *state.hover_index) {
             row = row | bgcolor(Color::GrayDark);
         }
 
-        row = row | reflect((*state.boxes)[i]);
-        rows.push_back(row);
+        row = row | reflect((*state.boxes)[slot]);
+        list_rows.push_back(row);
     }
 
-    auto process_list = vbox(rows) | vscroll_indicator | yframe | flex;
+    // The window starts at the top of the frame, so overscan rows simply get clipped
+    auto list_body = hbox({
+        vbox(list_rows) | yframe | flex | reflect(*state.table_box),
+        create_scrollbar(total, window.first, viewport_rows),
+    }) | flex;
+    rows.push_back(list_body);
+
+    auto process_list = vbox(rows) | flex;
 
     if (*state.search_mode || !state.search_phrase->empty()) {
         std::string search_display = "/" + *state.search_phrase;
         if (*state.search_mode) {
             search_display += "_";
         }
-        auto search_bar = text(search_display) | color(Color::Yellow) | bold;
+        Element search_bar = text(search_display) | color(Color::Yellow) | bold;
+        if (*state.filter_active && !state.filter->get_error().empty()) {
+            search_bar = hbox({search_bar, text("  " + state.filter->get_error()) | color(Color::Red)});
+        }
         return vbox({
             process_list,
             separator(),
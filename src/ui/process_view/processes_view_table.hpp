@@ -6,23 +6,50 @@
 #include "processes_view_state.hpp"
 #include <vector>
 #include <mutex>
+#include <limits>
 
 using namespace ftxui;
 
 namespace ProcessesView {
 
-// Sort and filter processes according to the view state
+// Sort and filter processes according to the view state. Only the first
+// needed_rows entries are guaranteed to be in order.
 std::vector<Process> prepare_process_list(
     const std::vector<Process>& processes,
-    const ViewState& state
+    const ViewState& state,
+    size_t needed_rows = std::numeric_limits<size_t>::max()
 );
+std::vector<Process> prepare_process_list(
+    std::vector<Process>&& processes,
+    const ViewState& state,
+    size_t needed_rows = std::numeric_limits<size_t>::max()
+);
+
+// Rows that must be in sorted order to fill the window at its current scroll position
+size_t compute_needed_rows(const ViewState& state);
+
+// Range of rows [first, end) to build for a list of total rows
+struct TableWindow {
+    int first = 0;
+    int end = 0;
+};
 
-// Create the process table UI element
+// Scrolls the previous window just enough to keep selected_index visible in a
+// viewport of viewport_rows, then extends it by overscan rows.
+TableWindow compute_table_window(int total, int selected_index, int first_visible, int viewport_rows, int overscan);
+
+// Create the process table UI element. Only the rows in the viewport are built.
 Element create_process_table(
     const std::vector<Process>& processes,
     ViewState& state
 );
 
+// Same, for rows that were already filtered and sorted by prepare_process_list
+Element render_process_table(
+    const std::vector<Process>& processes_copy,
+    ViewState& state
+);
+
 } // namespace ProcessesView
 
 #endif
@@ -0,0 +1,15 @@
+#include "redraw_filter.hpp"
+
+bool RedrawFilter::needs_frame(Event event)
+{
+    if (event == Event::Custom)
+        return false;
+    if (!event.is_mouse())
+        return true;
+
+    const Mouse &mouse = event.mouse();
+    bool same_position = mouse.x == this->last_mouse_x && mouse.y == this->last_mouse_y;
+    this->last_mouse_x = mouse.x;
+    this->last_mouse_y = mouse.y;
+    return !(same_position && mouse.motion == Mouse::Moved && mouse.button == Mouse::None);
+}
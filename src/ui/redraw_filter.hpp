@@ -0,0 +1,23 @@
+#ifndef __REDRAW_FILTER_HPP
+#define __REDRAW_FILTER_HPP
+
+#include "ftxui/component/event.hpp"
+
+using namespace ftxui;
+
+// Decides which input events the UI rebuilds its frame for. Handlers are not
+// asked: a terminal resize is handled by nobody, and FTXUI widgets change
+// their hover state without reporting the event as handled. So every event
+// counts except the FramePacer's own Custom redraws and mouse motion reports
+// that repeat the last pointer position.
+class RedrawFilter
+{
+private:
+    int last_mouse_x = -1;
+    int last_mouse_y = -1;
+
+public:
+    bool needs_frame(Event event);
+};
+
+#endif /* __REDRAW_FILTER_HPP */
@@ -0,0 +1,79 @@
+#include "self_monitor_view.hpp"
+#include <cstdio>
+#include <string>
+
+static std::string format_micros(double micros)
+{
+    char s[32];
+    if (micros >= 10000.0)
+        snprintf(s, sizeof(s), "%.1f ms", micros / 1000.0);
+    else
+        snprintf(s, sizeof(s), "%.0f us", micros);
+    return s;
+}
+
+static Element cell(const std::string &value, int width)
+{
+    return text(value) | size(WIDTH, EQUAL, width);
+}
+
+Element create_self_monitor_overlay(const SelfUsage &usage,
+                                    const SelfMonitor &monitor,
+                                    const std::vector<CollectorStats> &collector_stats,
+                                    double collector_overhead_percent,
+                                    int interval_scale,
+                                    const FrameStats &frame_stats)
+{
+    char s[128];
+    Elements rows;
+
+    // Binary units, like the process table and the alert log
+    snprintf(s, sizeof(s), "CPU %.1f%%   RSS %.1f MiB   %.0f allocations/tick",
+             usage.cpu_percent, usage.rss_kb / 1024.0, usage.allocations_per_tick);
+    rows.push_back(text(s) | bold);
+    snprintf(s, sizeof(s), "Collectors %.2f%% CPU, intervals x%d", collector_overhead_percent, interval_scale);
+    rows.push_back(text(s));
+    rows.push_back(separator());
+
+    // Latencies are recorded in nanoseconds
+    rows.push_back(hbox({cell("Stage", 18), cell("Count", 10), cell("p50", 10), cell("p99", 10), cell("Max", 10)}) | bold);
+    for (size_t i = 0; i < STAGE_COUNT; i++)
+    {
+        Stage stage = static_cast<Stage>(i);
+        const LatencyHistogram &histogram = monitor.get_histogram(stage);
+        if (histogram.count() == 0)
+            continue;
+        rows.push_back(hbox({
+            cell(stage_name(stage), 18),
+            cell(std::to_string(histogram.count()), 10),
+            cell(format_micros(histogram.percentile(50) / 1000.0), 10),
+            cell(format_micros(histogram.percentile(99) / 1000.0), 10),
+            cell(format_micros(histogram.max() / 1000.0), 10),
+        }));
+    }
+    rows.push_back(separator());
+
+    rows.push_back(hbox({cell("Collector", 18), cell("Runs", 10), cell("Avg", 10), cell("Max", 10), cell("Missed", 10)}) | bold);
+    for (const auto &stats : collector_stats)
+    {
+        rows.push_back(hbox({
+            cell(stats.name, 18),
+            cell(std::to_string(stats.runs), 10),
+            cell(format_micros(stats.average_runtime().count()), 10),
+            cell(format_micros(stats.max_runtime.count()), 10),
+            cell(std::to_string(stats.missed_ticks), 10),
+        }));
+    }
+    rows.push_back(separator());
+
+    snprintf(s, sizeof(s), "Frames %llu built, %llu reused, %llu dropped, %llu late",
+             static_cast<unsigned long long>(frame_stats.frames),
+             static_cast<unsigned long long>(frame_stats.reused_frames),
+             static_cast<unsigned long long>(frame_stats.dropped_frames),
+             static_cast<unsigned long long>(frame_stats.late_frames));
+    rows.push_back(text(s));
+    rows.push_back(text("Frame time avg " + format_micros(frame_stats.average_frame_time().count()) +
+                        ", max " + format_micros(frame_stats.max_frame_time.count())));
+
+    return window(text(" Houston overhead (F2) "), vbox(rows));
+}
@@ -0,0 +1,21 @@
+#ifndef __SELF_MONITOR_VIEW_HPP
+#define __SELF_MONITOR_VIEW_HPP
+
+#include "ftxui/dom/elements.hpp"
+#include "../collectors/collector.hpp"
+#include "../metrics/self_monitor.hpp"
+#include "frame_pacer.hpp"
+#include <vector>
+
+using namespace ftxui;
+
+// What Houston itself costs: its CPU, RSS and allocations, latency
+// percentiles per collection stage, scheduler accounting and frame timing
+Element create_self_monitor_overlay(const SelfUsage &usage,
+                                    const SelfMonitor &monitor,
+                                    const std::vector<CollectorStats> &collector_stats,
+                                    double collector_overhead_percent,
+                                    int interval_scale,
+                                    const FrameStats &frame_stats);
+
+#endif /* __SELF_MONITOR_VIEW_HPP */
@@ -0,0 +1,121 @@
+#include "cpu_heatmap_view.hpp"
+#include "ftxui/dom/node.hpp"
+#include "ftxui/screen/screen.hpp"
+#include <algorithm>
+#include <array>
+
+HeatmapColumns::HeatmapColumns(size_t capacity)
+    : capacity(capacity == 0 ? 1 : capacity)
+{
+}
+
+Color HeatmapColumns::sample_color(uint8_t sample)
+{
+    // Quantized samples map to a fixed palette built once: dark blue at idle
+    // through green and yellow to red at 100%
+    static const std::array<Color, CoreHistory::FULL_SCALE + 1> palette = []
+    {
+        std::array<Color, CoreHistory::FULL_SCALE + 1> colors;
+        for (size_t i = 0; i < colors.size(); i++)
+        {
+            float level = static_cast<float>(i) / CoreHistory::FULL_SCALE;
+            if (level < 0.5f)
+                colors[i] = Color::Interpolate(level * 2.0f, Color::RGB(16, 24, 64), Color::RGB(32, 192, 64));
+            else
+                colors[i] = Color::Interpolate((level - 0.5f) * 2.0f, Color::RGB(32, 192, 64), Color::RGB(224, 32, 32));
+        }
+        return colors;
+    }();
+
+    if (sample > CoreHistory::FULL_SCALE)
+        return Color::GrayDark;
+    return palette[sample];
+}
+
+size_t HeatmapColumns::update(const CoreHistory &history)
+{
+    CoreHistoryUpdate update = history.get_since(this->next_sequence);
+
+    // New cores (hotplug) change the column layout: start over from everything held
+    if (update.core_count != this->core_count)
+    {
+        update = history.get_since(0);
+        this->core_count = update.core_count;
+        this->colors.assign(this->capacity * this->core_count, Color::GrayDark);
+        this->head = 0;
+        this->count = 0;
+    }
+
+    size_t columns = this->core_count == 0 ? 0 : update.samples.size() / this->core_count;
+    // Only the newest capacity columns can be shown anyway
+    size_t skip = columns > this->capacity ? columns - this->capacity : 0;
+    for (size_t i = skip; i < columns; i++)
+    {
+        Color *column = this->colors.data() + this->head * this->core_count;
+        const uint8_t *samples = update.samples.data() + i * this->core_count;
+        for (size_t core = 0; core < this->core_count; core++)
+            column[core] = sample_color(samples[core]);
+        this->head = (this->head + 1) % this->capacity;
+        this->count = std::min(this->count + 1, this->capacity);
+    }
+    this->next_sequence = update.total_columns;
+    return columns - skip;
+}
+
+const Color &HeatmapColumns::at(size_t index, size_t core) const
+{
+    size_t start = (this->head + this->capacity - this->count) % this->capacity;
+    return this->colors[((start + index) % this->capacity) * this->core_count + core];
+}
+
+namespace
+{
+class HeatmapNode : public Node
+{
+private:
+    std::shared_ptr<const HeatmapColumns> columns;
+
+public:
+    explicit HeatmapNode(std::shared_ptr<const HeatmapColumns> columns)
+        : columns(std::move(columns))
+    {
+    }
+
+    void ComputeRequirement() override
+    {
+        this->requirement_.min_x = 1;
+        this->requirement_.min_y = static_cast<int>((this->columns->get_core_count() + 1) / 2);
+        this->requirement_.flex_grow_x = 1;
+        this->requirement_.flex_shrink_x = 1;
+    }
+
+    void Render(Screen &screen) override
+    {
+        int width = this->box_.x_max - this->box_.x_min + 1;
+        int height = this->box_.y_max - this->box_.y_min + 1;
+        if (width <= 0 || height <= 0)
+            return;
+
+        size_t core_count = this->columns->get_core_count();
+        size_t shown = std::min(static_cast<size_t>(width), this->columns->size());
+        size_t first = this->columns->size() - shown;
+        int x = this->box_.x_max - static_cast<int>(shown) + 1;
+        for (size_t index = first; index < this->columns->size(); index++, x++)
+        {
+            // Upper half block: foreground is the even core, background the odd one
+            for (size_t core = 0; core < core_count && static_cast<int>(core / 2) < height; core += 2)
+            {
+                Pixel &pixel = screen.PixelAt(x, this->box_.y_min + static_cast<int>(core / 2));
+                pixel.character = "▀";
+                pixel.foreground_color = this->columns->at(index, core);
+                pixel.background_color = core + 1 < core_count ? this->columns->at(index, core + 1) : Color::Default;
+            }
+        }
+    }
+};
+} // namespace
+
+Element cpu_heatmap(std::shared_ptr<const HeatmapColumns> columns)
+{
+    return std::make_shared<HeatmapNode>(std::move(columns));
+}
@@ -0,0 +1,49 @@
+#ifndef __CPU_HEATMAP_VIEW_HPP
+#define __CPU_HEATMAP_VIEW_HPP
+
+#include "ftxui/dom/elements.hpp"
+#include "ftxui/screen/color.hpp"
+#include "../../metrics/core_history.hpp"
+#include <memory>
+#include <vector>
+
+using namespace ftxui;
+
+// Colours of the heatmap columns already drawn, kept between frames. update()
+// only converts the columns pushed since the previous call, so a frame costs
+// copying the cached colours to the screen rather than recolouring the map.
+class HeatmapColumns
+{
+private:
+    size_t capacity;
+    size_t core_count = 0;
+    std::vector<Color> colors; // capacity columns of core_count colours
+    size_t head = 0;
+    size_t count = 0;
+    uint64_t next_sequence = 0;
+
+public:
+    explicit HeatmapColumns(size_t capacity);
+
+    static Color sample_color(uint8_t sample);
+
+    // Pulls new columns from history; returns how many were converted
+    size_t update(const CoreHistory &history);
+
+    size_t get_core_count() const
+    {
+        return this->core_count;
+    }
+    size_t size() const
+    {
+        return this->count;
+    }
+    // Colour of a core in the column at index, 0 being the oldest held
+    const Color &at(size_t index, size_t core) const;
+};
+
+// Cores top to bottom (two per row, using half blocks), time left to right
+// with the newest column at the right edge. Expands to the available width.
+Element cpu_heatmap(std::shared_ptr<const HeatmapColumns> columns);
+
+#endif /* __CPU_HEATMAP_VIEW_HPP */
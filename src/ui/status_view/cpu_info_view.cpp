@@ -1,31 +1,169 @@
 #include "cpu_info_view.hpp"
+#include "cpu_heatmap_view.hpp"
+#include <algorithm>
+
+// Renders a frequency history as a one-line bar sparkline scaled between lo and hi
+static std::string frequency_sparkline(const std::vector<double> &history, double lo, double hi)
+{
+    static const char *levels[] = {"▁", "▂", "▃", "▄", "▅", "▆", "▇", "█"};
+    std::string line;
+    double range = hi - lo;
+    for (double mhz : history)
+    {
+        int level = range > 0.0 ? static_cast<int>(((mhz - lo) / range) * 7.0 + 0.5) : 0;
+        line += levels[std::clamp(level, 0, 7)];
+    }
+    return line;
+}
+
+// One row of the per-thread list: utilization, clock speed and frequency history
+static Element render_core_row(const CoreMetrics &core, const std::vector<CoreFrequency> &core_frequencies)
+{
+    char buffer[32];
+    if (core.utilization < 0.0)
+        snprintf(buffer, sizeof(buffer), "CPU%d:     --  ", core.cpu_id);
+    else
+        snprintf(buffer, sizeof(buffer), "CPU%d: %6.2f%%", core.cpu_id, core.utilization);
+
+    auto freq_it = std::find_if(core_frequencies.begin(), core_frequencies.end(),
+                                [&core](const CoreFrequency &frequency) { return frequency.cpu_id == core.cpu_id; });
+    if (freq_it == core_frequencies.end())
+        return text(std::string(buffer));
+
+    // Scale to the hardware range when cpufreq reports it, otherwise to the observed range
+    std::vector<double> history = freq_it->history_mhz.values(Resolution::SECONDS);
+    double lo = freq_it->min_mhz;
+    double hi = freq_it->max_mhz;
+    if (hi <= lo && !history.empty())
+    {
+        auto [min_it, max_it] = std::minmax_element(history.begin(), history.end());
+        lo = *min_it;
+        hi = *max_it;
+    }
+
+    char freq_buffer[32];
+    snprintf(freq_buffer, sizeof(freq_buffer), "%7.0f MHz", freq_it->current_mhz);
+    auto freq_text = text(std::string(freq_buffer));
+    if (freq_it->throttled)
+        freq_text = freq_text | color(Color::Red);
+
+    return hbox({text(std::string(buffer)),
+                 text("  "),
+                 freq_text,
+                 text(freq_it->throttled ? " T " : "   ") | color(Color::Red) | bold,
+                 text(frequency_sparkline(history, lo, hi)) | color(Color::Cyan)});
+}
 
 Component create_cpu_info_view(
-    const std::vector<double *> &core_utilizations,
+    std::function<std::vector<CoreMetrics>()> get_core_metrics,
+    std::atomic<bool> *cpuset_only,
+    std::function<std::vector<CoreFrequency>()> get_core_frequencies,
+    const CpuTopology *topology,
+    const CoreHistory *core_history,
     const double *max_clock_speed_mhz,
     const double *overall_utilization,
-    const int logical_core_count,
+    const int *logical_core_count,
     const int *process_count,
     const int *thread_count,
     const std::string &cpu_model)
 {
-    // Plain bars component (no yframe / vscroll here)
-    std::vector<Component> per_core_components;
-    for (int i = 0; i < core_utilizations.size(); i++)
+    // Rows are rebuilt from a snapshot every frame so CPUs coming online or
+    // going offline (or a cpuset change) show up without recreating the view.
+    auto core_outputs = Renderer([get_core_metrics, get_core_frequencies]
+                                 {
+                                     Elements rows;
+                                     std::vector<CoreFrequency> core_frequencies = get_core_frequencies();
+                                     for (const auto &core : get_core_metrics())
+                                         rows.push_back(render_core_row(core, core_frequencies));
+                                     return vbox(rows); });
+
+    // Topology level the per-core list is collapsed to, or the heatmap over time
+    auto level_labels = std::make_shared<std::vector<std::string>>(std::vector<std::string>{"Threads", "Cores", "NUMA Nodes", "Sockets", "Heatmap"});
+    auto level_selected = std::make_shared<int>(0);
+    auto level_toggle = Toggle(level_labels.get(), level_selected.get());
+    // The checkbox edits its own copy; the collector thread only sees the atomic
+    auto cpuset_checked = std::make_shared<bool>(cpuset_only->load());
+    CheckboxOption cpuset_option = CheckboxOption::Simple();
+    cpuset_option.on_change = [cpuset_only, cpuset_checked]
+    { cpuset_only->store(*cpuset_checked); };
+    auto cpuset_checkbox = Checkbox("Only CPUs in this cpuset", cpuset_checked.get(), cpuset_option);
+
+    auto grouped_outputs = [get_core_metrics, topology, level_selected]
     {
-        // Capture a *local copy* of the double pointer (util_ptr) and the core index (i).
-        // The pointer itself won't change, but the value it points to will.
-        double *util_ptr = core_utilizations[i];
-        per_core_components.push_back(Renderer([i, util_ptr]
-                                               {
-                                                     // Dereference the pointer inside the lambda.
-                                                     double current_utilization = *util_ptr;
-                                                     char buffer[32];
-                                                     snprintf(buffer, sizeof(buffer), "CPU%d: %.2f%%", i, current_utilization);
-                                                     return text(std::string(buffer)); }));
-    }
+        // Indexed by CPU id; CPUs that are offline or outside the cpuset stay at -1
+        std::vector<double> utilization_by_cpu;
+        for (const auto &core : get_core_metrics())
+        {
+            if (core.cpu_id >= static_cast<int>(utilization_by_cpu.size()))
+                utilization_by_cpu.resize(core.cpu_id + 1, -1.0);
+            utilization_by_cpu[core.cpu_id] = core.utilization;
+        }
+
+        TopologyLevel level = static_cast<TopologyLevel>(*level_selected);
+        std::vector<Element> rows;
+        for (const auto &group : topology->aggregate(level, utilization_by_cpu))
+        {
+            char buffer[64];
+            snprintf(buffer, sizeof(buffer), "%-12s %6.2f%% ", group.label.c_str(), group.utilization);
+            Elements row = {text(std::string(buffer)),
+                            gauge(static_cast<float>(group.utilization / 100.0)) | size(WIDTH, EQUAL, 20),
+                            text(" (" + std::to_string(group.cpu_ids.size()) + " threads)") | dim};
+
+            if (level == TopologyLevel::NODE)
+            {
+                for (const auto &memory : topology->get_node_memory())
+                {
+                    if (memory.node_id != group.id || memory.total_mb <= 0.0)
+                        continue;
+                    char mem_buffer[64];
+                    snprintf(mem_buffer, sizeof(mem_buffer), "  Mem: %.0f / %.0f MB", memory.used_mb, memory.total_mb);
+                    row.push_back(text(std::string(mem_buffer)));
+                }
+            }
+            rows.push_back(hbox(row));
+        }
+        return vbox(rows);
+    };
+
+    // Colours of drawn columns persist across frames; each frame only converts the new ones
+    auto heatmap_columns = std::make_shared<HeatmapColumns>(core_history->get_capacity());
+    auto heatmap_outputs = [core_history, heatmap_columns]
+    {
+        heatmap_columns->update(*core_history);
+
+        // Each row shows two CPUs: the even id in the upper half, the next in the lower
+        Elements labels;
+        for (size_t cpu = 0; cpu < heatmap_columns->get_core_count(); cpu += 2)
+        {
+            char buffer[16];
+            snprintf(buffer, sizeof(buffer), "%4zu ", cpu);
+            labels.push_back(text(std::string(buffer)) | dim);
+        }
+
+        Elements legend = {text("0% ")};
+        for (int level = 0; level <= 10; level++)
+            legend.push_back(text("█") | color(HeatmapColumns::sample_color(static_cast<uint8_t>(level * CoreHistory::FULL_SCALE / 10))));
+        legend.push_back(text(" 100%"));
+        legend.push_back(text("   older <- -> now, grey = offline") | dim);
+
+        return vbox({hbox({vbox(labels), cpu_heatmap(heatmap_columns)}),
+                     separator(),
+                     hbox(legend)});
+    };
 
-    auto core_outputs = Container::Vertical(per_core_components);
+    auto core_panel = Renderer(Container::Vertical({level_toggle, cpuset_checkbox, core_outputs}),
+                               [level_toggle, cpuset_checkbox, core_outputs, level_selected, grouped_outputs, heatmap_outputs]
+                               {
+                                   Element body;
+                                   if (*level_selected == 0)
+                                       body = core_outputs->Render();
+                                   else if (*level_selected == 4)
+                                       body = heatmap_outputs();
+                                   else
+                                       body = grouped_outputs();
+                                   return vbox({hbox({level_toggle->Render(), text("  "), cpuset_checkbox->Render()}),
+                                                separator(),
+                                                body}); });
 
     // ... info component unchanged (keep it flexible)
     auto info = Container::Vertical({Renderer([cpu_model]
@@ -39,7 +177,11 @@ Component create_cpu_info_view(
             char s[32]; snprintf(s, sizeof(s), "%.2f", *overall_utilization); 
             return text(std::string("Processor Utilization: ") + s + " %") | bold; }),
                                      Renderer([logical_core_count]
-                                              { return text("Logical Cores: " + std::to_string(logical_core_count)) | bold; }),
+                                              { return text("Logical Cores: " + std::to_string(*logical_core_count)) | bold; }),
+                                     Renderer([topology]
+                                              { return text("Physical Cores: " + std::to_string(topology->get_core_count()) +
+                                                            "  NUMA Nodes: " + std::to_string(topology->get_node_count()) +
+                                                            "  Sockets: " + std::to_string(topology->get_socket_count())) | bold; }),
                                      Renderer([process_count]
                                               { return text("Process Count: " + std::to_string(*process_count)) | bold; }),
                                      Renderer([thread_count]
@@ -48,7 +190,7 @@ Component create_cpu_info_view(
 
     auto final_layout = ResizableSplit(
                             ResizableSplitOption{
-                                .main = core_outputs,
+                                .main = core_panel,
                                 .back = info,
                                 .direction = Direction::Right,
                                 .main_size = 70,
@@ -2,14 +2,24 @@
 #define __CPU_INFO_VIEW_HPP
 
 #include "ftxui/component/component.hpp"
+#include <atomic>
+#include <functional>
+#include "../../status_monitor/status_monitor.hpp"
+#include "../../status_monitor/cpu_frequency.hpp"
+#include "../../status_monitor/cpu_topology.hpp"
+#include "../../metrics/core_history.hpp"
 
 using namespace ftxui;
 
 Component create_cpu_info_view(
-    const std::vector<double *> &core_utilizations,
+    std::function<std::vector<CoreMetrics>()> get_core_metrics,
+    std::atomic<bool> *cpuset_only,
+    std::function<std::vector<CoreFrequency>()> get_core_frequencies,
+    const CpuTopology *topology,
+    const CoreHistory *core_history,
     const double *max_clock_speed_mhz,
     const double *overall_utilization,
-    const int logical_core_count,
+    const int *logical_core_count,
     const int *process_count,
     const int *thread_count,
     const std::string &cpu_model);
@@ -1,6 +1,6 @@
 #include "mem_info_view.hpp"
 
-Component create_mem_info_view(const double memory_total_mb, const double *memory_used_mb, const double *memory_free_mb, const double *memory_cached_mb, const double memory_swap_total_mb, const double *memory_swap_used_mb, const std::vector<double> *history_memory_used_mb)
+Component create_mem_info_view(const double memory_total_mb, const double *memory_used_mb, const double *memory_free_mb, const double *memory_cached_mb, const double memory_swap_total_mb, const double *memory_swap_used_mb, const TimeSeries<double> *history_memory_used_mb)
 {
     auto info = Container::Vertical({Renderer([memory_total_mb]
                                               { 
@@ -28,46 +28,41 @@ Component create_mem_info_view(const double memory_total_mb, const double *memor
             return text(std::string("Used Swap: ") + s + " MB") | bold; })}) |
                 flex | flex_grow;
 
-    auto mem_func = [history_memory_used_mb, memory_total_mb](int width, int height)
+    // Time range shown by the history graph: last minute, hour or day
+    auto range_labels = std::make_shared<std::vector<std::string>>(std::vector<std::string>{"1 min", "1 hour", "1 day"});
+    auto range_selected = std::make_shared<int>(0);
+
+    auto mem_func = [history_memory_used_mb, memory_total_mb, range_selected](int width, int height)
     {
-        int history_size = std::min(60, (int)history_memory_used_mb->size());
         std::vector<int> output;
         if (width <= 0 || height <= 0)
         {
             return output;
         }
 
-        const auto &hist = *history_memory_used_mb;
-        int true_size = hist.size();
-        int visible_size = std::min(true_size, 60);
+        Resolution resolution = static_cast<Resolution>(*range_selected);
+        std::vector<double> hist = history_memory_used_mb->values(resolution);
+        int history_size = history_memory_used_mb->capacity(resolution);
 
-        // Last chunk of history
-        int offset = true_size - visible_size;
+        // Newest sample on the right; the range fills in from the right as it accumulates
+        int data_start = history_size - static_cast<int>(hist.size());
         output.reserve(width);
         for (int x = 0; x < width; ++x)
         {
-            int history_pos = (x * visible_size) / width;
+            int history_pos = (x * history_size) / width;
 
-            if (history_pos >= offset && history_pos < history_size)
+            if (history_pos >= data_start && history_pos < history_size)
             {
-                size_t data_index = history_pos - offset;
-                if (data_index < history_memory_used_mb->size())
+                double used = hist[history_pos - data_start];
+                if (used < 0.01)
                 {
-                    if ((*history_memory_used_mb)[data_index] < 0.01)
-                    {
-                        output.push_back(-1);
-                    }
-                    else
-                    {
-                        double used = (*history_memory_used_mb)[data_index];
-                        double pct = (used / memory_total_mb) * 100.0;
-                        int value = (pct * height) / 100.0;
-                        output.push_back(std::min(std::max(0, value), height));
-                    }
+                    output.push_back(-1);
                 }
                 else
                 {
-                    output.push_back(-1);
+                    double pct = (used / memory_total_mb) * 100.0;
+                    int value = (pct * height) / 100.0;
+                    output.push_back(std::min(std::max(0, value), height));
                 }
             }
             else
@@ -78,10 +73,12 @@ Component create_mem_info_view(const double memory_total_mb, const double *memor
         return output;
     };
 
+    auto range_toggle = Toggle(range_labels.get(), range_selected.get());
+
     // History graph component
-    auto history_graph = Renderer([mem_func]()
+    auto history_graph = Renderer(range_toggle, [mem_func, range_toggle, range_labels]()
                                   { return vbox({graph(mem_func) | border | flex,
-                                                 text("Memory Usage") | bold | center}); });
+                                                 hbox({text("Memory Usage") | bold, text("  "), range_toggle->Render()}) | center}); });
 
     auto final_layout = ResizableSplit(
                             ResizableSplitOption{
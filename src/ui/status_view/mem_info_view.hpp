@@ -2,6 +2,7 @@
 #define __MEM_INFO_VIEW_HPP
 
 #include "ftxui/component/component.hpp"
+#include "../../metrics/time_series.hpp"
 
 using namespace ftxui;
 
@@ -12,6 +13,6 @@ Component create_mem_info_view(
     const double *memory_cached_mb,
     const double memory_swap_total_mb,
     const double *memory_swap_used_mb,
-    const std::vector<double> *history_memory_used_mb);
+    const TimeSeries<double> *history_memory_used_mb);
 
 #endif /* __MEM_INFO_VIEW_HPP */
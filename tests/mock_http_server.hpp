@@ -0,0 +1,145 @@
+#ifndef __MOCK_HTTP_SERVER_HPP
+#define __MOCK_HTTP_SERVER_HPP
+
+// Minimal HTTP/1.1 server on 127.0.0.1 standing in for the optimizer API, so
+// the whole request path can be tested and benchmarked offline. Each
+// connection gets its own thread and is kept alive; every POST is answered
+// with a Gemini-style body naming `pid`.
+
+#include <arpa/inet.h>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <netinet/in.h>
+#include <string>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+class MockHttpServer {
+public:
+    std::atomic<int> pid{0};
+    std::atomic<int> status{200};
+    std::atomic<int> delay_ms{0};
+    std::atomic<int> requests{0};
+    std::atomic<int> connections{0};
+
+    MockHttpServer() {
+        listen_fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        bind(listen_fd, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+        socklen_t length = sizeof(address);
+        getsockname(listen_fd, reinterpret_cast<sockaddr*>(&address), &length);
+        port = ntohs(address.sin_port);
+        listen(listen_fd, 8);
+        worker = std::thread([this] { serve(); });
+    }
+
+    ~MockHttpServer() {
+        running = false;
+        shutdown(listen_fd, SHUT_RDWR);
+        worker.join();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            for (int fd : client_fds) {
+                shutdown(fd, SHUT_RDWR);
+            }
+        }
+        for (auto& thread : connection_threads) {
+            thread.join();
+        }
+        for (int fd : client_fds) {
+            close(fd);
+        }
+        close(listen_fd);
+    }
+
+    std::string url() const {
+        return "http://127.0.0.1:" + std::to_string(port) + "/v1beta/models/mock:generateContent";
+    }
+
+    std::string last_request() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return last;
+    }
+
+private:
+    int listen_fd = -1;
+    int port = 0;
+    std::atomic<bool> running{true};
+    std::string last;
+    std::mutex mutex;
+    std::vector<int> client_fds;               // Closed by the destructor
+    std::vector<std::thread> connection_threads; // Only touched by the accept thread
+    std::thread worker;
+
+    void serve() {
+        while (running) {
+            int fd = accept4(listen_fd, nullptr, nullptr, SOCK_CLOEXEC);
+            if (fd < 0) {
+                continue;
+            }
+            connections++;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                client_fds.push_back(fd);
+            }
+            connection_threads.emplace_back([this, fd] {
+                while (running && handle_request(fd)) {
+                }
+                shutdown(fd, SHUT_RDWR);
+            });
+        }
+    }
+
+    // Reads one request and answers it; false once the client hangs up
+    bool handle_request(int fd) {
+        std::string request;
+        char buffer[4096];
+        size_t header_end;
+        while ((header_end = request.find("\r\n\r\n")) == std::string::npos) {
+            ssize_t n = read(fd, buffer, sizeof(buffer));
+            if (n <= 0) {
+                return false;
+            }
+            request.append(buffer, n);
+        }
+
+        size_t content_length = 0;
+        size_t field = request.find("Content-Length:");
+        if (field == std::string::npos) {
+            field = request.find("content-length:");
+        }
+        if (field != std::string::npos && field < header_end) {
+            content_length = std::stoul(request.substr(field + 15));
+        }
+        while (request.size() < header_end + 4 + content_length) {
+            ssize_t n = read(fd, buffer, sizeof(buffer));
+            if (n <= 0) {
+                return false;
+            }
+            request.append(buffer, n);
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            last = request;
+        }
+        requests++;
+
+        if (delay_ms > 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(delay_ms.load()));
+        }
+        std::string body = "{\"candidates\":[{\"content\":{\"parts\":[{\"text\":\"" + std::to_string(pid.load()) +
+                           "\"}]}}]}";
+        std::string response = "HTTP/1.1 " + std::to_string(status.load()) + " OK\r\n"
+                               "Content-Type: application/json\r\n"
+                               "Content-Length: " + std::to_string(body.size()) + "\r\n\r\n" + body;
+        // The client may have timed out and gone; that must not raise SIGPIPE
+        return send(fd, response.data(), response.size(), MSG_NOSIGNAL) == static_cast<ssize_t>(response.size());
+    }
+};
+
+#endif /* __MOCK_HTTP_SERVER_HPP */
@@ -0,0 +1,174 @@
+#include <gtest/gtest.h>
+#include "../src/metrics/anomaly_detector.hpp"
+
+// Test fixture for AnomalyDetector tests. The host has 4 CPUs and 16 GB of
+// RAM; a background process that is heavy on IO from the first snapshot
+// shares it with the process under test.
+class AnomalyDetectorTest : public ::testing::Test {
+protected:
+    AnomalyOptions options;
+
+    void SetUp() override {
+        options.warmup_samples = 5;
+        options.saturation_ticks = 3;
+        options.cooldown_ticks = 100;
+        options.cpu_capacity_percent = 400.0;
+        options.memory_total_kb = 16777216.0;
+    }
+
+    static std::vector<Process> tick(double cpu, unsigned long memory_kb = 1000, unsigned long io = 0, uint64_t started = 1) {
+        Process worker(10, "worker", memory_kb, cpu, io, 1);
+        worker.set_start_time(started);
+        return {worker, Process(1, "background", 4000000, 50.0, 50000000, 100000)};
+    }
+};
+
+TEST_F(AnomalyDetectorTest, FlagsSpikeAfterWarmup) {
+    AnomalyDetector detector(options);
+    for (int i = 0; i < 20; i++) {
+        EXPECT_EQ(detector.observe(tick(i % 2 == 0 ? 4.0 : 6.0)), 0u);
+    }
+
+    EXPECT_EQ(detector.observe(tick(80.0)), 1u);
+
+    auto alerts = detector.get_alerts();
+    ASSERT_EQ(alerts.size(), 1u);
+    EXPECT_EQ(alerts[0].pid, 10);
+    EXPECT_EQ(alerts[0].name, "worker");
+    EXPECT_EQ(alerts[0].kind, AnomalyKind::SPIKE);
+    EXPECT_EQ(alerts[0].metric, AnomalyMetric::CPU);
+    EXPECT_DOUBLE_EQ(alerts[0].value, 80.0);
+    EXPECT_NEAR(alerts[0].mean, 5.0, 0.5);
+    EXPECT_GE(alerts[0].score, options.spike_threshold);
+}
+
+TEST_F(AnomalyDetectorTest, IgnoresWarmupAndSmallDeviations) {
+    AnomalyDetector detector(options);
+    // Jumps during warmup have no baseline to compare against
+    detector.observe(tick(1.0));
+    detector.observe(tick(30.0));
+    for (int i = 0; i < 20; i++) {
+        detector.observe(tick(1.0));
+    }
+    // Many sigmas above a flat history, but under the minimum delta
+    detector.observe(tick(8.0));
+    // Memory growing in steps under the minimum
+    for (int i = 0; i < 10; i++) {
+        detector.observe(tick(1.0, 1000 + i * 1000));
+    }
+
+    EXPECT_EQ(detector.get_total_alerts(), 0u);
+}
+
+TEST_F(AnomalyDetectorTest, AlertsOnceOnSustainedSaturation) {
+    AnomalyDetector detector(options);
+    detector.observe(tick(95.0));
+    detector.observe(tick(95.0));
+    EXPECT_EQ(detector.get_total_alerts(), 0u);
+
+    detector.observe(tick(95.0));
+    detector.observe(tick(95.0));
+
+    auto alerts = detector.get_alerts();
+    ASSERT_EQ(alerts.size(), 1u);
+    EXPECT_EQ(alerts[0].kind, AnomalyKind::SATURATION);
+    EXPECT_DOUBLE_EQ(alerts[0].score, 3.0);
+}
+
+TEST_F(AnomalyDetectorTest, FlagsNewHeavyHittersButNotTheBaseline) {
+    AnomalyDetector detector(options);
+    // Heavy from the first snapshot: part of the baseline, not news
+    detector.observe(tick(5.0));
+    EXPECT_EQ(detector.get_total_alerts(), 0u);
+
+    std::vector<Process> processes = tick(5.0);
+    processes.emplace_back(30, "leaky", 8000000, 1.0, 0, 1);
+    EXPECT_EQ(detector.observe(processes), 1u);
+    EXPECT_EQ(detector.observe(processes), 0u);
+
+    auto alerts = detector.get_alerts();
+    ASSERT_EQ(alerts.size(), 1u);
+    EXPECT_EQ(alerts[0].pid, 30);
+    EXPECT_EQ(alerts[0].kind, AnomalyKind::HEAVY_HITTER);
+    EXPECT_EQ(alerts[0].metric, AnomalyMetric::MEMORY);
+    EXPECT_NEAR(alerts[0].score, 8000000.0 / 16777216.0, 1e-9);
+}
+
+TEST_F(AnomalyDetectorTest, BusyishProcessOnAnIdleHostIsNotAHeavyHitter) {
+    AnomalyDetector detector(options);
+    detector.observe({Process(10, "worker", 1000, 0.5, 0, 1), Process(11, "shell", 1000, 0.1, 0, 1)});
+
+    // Nearly all the CPU in use, but under 4% of the machine
+    detector.observe({Process(10, "worker", 1000, 15.0, 0, 2), Process(11, "shell", 1000, 0.1, 0, 2)});
+
+    EXPECT_EQ(detector.get_total_alerts(), 0u);
+}
+
+TEST_F(AnomalyDetectorTest, ForgetsExitedAndReusedPids) {
+    AnomalyDetector detector(options);
+    for (int i = 0; i < 10; i++) {
+        detector.observe(tick(5.0, 1000, 0, 100));
+    }
+    EXPECT_EQ(detector.get_tracked_count(), 2u);
+
+    // Same pid, different start time: its statistics start over, so no spike
+    detector.observe(tick(60.0, 1000, 0, 250));
+    EXPECT_EQ(detector.get_total_alerts(), 0u);
+
+    detector.observe({Process(1, "background", 4000000, 50.0, 50000000, 100000)});
+    EXPECT_EQ(detector.get_tracked_count(), 1u);
+}
+
+TEST_F(AnomalyDetectorTest, LogKeepsTheNewestAlerts) {
+    options.log_capacity = 2;
+    options.saturation_ticks = 1;
+    AnomalyDetector detector(options);
+
+    std::vector<Process> processes;
+    for (int pid = 100; pid < 105; pid++) {
+        processes.emplace_back(pid, "spin", 1000, 100.0, 0, 1);
+    }
+    EXPECT_EQ(detector.observe(processes), 5u);
+
+    auto alerts = detector.get_alerts();
+    ASSERT_EQ(alerts.size(), 2u);
+    EXPECT_EQ(alerts[0].pid, 103);
+    EXPECT_EQ(alerts[1].pid, 104);
+    EXPECT_EQ(detector.get_total_alerts(), 5u);
+
+    AnomalyAlert latest;
+    ASSERT_TRUE(detector.get_latest_alert(latest));
+    EXPECT_EQ(latest.pid, 104);
+
+    detector.clear_alerts();
+    EXPECT_TRUE(detector.get_alerts().empty());
+    EXPECT_FALSE(detector.get_latest_alert(latest));
+    EXPECT_EQ(detector.get_total_alerts(), 5u);
+}
+
+TEST_F(AnomalyDetectorTest, DescribesAlerts) {
+    AnomalyAlert alert;
+    alert.pid = 1234;
+    alert.name = "firefox";
+    alert.value = 85.0;
+    alert.mean = 3.1;
+    alert.score = 12.4;
+    EXPECT_EQ(describe_anomaly(alert), "firefox (1234) CPU spike 85.0% (mean 3.1%, 12.4 sd)");
+
+    alert.kind = AnomalyKind::SATURATION;
+    alert.score = 10;
+    EXPECT_EQ(describe_anomaly(alert), "firefox (1234) CPU saturated at 85.0% for 10 ticks");
+
+    alert.kind = AnomalyKind::HEAVY_HITTER;
+    alert.metric = AnomalyMetric::MEMORY;
+    alert.value = 2150400;
+    alert.score = 0.45;
+    EXPECT_EQ(describe_anomaly(alert), "firefox (1234) new heavy hitter: 45% of memory (2100.0 MB)");
+
+    alert.kind = AnomalyKind::SPIKE;
+    alert.metric = AnomalyMetric::IO;
+    alert.value = 3072;
+    alert.mean = 512;
+    alert.score = 5.0;
+    EXPECT_EQ(describe_anomaly(alert), "firefox (1234) IO spike 3.0 KB/s (mean 0.5 KB/s, 5.0 sd)");
+}
@@ -0,0 +1,233 @@
+#include <gtest/gtest.h>
+#include "../src/collectors/collector_scheduler.hpp"
+#include <atomic>
+#include <thread>
+
+// Collector that just counts its runs
+class CountingCollector : public Collector {
+public:
+    std::string collector_name;
+    std::chrono::milliseconds period;
+    std::chrono::milliseconds work;
+    std::atomic<int> runs{0};
+
+    CountingCollector(std::string name, std::chrono::milliseconds period,
+                      std::chrono::milliseconds work = std::chrono::milliseconds(0))
+        : collector_name(std::move(name)), period(period), work(work) {}
+
+    std::string name() const override { return collector_name; }
+    std::chrono::milliseconds interval() const override { return period; }
+    void collect() override {
+        if (work.count() > 0) {
+            std::this_thread::sleep_for(work);
+        }
+        runs++;
+    }
+};
+
+// Test fixture for CollectorScheduler tests
+class CollectorSchedulerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+    }
+};
+
+TEST_F(CollectorSchedulerTest, RunsCollectorsAtTheirOwnIntervals) {
+    CollectorScheduler scheduler(std::chrono::milliseconds(5));
+    auto fast = std::make_shared<CountingCollector>("fast", std::chrono::milliseconds(20));
+    auto slow = std::make_shared<CountingCollector>("slow", std::chrono::milliseconds(200));
+    scheduler.add(fast);
+    scheduler.add(slow);
+
+    scheduler.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(410));
+    scheduler.stop();
+
+    // Initial run plus one per elapsed interval, with slack for busy CI machines
+    EXPECT_GE(fast->runs.load(), 12);
+    EXPECT_LE(fast->runs.load(), 23);
+    EXPECT_GE(slow->runs.load(), 2);
+    EXPECT_LE(slow->runs.load(), 3);
+}
+
+TEST_F(CollectorSchedulerTest, IntervalsLongerThanOneWheelTurn) {
+    // 4 slots of 5ms: a 50ms interval needs several turns of the wheel
+    CollectorScheduler scheduler(std::chrono::milliseconds(5), 4);
+    auto collector = std::make_shared<CountingCollector>("long", std::chrono::milliseconds(50));
+    scheduler.add(collector);
+
+    scheduler.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(230));
+    scheduler.stop();
+
+    EXPECT_GE(collector->runs.load(), 4);
+    EXPECT_LE(collector->runs.load(), 6);
+}
+
+TEST_F(CollectorSchedulerTest, TriggerOnlyCollectorRunsWhenTriggered) {
+    CollectorScheduler scheduler(std::chrono::milliseconds(5));
+    auto hardware = std::make_shared<CountingCollector>("hardware", std::chrono::milliseconds(0));
+    scheduler.add(hardware);
+
+    scheduler.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_EQ(hardware->runs.load(), 0);
+
+    scheduler.trigger("hardware");
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    scheduler.stop();
+
+    EXPECT_EQ(hardware->runs.load(), 1);
+}
+
+TEST_F(CollectorSchedulerTest, OverrunningCollectorSkipsMissedTicks) {
+    CollectorScheduler scheduler(std::chrono::milliseconds(5));
+    auto collector = std::make_shared<CountingCollector>("slow", std::chrono::milliseconds(10),
+                                                         std::chrono::milliseconds(25));
+    scheduler.add(collector);
+
+    scheduler.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    scheduler.stop();
+
+    // Runs back to back instead of queueing up every missed interval
+    auto stats = scheduler.get_stats();
+    ASSERT_EQ(stats.size(), 1u);
+    EXPECT_GT(stats[0].missed_ticks, 0u);
+    EXPECT_LE(collector->runs.load(), 9);
+}
+
+TEST_F(CollectorSchedulerTest, MeasuresRuntime) {
+    CollectorScheduler scheduler(std::chrono::milliseconds(5));
+    auto collector = std::make_shared<CountingCollector>("work", std::chrono::milliseconds(20),
+                                                         std::chrono::milliseconds(2));
+    scheduler.add(collector);
+
+    scheduler.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    scheduler.stop();
+
+    auto stats = scheduler.get_stats();
+    ASSERT_EQ(stats.size(), 1u);
+    EXPECT_EQ(stats[0].name, "work");
+    EXPECT_EQ(stats[0].runs, static_cast<uint64_t>(collector->runs.load()));
+    EXPECT_GE(stats[0].last_runtime, std::chrono::microseconds(2000));
+    EXPECT_GE(stats[0].max_runtime, stats[0].average_runtime());
+}
+
+TEST_F(CollectorSchedulerTest, RunsDueCollectorsInParallel) {
+    CollectorScheduler scheduler(std::chrono::milliseconds(5), 64, 3);
+    std::vector<std::shared_ptr<CountingCollector>> collectors;
+    for (const char* name : {"a", "b", "c"}) {
+        collectors.push_back(std::make_shared<CountingCollector>(name, std::chrono::milliseconds(1000),
+                                                                 std::chrono::milliseconds(80)));
+        scheduler.add(collectors.back());
+    }
+
+    // All three are due at start; one after another they would take 240ms
+    scheduler.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+    scheduler.stop();
+
+    for (const auto& collector : collectors) {
+        EXPECT_EQ(collector->runs.load(), 1);
+    }
+}
+
+// Collector that records how many collectors on its lane are running at once
+class LaneCollector : public Collector {
+public:
+    std::string collector_name;
+    const void* shared_lane;
+    std::atomic<int>& active;
+    std::atomic<int>& max_active;
+    std::atomic<int> runs{0};
+
+    LaneCollector(std::string name, const void* shared_lane, std::atomic<int>& active, std::atomic<int>& max_active)
+        : collector_name(std::move(name)), shared_lane(shared_lane), active(active), max_active(max_active) {}
+
+    std::string name() const override { return collector_name; }
+    std::chrono::milliseconds interval() const override { return std::chrono::milliseconds(20); }
+    const void* lane() const override { return shared_lane; }
+    void collect() override {
+        int now_active = ++active;
+        int seen = max_active.load();
+        while (now_active > seen && !max_active.compare_exchange_weak(seen, now_active)) {
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        active--;
+        runs++;
+    }
+};
+
+TEST_F(CollectorSchedulerTest, CollectorsOnOneLaneNeverOverlap) {
+    CollectorScheduler scheduler(std::chrono::milliseconds(5), 64, 4);
+    int monitor = 0;
+    std::atomic<int> active{0};
+    std::atomic<int> max_active{0};
+    auto cpu = std::make_shared<LaneCollector>("cpu", &monitor, active, max_active);
+    auto memory = std::make_shared<LaneCollector>("memory", &monitor, active, max_active);
+    // Not on the lane: still free to run beside them
+    auto other = std::make_shared<CountingCollector>("other", std::chrono::milliseconds(20), std::chrono::milliseconds(5));
+    scheduler.add(cpu);
+    scheduler.add(memory);
+    scheduler.add(other);
+
+    scheduler.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    scheduler.stop();
+
+    // Same interval, so both are due on every tick they run
+    EXPECT_GE(cpu->runs.load(), 5);
+    EXPECT_GE(memory->runs.load(), 5);
+    EXPECT_GE(other->runs.load(), 5);
+    EXPECT_EQ(max_active.load(), 1);
+}
+
+// Collector that burns CPU instead of sleeping
+class SpinningCollector : public Collector {
+public:
+    std::chrono::milliseconds period;
+    std::chrono::milliseconds work;
+    std::atomic<int> runs{0};
+
+    SpinningCollector(std::chrono::milliseconds period, std::chrono::milliseconds work)
+        : period(period), work(work) {}
+
+    std::string name() const override { return "spin"; }
+    std::chrono::milliseconds interval() const override { return period; }
+    void collect() override {
+        auto until = std::chrono::steady_clock::now() + work;
+        while (std::chrono::steady_clock::now() < until) {
+        }
+        runs++;
+    }
+};
+
+TEST_F(CollectorSchedulerTest, StretchesIntervalsOverCpuBudget) {
+    CollectorScheduler scheduler(std::chrono::milliseconds(5));
+    // Roughly 50% of a CPU against a 5% budget
+    auto collector = std::make_shared<SpinningCollector>(std::chrono::milliseconds(20), std::chrono::milliseconds(10));
+    scheduler.add(collector);
+    scheduler.set_cpu_budget(5.0, std::chrono::milliseconds(200));
+
+    scheduler.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    scheduler.stop();
+
+    EXPECT_GT(scheduler.get_measured_overhead(), 5.0);
+    EXPECT_GT(scheduler.get_interval_scale(), 1);
+    EXPECT_LE(scheduler.get_interval_scale(), CollectorScheduler::MAX_INTERVAL_SCALE);
+}
+
+TEST_F(CollectorSchedulerTest, NoBudgetKeepsIntervals) {
+    CollectorScheduler scheduler(std::chrono::milliseconds(5));
+    auto collector = std::make_shared<SpinningCollector>(std::chrono::milliseconds(20), std::chrono::milliseconds(10));
+    scheduler.add(collector);
+
+    scheduler.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    scheduler.stop();
+
+    EXPECT_EQ(scheduler.get_interval_scale(), 1);
+}
@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+#include "../src/metrics/core_history.hpp"
+#include "../src/ui/status_view/cpu_heatmap_view.hpp"
+
+// Test fixture for CoreHistory and the heatmap's column cache
+class CoreHistoryTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+    }
+};
+
+TEST_F(CoreHistoryTest, QuantizesToOneByte) {
+    EXPECT_EQ(CoreHistory::quantize(0.0), 0);
+    EXPECT_EQ(CoreHistory::quantize(100.0), CoreHistory::FULL_SCALE);
+    EXPECT_EQ(CoreHistory::quantize(150.0), CoreHistory::FULL_SCALE);
+    EXPECT_EQ(CoreHistory::quantize(-1.0), CoreHistory::NO_SAMPLE);
+    EXPECT_NEAR(CoreHistory::dequantize(CoreHistory::quantize(37.3)), 37.3, 0.2);
+    EXPECT_DOUBLE_EQ(CoreHistory::dequantize(CoreHistory::NO_SAMPLE), -1.0);
+}
+
+TEST_F(CoreHistoryTest, ReturnsOnlyNewColumns) {
+    CoreHistory history(10);
+    history.push({10.0, 20.0});
+    history.push({30.0, 40.0});
+
+    CoreHistoryUpdate all = history.get_since(0);
+    EXPECT_EQ(all.total_columns, 2u);
+    EXPECT_EQ(all.core_count, 2u);
+    ASSERT_EQ(all.samples.size(), 4u);
+    EXPECT_EQ(all.samples[2], CoreHistory::quantize(30.0));
+
+    history.push({50.0, 60.0});
+    CoreHistoryUpdate update = history.get_since(all.total_columns);
+    EXPECT_EQ(update.first_sequence, 2u);
+    ASSERT_EQ(update.samples.size(), 2u);
+    EXPECT_EQ(update.samples[0], CoreHistory::quantize(50.0));
+    EXPECT_EQ(update.samples[1], CoreHistory::quantize(60.0));
+
+    EXPECT_TRUE(history.get_since(3).samples.empty());
+}
+
+TEST_F(CoreHistoryTest, KeepsNewestColumnsWhenFull) {
+    CoreHistory history(3);
+    for (int i = 0; i < 5; i++) {
+        history.push({i * 10.0});
+    }
+
+    // Columns 0 and 1 were overwritten
+    CoreHistoryUpdate update = history.get_since(0);
+    EXPECT_EQ(update.first_sequence, 2u);
+    EXPECT_EQ(update.total_columns, 5u);
+    EXPECT_EQ(update.samples, (std::vector<uint8_t>{CoreHistory::quantize(20.0), CoreHistory::quantize(30.0),
+                                                    CoreHistory::quantize(40.0)}));
+}
+
+TEST_F(CoreHistoryTest, AddsRowsForNewCpus) {
+    CoreHistory history(4);
+    history.push({10.0});
+    history.push({20.0, -1.0, 80.0});
+
+    CoreHistoryUpdate update = history.get_since(0);
+    EXPECT_EQ(update.core_count, 3u);
+    EXPECT_EQ(update.samples, (std::vector<uint8_t>{CoreHistory::quantize(10.0), CoreHistory::NO_SAMPLE, CoreHistory::NO_SAMPLE,
+                                                    CoreHistory::quantize(20.0), CoreHistory::NO_SAMPLE, CoreHistory::quantize(80.0)}));
+}
+
+TEST_F(CoreHistoryTest, HeatmapConvertsOnlyNewColumns) {
+    CoreHistory history(8);
+    HeatmapColumns columns(8);
+    history.push({0.0, 100.0});
+    history.push({50.0, -1.0});
+
+    EXPECT_EQ(columns.update(history), 2u);
+    EXPECT_EQ(columns.update(history), 0u);
+    history.push({100.0, 0.0});
+    EXPECT_EQ(columns.update(history), 1u);
+
+    ASSERT_EQ(columns.size(), 3u);
+    EXPECT_EQ(columns.at(2, 0), HeatmapColumns::sample_color(CoreHistory::FULL_SCALE));
+    EXPECT_EQ(columns.at(1, 1), HeatmapColumns::sample_color(CoreHistory::NO_SAMPLE));
+}
+
+TEST_F(CoreHistoryTest, HeatmapRebuildsWhenCoresChange) {
+    CoreHistory history(8);
+    HeatmapColumns columns(8);
+    history.push({10.0});
+    columns.update(history);
+
+    history.push({10.0, 90.0});
+    EXPECT_EQ(columns.update(history), 2u);
+    EXPECT_EQ(columns.get_core_count(), 2u);
+    EXPECT_EQ(columns.at(1, 1), HeatmapColumns::sample_color(CoreHistory::quantize(90.0)));
+}
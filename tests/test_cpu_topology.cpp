@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+#include "../src/status_monitor/cpu_topology.hpp"
+#include <filesystem>
+#include <fstream>
+#include <unistd.h>
+
+namespace fs = std::filesystem;
+
+// Builds a fake /sys/devices/system tree for a dual-socket, 2-core, 2xSMT box
+// with one NUMA node per socket.
+class CpuTopologyTest : public ::testing::Test {
+protected:
+    fs::path root;
+
+    void write(const fs::path& path, const std::string& contents) {
+        fs::create_directories(path.parent_path());
+        std::ofstream(path) << contents;
+    }
+
+    void SetUp() override {
+        root = fs::temp_directory_path() / ("houston_topology_" + std::to_string(getpid()));
+        fs::remove_all(root);
+
+        for (int cpu = 0; cpu < 8; cpu++) {
+            int package = cpu / 4;
+            int core = (cpu % 4) / 2;
+            fs::path topology = root / "cpu" / ("cpu" + std::to_string(cpu)) / "topology";
+            write(topology / "physical_package_id", std::to_string(package) + "\n");
+            write(topology / "core_id", std::to_string(core) + "\n");
+        }
+
+        write(root / "node" / "node0" / "cpulist", "0-3\n");
+        write(root / "node" / "node1" / "cpulist", "4-7\n");
+        write(root / "node" / "node0" / "meminfo",
+              "Node 0 MemTotal:       16000000 kB\nNode 0 MemFree:         4000000 kB\n");
+        write(root / "node" / "node1" / "meminfo",
+              "Node 1 MemTotal:       16000000 kB\nNode 1 MemFree:        15000000 kB\n");
+    }
+
+    void TearDown() override {
+        fs::remove_all(root);
+    }
+};
+
+TEST_F(CpuTopologyTest, ParseCpuList) {
+    EXPECT_EQ(parse_cpu_list("0-3,8,10-11\n"), (std::vector<int>{0, 1, 2, 3, 8, 10, 11}));
+    EXPECT_EQ(parse_cpu_list("5"), (std::vector<int>{5}));
+    EXPECT_TRUE(parse_cpu_list("").empty());
+}
+
+TEST_F(CpuTopologyTest, CountsSocketsNodesAndCores) {
+    CpuTopology topology(root.string());
+
+    EXPECT_EQ(topology.get_cpus().size(), 8u);
+    EXPECT_EQ(topology.get_socket_count(), 2u);
+    EXPECT_EQ(topology.get_node_count(), 2u);
+    EXPECT_EQ(topology.get_core_count(), 4u);
+}
+
+TEST_F(CpuTopologyTest, AggregatesUtilizationPerLevel) {
+    CpuTopology topology(root.string());
+    // Socket 0 saturated, socket 1 idle
+    std::vector<double> utilization = {100, 100, 100, 100, 0, 0, 0, 0};
+
+    auto sockets = topology.aggregate(TopologyLevel::SOCKET, utilization);
+    ASSERT_EQ(sockets.size(), 2u);
+    EXPECT_DOUBLE_EQ(sockets[0].utilization, 100.0);
+    EXPECT_DOUBLE_EQ(sockets[1].utilization, 0.0);
+
+    auto nodes = topology.aggregate(TopologyLevel::NODE, utilization);
+    ASSERT_EQ(nodes.size(), 2u);
+    EXPECT_DOUBLE_EQ(nodes[0].utilization, 100.0);
+
+    // One busy SMT sibling shows as a half-loaded physical core
+    utilization = {100, 0, 0, 0, 0, 0, 0, 0};
+    auto cores = topology.aggregate(TopologyLevel::CORE, utilization);
+    ASSERT_EQ(cores.size(), 4u);
+    EXPECT_DOUBLE_EQ(cores[0].utilization, 50.0);
+    EXPECT_EQ(cores[0].cpu_ids, (std::vector<int>{0, 1}));
+}
+
+TEST_F(CpuTopologyTest, SkipsCpusWithoutSamples) {
+    CpuTopology topology(root.string());
+    std::vector<double> utilization = {-1.0, 40.0};
+
+    auto cores = topology.aggregate(TopologyLevel::CORE, utilization);
+
+    EXPECT_DOUBLE_EQ(cores[0].utilization, 40.0);
+    EXPECT_DOUBLE_EQ(cores[1].utilization, 0.0);
+}
+
+TEST_F(CpuTopologyTest, ReadsNodeMemory) {
+    CpuTopology topology(root.string());
+
+    const auto& memory = topology.get_node_memory();
+    ASSERT_EQ(memory.size(), 2u);
+    EXPECT_DOUBLE_EQ(memory[0].total_mb, 16000.0);
+    EXPECT_DOUBLE_EQ(memory[0].used_mb, 12000.0);
+    EXPECT_DOUBLE_EQ(memory[1].used_mb, 1000.0);
+}
@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+#include "../src/ui/frame_pacer.hpp"
+#include <atomic>
+#include <thread>
+
+// Test fixture for FramePacer tests
+class FramePacerTest : public ::testing::Test {
+protected:
+    std::atomic<int> redraws{0};
+
+    void SetUp() override {
+    }
+};
+
+TEST_F(FramePacerTest, FirstFrameIsBuilt) {
+    FramePacer pacer([this] { redraws++; }, 30);
+
+    ASSERT_TRUE(pacer.begin_frame());
+    pacer.end_frame();
+
+    FrameStats stats = pacer.get_stats();
+    EXPECT_EQ(stats.frames, 1u);
+    EXPECT_EQ(stats.dropped_frames, 0u);
+}
+
+TEST_F(FramePacerTest, ReusesFrameWhenNothingChanged) {
+    FramePacer pacer([this] { redraws++; }, 1000);
+    ASSERT_TRUE(pacer.begin_frame());
+    pacer.end_frame();
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+
+    EXPECT_FALSE(pacer.begin_frame());
+    EXPECT_FALSE(pacer.begin_frame());
+    EXPECT_EQ(pacer.get_stats().reused_frames, 2u);
+
+    pacer.mark_dirty();
+    EXPECT_TRUE(pacer.begin_frame());
+}
+
+TEST_F(FramePacerTest, DropsFramesInsideTheBudget) {
+    // 10 fps: a 100ms budget that no test step below comes close to
+    FramePacer pacer([this] { redraws++; }, 10);
+    ASSERT_TRUE(pacer.begin_frame());
+    pacer.end_frame();
+
+    for (int i = 0; i < 50; i++) {
+        pacer.mark_dirty();
+        EXPECT_FALSE(pacer.begin_frame());
+    }
+
+    FrameStats stats = pacer.get_stats();
+    EXPECT_EQ(stats.frames, 1u);
+    EXPECT_EQ(stats.dropped_frames, 50u);
+}
+
+TEST_F(FramePacerTest, CoalescesInvalidationsIntoOneRedraw) {
+    FramePacer pacer([this] { redraws++; }, 20);
+    pacer.start();
+    ASSERT_TRUE(pacer.begin_frame());
+    pacer.end_frame();
+
+    // A burst of data ticks within one 50ms frame
+    for (int i = 0; i < 100; i++) {
+        pacer.invalidate();
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(120));
+    pacer.stop();
+
+    EXPECT_EQ(redraws.load(), 1);
+    // The deferred redraw lands after the budget, so it builds a frame
+    EXPECT_TRUE(pacer.begin_frame());
+}
+
+TEST_F(FramePacerTest, RecordsFrameTimes) {
+    FramePacer pacer([this] { redraws++; }, 100);
+    ASSERT_TRUE(pacer.begin_frame());
+    std::this_thread::sleep_for(std::chrono::milliseconds(15));
+    pacer.end_frame();
+
+    FrameStats stats = pacer.get_stats();
+    EXPECT_GE(stats.last_frame_time, std::chrono::milliseconds(15));
+    EXPECT_EQ(stats.max_frame_time, stats.last_frame_time);
+    EXPECT_EQ(stats.average_frame_time(), stats.last_frame_time);
+    // 15ms is over the 10ms budget of 100 fps
+    EXPECT_EQ(stats.late_frames, 1u);
+}
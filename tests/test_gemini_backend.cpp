@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+#include "../src/smart_sparker/machine_opt/gemini_backend.hpp"
+#include "../src/smart_sparker/process_sorter.hpp"
+#include "mock_http_server.hpp"
+
+// Runs the remote optimizer path end to end against a local stand-in server
+class GeminiBackendTest : public ::testing::Test {
+protected:
+    MockHttpServer server;
+
+    GeminiOptions options() {
+        GeminiOptions options;
+        options.endpoint = server.url();
+        options.api_key = "test-key";
+        return options;
+    }
+
+    static std::vector<Process> snapshot(double hog_cpu = 90.0) {
+        return {Process(100, "editor", 20000, 1.0), Process(300, "hog", 800000, hog_cpu)};
+    }
+
+    void SetUp() override {
+        server.pid = 300;
+    }
+};
+
+TEST_F(GeminiBackendTest, RecommendsPidFromResponse) {
+    GeminiBackend backend(options());
+
+    KillRecommendation recommendation = backend.recommend(snapshot());
+
+    EXPECT_TRUE(recommendation.error.empty()) << recommendation.error;
+    EXPECT_EQ(recommendation.pid, 300);
+    EXPECT_EQ(recommendation.name, "hog");
+    std::string request = server.last_request();
+    EXPECT_NE(request.find("x-goog-api-key: test-key"), std::string::npos);
+    EXPECT_NE(request.find("hog"), std::string::npos);
+}
+
+TEST_F(GeminiBackendTest, CachesBySnapshotFingerprint) {
+    GeminiBackend backend(options());
+
+    backend.recommend(snapshot(90.0));
+    // Within a percent of the same CPU: the model would see the same thing
+    backend.recommend(snapshot(90.2));
+    EXPECT_EQ(server.requests, 1);
+    EXPECT_EQ(snapshot_fingerprint(select_top_processes(snapshot(90.0))),
+              snapshot_fingerprint(select_top_processes(snapshot(90.2))));
+
+    backend.recommend(snapshot(40.0));
+    EXPECT_EQ(server.requests, 2);
+}
+
+TEST_F(GeminiBackendTest, ReusesOneConnection) {
+    GeminiBackend backend(options());
+
+    for (int i = 0; i < 5; i++) {
+        ASSERT_TRUE(backend.recommend(snapshot(10.0 * i)).error.empty());
+    }
+
+    EXPECT_EQ(server.requests, 5);
+    EXPECT_EQ(server.connections, 1);
+    EXPECT_EQ(backend.get_client().get_connections_opened(), 1u);
+}
+
+TEST_F(GeminiBackendTest, TimesOutSlowServer) {
+    GeminiOptions slow = options();
+    slow.http.timeout = std::chrono::milliseconds(100);
+    GeminiBackend backend(slow);
+    server.delay_ms = 500;
+
+    auto started = std::chrono::steady_clock::now();
+    KillRecommendation recommendation = backend.recommend(snapshot());
+
+    EXPECT_FALSE(recommendation.error.empty());
+    EXPECT_EQ(recommendation.pid, -1);
+    EXPECT_LT(std::chrono::steady_clock::now() - started, std::chrono::milliseconds(400));
+}
+
+TEST_F(GeminiBackendTest, ReportsHttpErrorsAndMissingKey) {
+    server.status = 503;
+    GeminiBackend backend(options());
+    EXPECT_EQ(backend.recommend(snapshot()).error, "HTTP 503");
+
+    GeminiOptions no_key = options();
+    no_key.api_key.clear();
+    GeminiBackend unconfigured(no_key);
+    EXPECT_FALSE(unconfigured.recommend(snapshot()).error.empty());
+    EXPECT_EQ(server.requests, 1);
+}
@@ -0,0 +1,153 @@
+#include <gtest/gtest.h>
+#include "../src/config/houston_config.hpp"
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <unistd.h>
+
+namespace fs = std::filesystem;
+
+// Points XDG_CONFIG_HOME at an empty temp dir so the user's own config file
+// never leaks into the tests
+class HoustonConfigTest : public ::testing::Test {
+protected:
+    fs::path root;
+
+    bool load(std::vector<const char*> args, HoustonConfig& config, std::string& error) {
+        args.insert(args.begin(), "houston");
+        return load_config(static_cast<int>(args.size()), args.data(), config, error);
+    }
+
+    void write_config(const std::string& contents) {
+        fs::create_directories(root / "houston");
+        std::ofstream(root / "houston" / "houston.conf") << contents;
+    }
+
+    void SetUp() override {
+        root = fs::temp_directory_path() / ("houston_config_" + std::to_string(getpid()));
+        fs::remove_all(root);
+        fs::create_directories(root);
+        setenv("XDG_CONFIG_HOME", root.c_str(), 1);
+    }
+
+    void TearDown() override {
+        fs::remove_all(root);
+    }
+};
+
+TEST_F(HoustonConfigTest, DefaultsWithoutArguments) {
+    HoustonConfig config;
+    std::string error;
+
+    ASSERT_TRUE(load({}, config, error));
+    EXPECT_DOUBLE_EQ(config.refresh_interval_seconds, 1.0);
+    EXPECT_EQ(config.backend, ProcessBackend::STATGRAB);
+    EXPECT_TRUE(config.collect_network);
+    EXPECT_EQ(config.collector_threads, 1);
+    EXPECT_EQ(config.optimizer, OptimizerKind::LOCAL);
+    EXPECT_FALSE(config.show_help);
+}
+
+TEST_F(HoustonConfigTest, MinimalProfileLowersOverhead) {
+    HoustonConfig config;
+    ASSERT_TRUE(apply_profile(config, "minimal"));
+
+    EXPECT_GT(config.refresh_interval_seconds, 1.0);
+    EXPECT_FALSE(config.collect_network);
+    EXPECT_FALSE(config.collect_hardware);
+    EXPECT_TRUE(config.collect_processes);
+    EXPECT_EQ(config.backend, ProcessBackend::PROCFS);
+    EXPECT_GT(config.cpu_budget_percent, 0.0);
+    EXPECT_FALSE(apply_profile(config, "turbo"));
+}
+
+TEST_F(HoustonConfigTest, ParsesBothArgumentForms) {
+    HoustonConfig config;
+    std::string error;
+
+    ASSERT_TRUE(load({"--refresh=2.5", "--threads", "4", "--collectors=cpu,processes", "--backend=procfs",
+                      "--grace=0.5", "--anomaly-threshold=6", "--optimizer=gemini",
+                      "--optimizer-endpoint=http://127.0.0.1:8080/v1"},
+                     config, error))
+        << error;
+    EXPECT_DOUBLE_EQ(config.refresh_interval_seconds, 2.5);
+    EXPECT_DOUBLE_EQ(config.termination_grace_seconds, 0.5);
+    EXPECT_DOUBLE_EQ(config.anomaly_threshold, 6.0);
+    EXPECT_EQ(config.optimizer, OptimizerKind::GEMINI);
+    EXPECT_EQ(config.optimizer_endpoint, "http://127.0.0.1:8080/v1");
+    EXPECT_EQ(config.collector_threads, 4);
+    EXPECT_TRUE(config.collect_cpu);
+    EXPECT_TRUE(config.collect_processes);
+    EXPECT_FALSE(config.collect_memory);
+    EXPECT_FALSE(config.collect_network);
+    EXPECT_EQ(config.backend, ProcessBackend::PROCFS);
+}
+
+TEST_F(HoustonConfigTest, RejectsInvalidOptions) {
+    HoustonConfig config;
+    std::string error;
+
+    EXPECT_FALSE(load({"--refresh=fast"}, config, error));
+    EXPECT_NE(error.find("refresh"), std::string::npos);
+    EXPECT_FALSE(load({"--threads=0"}, config, error));
+    EXPECT_FALSE(load({"--collectors=cpu,gpu"}, config, error));
+    EXPECT_FALSE(load({"--colour=red"}, config, error));
+    EXPECT_FALSE(load({"--profile=turbo"}, config, error));
+    EXPECT_FALSE(load({"--history"}, config, error));
+    EXPECT_FALSE(load({"--grace=-1"}, config, error));
+    EXPECT_FALSE(load({"--anomaly-threshold=0.5"}, config, error));
+    EXPECT_FALSE(load({"--optimizer-endpoint=localhost:8080"}, config, error));
+    EXPECT_FALSE(load({"stray"}, config, error));
+}
+
+TEST_F(HoustonConfigTest, ParsesConfigText) {
+    std::vector<std::pair<std::string, std::string>> options;
+    std::string error;
+
+    ASSERT_TRUE(parse_config_text("# comment\n\n  refresh = 3 \nbackend=procfs\n", options, error));
+    ASSERT_EQ(options.size(), 2u);
+    EXPECT_EQ(options[0], (std::pair<std::string, std::string>{"refresh", "3"}));
+    EXPECT_EQ(options[1], (std::pair<std::string, std::string>{"backend", "procfs"}));
+
+    EXPECT_FALSE(parse_config_text("refresh 3\n", options, error));
+    EXPECT_NE(error.find("line 1"), std::string::npos);
+}
+
+TEST_F(HoustonConfigTest, CommandLineOverridesFileOverridesProfile) {
+    write_config("profile = minimal\nrefresh = 3\nfps = 20\n");
+    HoustonConfig config;
+    std::string error;
+
+    ASSERT_TRUE(load({"--fps=60"}, config, error)) << error;
+    EXPECT_EQ(config.profile, "minimal");
+    EXPECT_DOUBLE_EQ(config.refresh_interval_seconds, 3.0);
+    EXPECT_EQ(config.max_fps, 60);
+    // Untouched profile values survive
+    EXPECT_FALSE(config.collect_network);
+
+    // A profile given on the command line replaces the file's, but the file's
+    // explicit values still apply on top of it
+    config = HoustonConfig{};
+    ASSERT_TRUE(load({"--profile=detailed"}, config, error)) << error;
+    EXPECT_EQ(config.profile, "detailed");
+    EXPECT_TRUE(config.collect_network);
+    EXPECT_DOUBLE_EQ(config.refresh_interval_seconds, 3.0);
+}
+
+TEST_F(HoustonConfigTest, MissingExplicitConfigIsAnError) {
+    HoustonConfig config;
+    std::string error;
+    std::string missing = (root / "missing.conf").string();
+
+    EXPECT_FALSE(load({"--config", missing.c_str()}, config, error));
+    EXPECT_NE(error.find("missing.conf"), std::string::npos);
+}
+
+TEST_F(HoustonConfigTest, HelpStopsParsing) {
+    HoustonConfig config;
+    std::string error;
+
+    ASSERT_TRUE(load({"--help", "--refresh=fast"}, config, error));
+    EXPECT_TRUE(config.show_help);
+    EXPECT_NE(usage_text().find("--profile"), std::string::npos);
+}
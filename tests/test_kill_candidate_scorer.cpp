@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+#include "../src/smart_sparker/machine_opt/kill_candidate_scorer.hpp"
+#include <filesystem>
+#include <fstream>
+#include <unistd.h>
+
+namespace fs = std::filesystem;
+
+// Fixed snapshots scored against an empty fake /proc, so only the cgroup
+// files a test writes exist
+class KillCandidateScorerTest : public ::testing::Test {
+protected:
+    fs::path root;
+
+    static Process make(pid_t pid, const std::string& name, unsigned long memory_kb, double cpu,
+                        unsigned long uptime = 3600, int nice = 0, uid_t uid = 1000) {
+        Process proc(pid, name, memory_kb, cpu, 0, uptime, "/usr/bin/" + name);
+        proc.set_uid(uid);
+        proc.set_parent_pid(1);
+        proc.set_nice(nice);
+        return proc;
+    }
+
+    void write_cgroup(pid_t pid, const std::string& contents) {
+        fs::create_directories(root / std::to_string(pid));
+        std::ofstream(root / std::to_string(pid) / "cgroup") << contents;
+    }
+
+    void SetUp() override {
+        root = fs::temp_directory_path() / ("houston_scorer_" + std::to_string(getpid()));
+        fs::remove_all(root);
+        fs::create_directories(root);
+    }
+
+    void TearDown() override {
+        fs::remove_all(root);
+    }
+};
+
+TEST_F(KillCandidateScorerTest, RanksHeaviestProcessFirst) {
+    KillCandidateScorer scorer(nullptr, ScoringRules{}, root.string());
+    std::vector<Process> snapshot = {
+        make(100, "editor", 200000, 2.0),
+        make(200, "compiler", 1500000, 95.0),
+        make(300, "browser", 800000, 30.0),
+        make(400, "idle", 1000, 0.0),
+    };
+
+    auto candidates = scorer.rank(snapshot, 3);
+
+    ASSERT_EQ(candidates.size(), 3u);
+    EXPECT_EQ(candidates[0].process.get_pid(), 200);
+    EXPECT_EQ(candidates[1].process.get_pid(), 300);
+    EXPECT_GT(candidates[0].score, candidates[1].score);
+    EXPECT_EQ(candidates[0].reasons.front(), "95% CPU");
+}
+
+TEST_F(KillCandidateScorerTest, NeverRecommendsProtectedProcesses) {
+    KillCandidateScorer scorer(nullptr, ScoringRules{}, root.string());
+    Process kernel_thread(500, "kworker/0:1", 0, 90.0, 0, 3600, "");
+    Process own = make(getpid(), "tests", 4000000, 99.0);
+    std::vector<Process> snapshot = {
+        make(1, "systemd", 5000000, 99.0),
+        make(600, "sshd", 5000000, 99.0),
+        make(700, "rootd", 5000000, 99.0, 3600, 0, 0),
+        kernel_thread,
+        own,
+        make(800, "worker", 100000, 10.0),
+    };
+
+    auto candidates = scorer.rank(snapshot, 10);
+
+    ASSERT_EQ(candidates.size(), 1u);
+    EXPECT_EQ(candidates[0].process.get_pid(), 800);
+}
+
+TEST_F(KillCandidateScorerTest, SkipsProtectedCgroups) {
+    KillCandidateScorer scorer(nullptr, ScoringRules{}, root.string());
+    write_cgroup(900, "0::/system.slice/sshd.service\n");
+    write_cgroup(901, "12:memory:/user.slice/user-1000.slice\n0::/user.slice/user-1000.slice\n");
+    std::vector<Process> snapshot = {make(900, "session", 900000, 80.0), make(901, "job", 100000, 40.0)};
+
+    KillRecommendation recommendation = scorer.recommend(snapshot);
+
+    EXPECT_EQ(recommendation.pid, 901);
+    EXPECT_EQ(recommendation.name, "job");
+}
+
+TEST_F(KillCandidateScorerTest, GrowingRssOutranksLargerSteadyProcess) {
+    auto history = std::make_shared<ProcessHistoryStore>(10);
+    for (unsigned long kb = 100000; kb <= 200000; kb += 20000) {
+        history->record({make(10, "leaky", kb, 5.0), make(20, "cache", 400000, 5.0)});
+    }
+    KillCandidateScorer scorer(history, ScoringRules{}, root.string());
+    std::vector<Process> snapshot = {make(10, "leaky", 200000, 5.0), make(20, "cache", 400000, 5.0)};
+
+    auto candidates = scorer.rank(snapshot, 2);
+
+    ASSERT_EQ(candidates.size(), 2u);
+    EXPECT_EQ(candidates[0].process.get_pid(), 10);
+    EXPECT_NE(std::find(candidates[0].reasons.begin(), candidates[0].reasons.end(), "RSS +100% over 6 samples"),
+              candidates[0].reasons.end());
+}
+
+TEST_F(KillCandidateScorerTest, NicenessAndAgeAdjustScore) {
+    KillCandidateScorer scorer(nullptr, ScoringRules{}, root.string());
+    std::vector<Process> snapshot = {
+        make(10, "batch", 100000, 50.0, 3600, 19),
+        make(20, "service", 100000, 50.0, 3600, 0),
+        make(30, "fresh", 100000, 50.0, 5, 0),
+    };
+
+    auto candidates = scorer.rank(snapshot, 3);
+
+    ASSERT_EQ(candidates.size(), 3u);
+    EXPECT_EQ(candidates[0].process.get_pid(), 10);
+    EXPECT_EQ(candidates[1].process.get_pid(), 20);
+    EXPECT_EQ(candidates[2].process.get_pid(), 30);
+    EXPECT_EQ(candidates[2].reasons.back(), "started 5 s ago");
+}
+
+TEST_F(KillCandidateScorerTest, RecommendsNothingWhenIdle) {
+    KillCandidateScorer scorer(nullptr, ScoringRules{}, root.string());
+    std::vector<Process> snapshot;
+    for (pid_t pid = 100; pid < 150; pid++) {
+        snapshot.push_back(make(pid, "sleeper", 1000, 0.0));
+    }
+
+    EXPECT_EQ(scorer.recommend(snapshot).pid, -1);
+    EXPECT_EQ(scorer.recommend({}).pid, -1);
+}
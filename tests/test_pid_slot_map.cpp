@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+#include "../src/metrics/pid_slot_map.hpp"
+
+// Test fixture for PidSlotMap tests
+class PidSlotMapTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+    }
+};
+
+TEST_F(PidSlotMapTest, KeepsIndicesStableAcrossSnapshots) {
+    PidSlotMap map;
+    map.begin_snapshot();
+    PidSlot a = map.acquire(10, 5);
+    PidSlot b = map.acquire(20, 5);
+    map.release_unseen();
+
+    EXPECT_TRUE(a.fresh);
+    EXPECT_EQ(a.index, 0u);
+    EXPECT_EQ(b.index, 1u);
+
+    map.begin_snapshot();
+    PidSlot again = map.acquire(20, 5);
+    map.acquire(10, 5);
+    map.release_unseen();
+
+    EXPECT_FALSE(again.fresh);
+    EXPECT_EQ(again.index, 1u);
+    EXPECT_EQ(map.size(), 2u);
+    EXPECT_EQ(map.slot_count(), 2u);
+}
+
+TEST_F(PidSlotMapTest, ReusesSlotsOfExitedPids) {
+    PidSlotMap map;
+    map.begin_snapshot();
+    map.acquire(10, 1);
+    map.acquire(20, 1);
+    map.release_unseen();
+
+    map.begin_snapshot();
+    map.acquire(20, 1);
+    map.release_unseen();
+
+    uint32_t index = 0;
+    EXPECT_FALSE(map.find(10, index));
+    EXPECT_EQ(map.size(), 1u);
+
+    map.begin_snapshot();
+    map.acquire(20, 1);
+    PidSlot reused = map.acquire(30, 1);
+    map.release_unseen();
+
+    EXPECT_TRUE(reused.fresh);
+    EXPECT_EQ(reused.index, 0u);
+    EXPECT_EQ(map.slot_count(), 2u);
+    ASSERT_TRUE(map.find(30, index));
+    EXPECT_EQ(index, 0u);
+}
+
+TEST_F(PidSlotMapTest, DetectsPidReuseByStartTime) {
+    PidSlotMap map;
+    map.begin_snapshot();
+    map.acquire(10, 500);
+    map.release_unseen();
+
+    // A process started later got the pid between two snapshots
+    map.begin_snapshot();
+    PidSlot slot = map.acquire(10, 900);
+    map.release_unseen();
+
+    EXPECT_TRUE(slot.fresh);
+    EXPECT_EQ(slot.index, 0u);
+    EXPECT_EQ(map.get_generation(), 2u);
+
+    map.begin_snapshot();
+    EXPECT_FALSE(map.acquire(10, 900).fresh);
+    map.release_unseen();
+}
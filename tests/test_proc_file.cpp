@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+#include "../src/proc_io/proc_file.hpp"
+#include <unistd.h>
+
+// Test fixture for ProcFile and ProcFileCache tests
+class ProcFileTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+    }
+};
+
+TEST_F(ProcFileTest, ReadsSystemFile) {
+    ProcFile stat("/proc/stat");
+
+    ASSERT_TRUE(stat.is_open());
+    std::string_view contents = stat.read();
+
+    EXPECT_TRUE(contents.starts_with("cpu "));
+}
+
+TEST_F(ProcFileTest, RepeatedReadsReuseDescriptor) {
+    ProcFile loadavg("/proc/loadavg");
+    uint64_t opens_before = proc_file_stats().opens.load();
+
+    for (int i = 0; i < 10; i++) {
+        EXPECT_FALSE(loadavg.read().empty());
+    }
+
+    EXPECT_EQ(proc_file_stats().opens.load(), opens_before);
+}
+
+TEST_F(ProcFileTest, GrowsBufferForLargeFiles) {
+    ProcFile status("/proc/self/status", 16);
+
+    std::string_view contents = status.read();
+
+    EXPECT_GT(contents.size(), 16u);
+    EXPECT_FALSE(find_field(contents, "Pid:").empty());
+}
+
+TEST_F(ProcFileTest, MissingFileIsNotOpen) {
+    ProcFile missing("/proc/does_not_exist");
+
+    EXPECT_FALSE(missing.is_open());
+    EXPECT_TRUE(missing.read().empty());
+}
+
+TEST_F(ProcFileTest, CacheEvictsLeastRecentlyUsed) {
+    ProcFileCache cache(2);
+
+    EXPECT_FALSE(cache.read("/proc/stat").empty());
+    EXPECT_FALSE(cache.read("/proc/loadavg").empty());
+    EXPECT_FALSE(cache.read("/proc/stat").empty());
+    EXPECT_FALSE(cache.read("/proc/uptime").empty());
+
+    EXPECT_EQ(cache.size(), 2u);
+
+    // /proc/loadavg was least recently used, so reading it again must reopen
+    uint64_t opens_before = proc_file_stats().opens.load();
+    cache.read("/proc/stat");
+    EXPECT_EQ(proc_file_stats().opens.load(), opens_before);
+    cache.read("/proc/loadavg");
+    EXPECT_EQ(proc_file_stats().opens.load(), opens_before + 1);
+}
+
+TEST_F(ProcFileTest, CacheReadOfMissingPidFails) {
+    ProcFileCache cache(4);
+
+    EXPECT_TRUE(cache.read("/proc/999999999/io").empty());
+    EXPECT_EQ(cache.size(), 0u);
+}
+
+TEST_F(ProcFileTest, FindFieldAndParse) {
+    std::string_view contents = "rchar: 10\nread_bytes: 4096\nwrite_bytes: 8192\ncancelled_write_bytes: 1\n";
+    uint64_t value = 0;
+
+    EXPECT_TRUE(parse_u64(find_field(contents, "read_bytes:"), value));
+    EXPECT_EQ(value, 4096u);
+    EXPECT_TRUE(parse_u64(find_field(contents, "write_bytes:"), value));
+    EXPECT_EQ(value, 8192u);
+    EXPECT_TRUE(find_field(contents, "syscr:").empty());
+}
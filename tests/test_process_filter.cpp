@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+#include "../src/processes_list/process_filter.hpp"
+
+// Test fixture for ProcessFilter tests
+class ProcessFilterTest : public ::testing::Test {
+protected:
+    std::vector<Process> processes;
+
+    void SetUp() override {
+        // pid, name, memory (KB), cpu, network, time, command
+        processes.push_back(Process(1000, "java", 4 * 1024 * 1024, 35.0, 2048, 600, "/usr/bin/java -jar svc.jar"));
+        processes.push_back(Process(2000, "javac", 512 * 1024, 5.0, 0, 30, "/usr/bin/javac Main.java"));
+        processes.push_back(Process(3000, "postgres", 2 * 1024 * 1024, 25.0, 100, 9000, "postgres: writer"));
+        processes.push_back(Process(4000, "bash", 4 * 1024, 0.0, 0, 1, "-bash"));
+        processes[0].set_uid(1001);
+        processes[1].set_uid(1001);
+        processes[2].set_uid(0);
+        processes[3].set_uid(1002);
+    }
+
+    std::vector<pid_t> apply(const ProcessFilter& filter) {
+        std::vector<pid_t> pids;
+        for (const auto& proc : processes) {
+            if (filter.matches(proc)) {
+                pids.push_back(proc.get_pid());
+            }
+        }
+        return pids;
+    }
+};
+
+// ===========================
+// Parse Tests
+// ===========================
+
+TEST_F(ProcessFilterTest, DetectsFilterSyntax) {
+    EXPECT_TRUE(ProcessFilter::looks_like_filter("cpu>20"));
+    EXPECT_TRUE(ProcessFilter::looks_like_filter("chrome !name~^java"));
+    EXPECT_FALSE(ProcessFilter::looks_like_filter("chrome"));
+    EXPECT_FALSE(ProcessFilter::looks_like_filter("1234"));
+    EXPECT_FALSE(ProcessFilter::looks_like_filter("a=b"));
+}
+
+TEST_F(ProcessFilterTest, CompilesValidQuery) {
+    ProcessFilter filter;
+
+    EXPECT_TRUE(filter.compile("cpu>20 mem>1024 name~^java net>0"));
+    EXPECT_TRUE(filter.get_error().empty());
+}
+
+TEST_F(ProcessFilterTest, RejectsBadTerms) {
+    ProcessFilter filter;
+
+    EXPECT_FALSE(filter.compile("cpu>abc"));
+    EXPECT_NE(filter.get_error().find("number"), std::string::npos);
+    EXPECT_FALSE(filter.compile("colour=red"));
+    EXPECT_FALSE(filter.compile("cpu~5"));
+    EXPECT_FALSE(filter.compile("name>java"));
+    EXPECT_FALSE(filter.compile("name~(unclosed"));
+    EXPECT_FALSE(filter.compile("user=no_such_user_houston"));
+    EXPECT_TRUE(filter.empty());
+}
+
+// ===========================
+// Evaluate Tests
+// ===========================
+
+TEST_F(ProcessFilterTest, NumericComparisons) {
+    ProcessFilter filter;
+
+    ASSERT_TRUE(filter.compile("cpu>20"));
+    EXPECT_EQ(apply(filter), (std::vector<pid_t>{1000, 3000}));
+
+    // mem is in MB, like the table
+    ASSERT_TRUE(filter.compile("mem>=2048"));
+    EXPECT_EQ(apply(filter), (std::vector<pid_t>{1000, 3000}));
+
+    ASSERT_TRUE(filter.compile("net>0 time<1000"));
+    EXPECT_EQ(apply(filter), (std::vector<pid_t>{1000}));
+}
+
+TEST_F(ProcessFilterTest, RegexAndExactText) {
+    ProcessFilter filter;
+
+    ASSERT_TRUE(filter.compile("name~^JAVA"));
+    EXPECT_EQ(apply(filter), (std::vector<pid_t>{1000, 2000}));
+
+    ASSERT_TRUE(filter.compile("name=java"));
+    EXPECT_EQ(apply(filter), (std::vector<pid_t>{1000}));
+
+    ASSERT_TRUE(filter.compile("cmd~svc\\.jar"));
+    EXPECT_EQ(apply(filter), (std::vector<pid_t>{1000}));
+}
+
+TEST_F(ProcessFilterTest, UserByUidAndName) {
+    ProcessFilter filter;
+
+    ASSERT_TRUE(filter.compile("user=1001"));
+    EXPECT_EQ(apply(filter), (std::vector<pid_t>{1000, 2000}));
+
+    ASSERT_TRUE(filter.compile("user=root"));
+    EXPECT_EQ(apply(filter), (std::vector<pid_t>{3000}));
+}
+
+TEST_F(ProcessFilterTest, NegationAndAlternatives) {
+    ProcessFilter filter;
+
+    ASSERT_TRUE(filter.compile("!name~^java cpu>=0"));
+    EXPECT_EQ(apply(filter), (std::vector<pid_t>{3000, 4000}));
+
+    ASSERT_TRUE(filter.compile("name=bash | cpu>30"));
+    EXPECT_EQ(apply(filter), (std::vector<pid_t>{1000, 4000}));
+}
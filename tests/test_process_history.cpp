@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+#include "../src/metrics/process_history.hpp"
+
+// Test fixture for ProcessHistoryStore tests
+class ProcessHistoryTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+    }
+};
+
+TEST_F(ProcessHistoryTest, RecordsSamplesPerPid) {
+    ProcessHistoryStore store(4);
+    store.record({Process(10, "a", 1000, 12.5, 300, 5), Process(20, "b", 2000, 50.0, 0, 5)});
+    store.record({Process(10, "a", 1100, 25.0, 400, 6), Process(20, "b", 2000, 50.0, 0, 6)});
+
+    ProcessHistory history = store.get(10);
+    EXPECT_EQ(history.cpu, (std::vector<float>{12.5f, 25.0f}));
+    EXPECT_EQ(history.memory, (std::vector<float>{1000.0f, 1100.0f}));
+    EXPECT_EQ(history.network, (std::vector<float>{300.0f, 400.0f}));
+    EXPECT_EQ(history.total_samples, 2u);
+    EXPECT_EQ(store.get_tracked_count(), 2u);
+}
+
+TEST_F(ProcessHistoryTest, KeepsOnlyTheLastCapacitySamples) {
+    ProcessHistoryStore store(3);
+    for (int i = 1; i <= 5; i++) {
+        store.record({Process(10, "a", i, 0.0, 0, i)});
+    }
+
+    ProcessHistory history = store.get(10);
+    EXPECT_EQ(history.memory, (std::vector<float>{3.0f, 4.0f, 5.0f}));
+    EXPECT_EQ(history.total_samples, 5u);
+}
+
+TEST_F(ProcessHistoryTest, MemoryTrendMatchesOldestAndNewest) {
+    ProcessHistoryStore store(3);
+    for (int i = 1; i <= 5; i++) {
+        store.record({Process(10, "a", i * 100, 0.0, 0, i)});
+    }
+
+    MemoryTrend trend = store.get_memory_trend(10);
+    EXPECT_FLOAT_EQ(trend.oldest_kb, 300.0f);
+    EXPECT_FLOAT_EQ(trend.newest_kb, 500.0f);
+    EXPECT_EQ(trend.samples, 3u);
+    EXPECT_EQ(store.get_memory_trend(99).samples, 0u);
+}
+
+TEST_F(ProcessHistoryTest, FreesSlotsOfExitedProcesses) {
+    ProcessHistoryStore store(4);
+    store.record({Process(10, "a", 1, 0.0, 0, 1), Process(20, "b", 2, 0.0, 0, 1)});
+    store.record({Process(20, "b", 2, 0.0, 0, 2)});
+
+    EXPECT_TRUE(store.get(10).cpu.empty());
+    EXPECT_EQ(store.get_tracked_count(), 1u);
+
+    // The freed slot is reused and starts out empty
+    store.record({Process(20, "b", 2, 0.0, 0, 3), Process(30, "c", 7, 0.0, 0, 1)});
+    EXPECT_EQ(store.get(30).memory, (std::vector<float>{7.0f}));
+}
+
+TEST_F(ProcessHistoryTest, ResetsWhenPidIsReused) {
+    ProcessHistoryStore store(4);
+    Process old_process(10, "old", 1, 0.0, 0, 500);
+    old_process.set_start_time(100);
+    store.record({old_process});
+    old_process.set_memory_usage(2);
+    store.record({old_process});
+    // Same pid, but the process started at a different time
+    Process new_process(10, "new", 9, 0.0, 0, 501);
+    new_process.set_start_time(400);
+    store.record({new_process});
+
+    ProcessHistory history = store.get(10);
+    EXPECT_EQ(history.memory, (std::vector<float>{9.0f}));
+    EXPECT_EQ(history.total_samples, 1u);
+}
+
+TEST_F(ProcessHistoryTest, QuantizesAndSaturates) {
+    ProcessHistoryStore store(2);
+    store.record({Process(10, "a", 0, 33.333, 0, 1), Process(20, "b", 0, -1.0, 0, 1)});
+
+    EXPECT_NEAR(store.get(10).cpu[0], 33.33f, 0.001f);
+    EXPECT_FLOAT_EQ(store.get(20).cpu[0], 0.0f);
+}
+
+TEST_F(ProcessHistoryTest, KeepsTheTimeOfEachSample) {
+    ProcessHistoryStore store(3);
+    std::chrono::steady_clock::time_point start{};
+    for (int i = 0; i < 4; i++) {
+        std::vector<Process> snapshot = {Process(10, "a", 1, 0.0, 0, 1)};
+        if (i >= 2) {
+            snapshot.push_back(Process(20, "b", 1, 0.0, 0, 1));
+        }
+        store.record(snapshot, start + std::chrono::seconds(5 * i));
+    }
+
+    EXPECT_EQ(store.get(10).times, (std::vector<std::chrono::steady_clock::time_point>{
+        start + std::chrono::seconds(5), start + std::chrono::seconds(10), start + std::chrono::seconds(15)}));
+    // A pid seen later lines up with the newest snapshots
+    EXPECT_EQ(store.get(20).times, (std::vector<std::chrono::steady_clock::time_point>{
+        start + std::chrono::seconds(10), start + std::chrono::seconds(15)}));
+}
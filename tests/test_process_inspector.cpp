@@ -0,0 +1,154 @@
+#include <gtest/gtest.h>
+#include "../src/processes_list/process_inspector.hpp"
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <unistd.h>
+
+namespace fs = std::filesystem;
+
+// Builds a fake /proc/[pid] directory with the files the inspector reads
+class ProcessInspectorTest : public ::testing::Test {
+protected:
+    fs::path root;
+
+    void write(const fs::path& path, const std::string& contents) {
+        fs::create_directories(path.parent_path());
+        std::ofstream(path) << contents;
+    }
+
+    void SetUp() override {
+        root = fs::temp_directory_path() / ("houston_inspector_" + std::to_string(getpid()));
+        fs::remove_all(root);
+
+        fs::path proc = root / "42";
+        fs::create_directories(proc / "fd");
+        fs::create_symlink("/var/log/app.log", proc / "fd" / "3");
+        fs::create_symlink("socket:[1234]", proc / "fd" / "4");
+        fs::create_symlink("pipe:[99]", proc / "fd" / "5");
+        fs::create_symlink("/dev/null", proc / "fd" / "0");
+
+        write(proc / "wchan", "do_epoll_wait");
+        write(proc / "cgroup", "0::/user.slice/app.service\n");
+    }
+
+    void TearDown() override {
+        fs::remove_all(root);
+    }
+
+    // Polls until the inspector has a result for the section
+    std::optional<InspectionResult> wait_for(ProcessInspector& inspector, pid_t pid, InspectionSection section) {
+        for (int i = 0; i < 200; i++) {
+            auto result = inspector.get(pid, section);
+            if (result) {
+                return result;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        return std::nullopt;
+    }
+};
+
+TEST_F(ProcessInspectorTest, SummarizesFdTargets) {
+    FdSummary fds = summarize_fd_targets({"/home/a.txt", "socket:[1]", "socket:[2]", "pipe:[3]",
+                                          "anon_inode:[eventfd]", "/dev/pts/0", ""});
+
+    EXPECT_EQ(fds.total, 7u);
+    EXPECT_EQ(fds.files, 1u);
+    EXPECT_EQ(fds.sockets, 2u);
+    EXPECT_EQ(fds.pipes, 1u);
+    EXPECT_EQ(fds.anon_inodes, 1u);
+    EXPECT_EQ(fds.devices, 1u);
+    EXPECT_EQ(fds.other, 1u);
+}
+
+TEST_F(ProcessInspectorTest, ParsesSmapsByMappingKind) {
+    std::string smaps =
+        "55d0c0000000-55d0c0021000 rw-p 00000000 00:00 0                          [heap]\n"
+        "Size:                132 kB\n"
+        "Rss:                 100 kB\n"
+        "7f0000000000-7f0000100000 rw-p 00000000 00:00 0 \n"
+        "Rss:                  40 kB\n"
+        "7f0000200000-7f0000300000 r-xp 00000000 08:01 1234                       /usr/lib/libc.so.6\n"
+        "Rss:                 800 kB\n"
+        "7ffc00000000-7ffc00021000 rw-p 00000000 00:00 0                          [stack]\n"
+        "Rss:                  12 kB\n"
+        "7ffc00100000-7ffc00102000 r-xp 00000000 00:00 0                          [vdso]\n"
+        "Rss:                   4 kB\n";
+
+    MemoryMapSummary map = parse_smaps(smaps);
+
+    EXPECT_EQ(map.mappings, 5u);
+    EXPECT_EQ(map.heap_kb, 100u);
+    EXPECT_EQ(map.anon_kb, 40u);
+    EXPECT_EQ(map.file_kb, 800u);
+    EXPECT_EQ(map.stack_kb, 12u);
+    EXPECT_EQ(map.other_kb, 4u);
+}
+
+TEST_F(ProcessInspectorTest, ParsesLimitsAndEnviron) {
+    std::string limits =
+        "Limit                     Soft Limit           Hard Limit           Units     \n"
+        "Max cpu time              unlimited            unlimited            seconds   \n"
+        "Max open files            1024                 524288               files     \n";
+
+    auto parsed = parse_limits(limits);
+    ASSERT_EQ(parsed.size(), 2u);
+    EXPECT_EQ(parsed[1].name, "Max open files");
+    EXPECT_EQ(parsed[1].soft, "1024");
+    EXPECT_EQ(parsed[1].hard, "524288");
+    EXPECT_EQ(parsed[1].units, "files");
+
+    EnvironmentSummary env = parse_environ(std::string_view("A=1\0PATH=/bin\0", 14));
+    EXPECT_EQ(env.variables, 2u);
+    EXPECT_EQ(env.bytes, 14u);
+}
+
+TEST_F(ProcessInspectorTest, LoadsSectionsFromProcTree) {
+    InspectionResult files = load_inspection_section(42, InspectionSection::FILES, root.string());
+    ASSERT_TRUE(files.error.empty());
+    EXPECT_EQ(files.rows[0], (std::pair<std::string, std::string>{"Total", "4"}));
+
+    InspectionResult wchan = load_inspection_section(42, InspectionSection::WCHAN, root.string());
+    EXPECT_EQ(wchan.rows[0].second, "do_epoll_wait");
+
+    InspectionResult cgroup = load_inspection_section(42, InspectionSection::CGROUP, root.string());
+    EXPECT_EQ(cgroup.rows[0], (std::pair<std::string, std::string>{"unified", "/user.slice/app.service"}));
+
+    InspectionResult missing = load_inspection_section(43, InspectionSection::FILES, root.string());
+    EXPECT_FALSE(missing.error.empty());
+}
+
+TEST_F(ProcessInspectorTest, LoadsLazilyInTheBackground) {
+    std::atomic<int> loaded{0};
+    ProcessInspector inspector([&] { loaded++; }, std::chrono::milliseconds(60000), root.string());
+    EXPECT_EQ(inspector.get_load_count(), 0u);
+
+    // The first ask only queues the load
+    auto result = wait_for(inspector, 42, InspectionSection::WCHAN);
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(result->rows[0].second, "do_epoll_wait");
+    EXPECT_EQ(loaded.load(), 1);
+
+    // Fresh results are served without reading again
+    inspector.get(42, InspectionSection::WCHAN);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(inspector.get_load_count(), 1u);
+}
+
+TEST_F(ProcessInspectorTest, RefreshesStaleSections) {
+    ProcessInspector inspector(nullptr, std::chrono::milliseconds(0), root.string());
+    ASSERT_TRUE(wait_for(inspector, 42, InspectionSection::WCHAN).has_value());
+
+    write(root / "42" / "wchan", "0");
+    std::optional<InspectionResult> result;
+    for (int i = 0; i < 200; i++) {
+        result = inspector.get(42, InspectionSection::WCHAN);
+        if (result && result->rows[0].second == "running") {
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    EXPECT_EQ(result->rows[0].second, "running");
+}
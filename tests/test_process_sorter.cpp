@@ -0,0 +1,47 @@
+#include <gtest/gtest.h>
+#include "../src/smart_sparker/process_sorter.hpp"
+
+// Test fixture for top-K process selection
+class ProcessSorterTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+    }
+};
+
+static std::vector<pid_t> pids_of(const std::vector<Process>& processes) {
+    std::vector<pid_t> pids;
+    for (const auto& proc : processes) {
+        pids.push_back(proc.get_pid());
+    }
+    return pids;
+}
+
+TEST_F(ProcessSorterTest, TakesTopKPerMetricInOrder) {
+    std::vector<Process> snapshot;
+    for (pid_t pid = 1; pid <= 10; pid++) {
+        // CPU rises with pid, memory falls with it
+        snapshot.emplace_back(pid, "p" + std::to_string(pid), 1000 - pid * 10, pid * 1.0);
+    }
+
+    auto top = select_top_processes(snapshot, {SortMetric::CPU}, 3);
+    EXPECT_EQ(pids_of(top), (std::vector<pid_t>{10, 9, 8}));
+
+    top = select_top_processes(snapshot, {SortMetric::CPU, SortMetric::MEMORY}, 3);
+    EXPECT_EQ(pids_of(top), (std::vector<pid_t>{10, 9, 8, 1, 2, 3}));
+}
+
+TEST_F(ProcessSorterTest, MergesWithoutDuplicates) {
+    std::vector<Process> snapshot = {
+        Process(1, "hog", 5000, 90.0, 700),
+        Process(2, "small", 10, 1.0, 0),
+        Process(3, "net", 20, 2.0, 9000),
+    };
+
+    auto top = select_top_processes(snapshot, {SortMetric::CPU, SortMetric::MEMORY, SortMetric::NETWORK}, 1);
+    EXPECT_EQ(pids_of(top), (std::vector<pid_t>{1, 3}));
+
+    // K larger than the snapshot is the whole snapshot, once
+    top = select_top_processes(snapshot, {SortMetric::CPU, SortMetric::MEMORY}, 20);
+    EXPECT_EQ(top.size(), 3u);
+    EXPECT_TRUE(select_top_processes({}, {SortMetric::CPU}, 20).empty());
+}
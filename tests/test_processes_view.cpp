@@ -4,6 +4,7 @@
 #include <chrono>
 #include "../src/processes_list/process.hpp"
 #include "../src/ui/process_view/processes_view_inputs.hpp"
+#include "../src/ui/process_view/processes_view_table.hpp"
 #include "ftxui/component/event.hpp"
 #include "ftxui/screen/box.hpp"
 
@@ -388,6 +389,44 @@ TEST_F(ProcessesViewTest, MouseWheelUpAtZeroStaysAtZero) {
     EXPECT_EQ(*selected_index, 0);
 }
 
+TEST_F(ProcessesViewTest, MouseMotionReportsOnlyHoverChanges) {
+    Box row;
+    row.x_min = 0;
+    row.x_max = 40;
+    row.y_min = 5;
+    row.y_max = 5;
+    boxes->push_back(row);
+
+    Mouse mouse_event;
+    mouse_event.button = Mouse::None;
+    mouse_event.motion = Mouse::Moved;
+    mouse_event.x = 10;
+    mouse_event.y = 5;
+    Event event = Event::Mouse("", mouse_event);
+
+    auto move = [&] {
+        return handle_processes_view_event(
+            event, selected_index, hover_index, hover_sigterm, hover_sigkill,
+            search_mode, search_phrase, boxes, sigterm_boxes, sigkill_boxes,
+            processes, processes_mutex,
+            show_detail_view, detail_process_pid, last_click_time, last_clicked_index, displayed_pids
+        );
+    };
+
+    EXPECT_TRUE(move());
+    EXPECT_EQ(*hover_index, 0);
+
+    // Moving within the same row leaves nothing to redraw
+    mouse_event.x = 20;
+    event = Event::Mouse("", mouse_event);
+    EXPECT_FALSE(move());
+
+    mouse_event.y = 9;
+    event = Event::Mouse("", mouse_event);
+    EXPECT_TRUE(move());
+    EXPECT_EQ(*hover_index, -1);
+}
+
 // ===========================
 // Kill Process Keyboard Shortcuts Tests
 // ===========================
@@ -493,3 +532,64 @@ TEST_F(ProcessesViewTest, DisplayedPidsTracksCorrectPids) {
     EXPECT_EQ((*displayed_pids)[3], 4000);
 }
 
+// ===========================
+// Virtualized Table Tests
+// ===========================
+
+TEST_F(ProcessesViewTest, TableWindowCoversViewportPlusOverscan) {
+    auto window = ProcessesView::compute_table_window(50000, 0, 0, 40, 4);
+
+    EXPECT_EQ(window.first, 0);
+    EXPECT_EQ(window.end, 44);
+}
+
+TEST_F(ProcessesViewTest, TableWindowScrollsToKeepSelectionVisible) {
+    // Moving past the bottom scrolls just enough to show the selected row last
+    auto window = ProcessesView::compute_table_window(50000, 45, 0, 40, 4);
+    EXPECT_EQ(window.first, 6);
+
+    // Moving above the top scrolls it to the first row
+    window = ProcessesView::compute_table_window(50000, 100, 200, 40, 4);
+    EXPECT_EQ(window.first, 100);
+
+    // Inside the viewport the window doesn't move
+    window = ProcessesView::compute_table_window(50000, 110, 100, 40, 4);
+    EXPECT_EQ(window.first, 100);
+}
+
+TEST_F(ProcessesViewTest, TableWindowClampsToListEnd) {
+    // List shrank under a scrolled window: pull it back so the viewport stays full
+    auto window = ProcessesView::compute_table_window(50, 45, 40, 20, 4);
+
+    EXPECT_EQ(window.first, 30);
+    EXPECT_EQ(window.end, 50);
+
+    window = ProcessesView::compute_table_window(0, 0, 10, 20, 4);
+    EXPECT_EQ(window.first, 0);
+    EXPECT_EQ(window.end, 0);
+}
+
+TEST_F(ProcessesViewTest, MouseClickSelectsRowRelativeToWindow) {
+    auto first_visible_index = std::make_shared<int>(100);
+    boxes->resize(2);
+    (*boxes)[1] = Box{0, 80, 6, 6};
+
+    Mouse mouse_event;
+    mouse_event.button = Mouse::Left;
+    mouse_event.motion = Mouse::Released;
+    mouse_event.x = 10;
+    mouse_event.y = 6;
+    Event event = Event::Mouse("", mouse_event);
+
+    bool handled = handle_processes_view_event(
+        event, selected_index, hover_index, hover_sigterm, hover_sigkill,
+        search_mode, search_phrase, boxes, sigterm_boxes, sigkill_boxes,
+        processes, processes_mutex,
+        show_detail_view, detail_process_pid, last_click_time, last_clicked_index, displayed_pids,
+        first_visible_index
+    );
+
+    EXPECT_TRUE(handled);
+    EXPECT_EQ(*selected_index, 101);
+    EXPECT_EQ(*hover_index, 101);
+}
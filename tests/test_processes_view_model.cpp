@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include "../src/processes_list/process.hpp"
+#include "../src/ui/process_view/processes_view_model.hpp"
+
+using namespace ProcessesView;
+
+// Test fixture for the shared processes view-model
+class ProcessesViewModelTest : public ::testing::Test {
+protected:
+    std::vector<Process> processes;
+    std::mutex processes_mutex;
+    std::atomic<uint64_t> processes_version{0};
+    ViewState state;
+
+    void SetUp() override {
+        processes.emplace_back(100, "alpha", 300, 5.0);
+        processes.emplace_back(200, "beta", 100, 50.0);
+        processes.emplace_back(300, "gamma", 200, 20.0);
+    }
+
+    void replace_snapshot(std::vector<Process> snapshot) {
+        std::lock_guard<std::mutex> lock(processes_mutex);
+        processes = std::move(snapshot);
+        processes_version++;
+    }
+};
+
+TEST_F(ProcessesViewModelTest, RepeatedRendersReuseRows) {
+    ProcessesViewModel model(processes, processes_mutex, processes_version);
+
+    const auto& rows = model.get_rows(state);
+    ASSERT_EQ(rows.size(), 3u);
+    EXPECT_EQ(rows[0].get_pid(), 200); // Highest CPU first by default
+    EXPECT_EQ(model.get_version(), 1u);
+
+    // Mouse movement and key presses redraw without changing the key
+    for (int i = 0; i < 100; i++) {
+        model.get_rows(state);
+    }
+    EXPECT_EQ(model.get_version(), 1u);
+    EXPECT_EQ(model.get_hits(), 100u);
+}
+
+TEST_F(ProcessesViewModelTest, RecomputesOnNewSnapshot) {
+    ProcessesViewModel model(processes, processes_mutex, processes_version);
+    model.get_rows(state);
+
+    replace_snapshot({Process(400, "delta", 10, 90.0)});
+
+    const auto& rows = model.get_rows(state);
+    ASSERT_EQ(rows.size(), 1u);
+    EXPECT_EQ(rows[0].get_pid(), 400);
+    EXPECT_EQ(model.get_version(), 2u);
+}
+
+TEST_F(ProcessesViewModelTest, RecomputesOnSortAndFilterChange) {
+    ProcessesViewModel model(processes, processes_mutex, processes_version);
+    model.get_rows(state);
+
+    *state.sort_column = SortColumn::MEMORY;
+    EXPECT_EQ(model.get_rows(state)[0].get_pid(), 100);
+    EXPECT_EQ(model.get_version(), 2u);
+
+    *state.sort_ascending = true;
+    EXPECT_EQ(model.get_rows(state)[0].get_pid(), 200);
+    EXPECT_EQ(model.get_version(), 3u);
+
+    *state.search_phrase = "gam";
+    ASSERT_EQ(model.get_rows(state).size(), 1u);
+    EXPECT_EQ(model.get_version(), 4u);
+
+    model.get_rows(state);
+    EXPECT_EQ(model.get_version(), 4u);
+}
+
+TEST_F(ProcessesViewModelTest, FindsProcessWithoutRecomputing) {
+    ProcessesViewModel model(processes, processes_mutex, processes_version);
+
+    auto proc = model.find_process(300);
+    ASSERT_TRUE(proc.has_value());
+    EXPECT_EQ(proc->get_process_name(), "gamma");
+    EXPECT_FALSE(model.find_process(999).has_value());
+    EXPECT_EQ(model.get_version(), 0u);
+}
+
+TEST_F(ProcessesViewModelTest, FindsSubtreeAcrossSnapshot) {
+    std::vector<Process> snapshot = {Process(1, "init"), Process(10, "shell"), Process(11, "worker"),
+                                     Process(12, "worker"), Process(20, "other")};
+    snapshot[1].set_parent_pid(1);
+    snapshot[2].set_parent_pid(10);
+    snapshot[3].set_parent_pid(11);
+    snapshot[4].set_parent_pid(1);
+    replace_snapshot(snapshot);
+    ProcessesViewModel model(processes, processes_mutex, processes_version);
+
+    auto subtree = model.find_subtree(10);
+    ASSERT_EQ(subtree.size(), 3u);
+    EXPECT_EQ(subtree[0].get_pid(), 10);
+    EXPECT_EQ(subtree[1].get_pid(), 11);
+    EXPECT_EQ(subtree[2].get_pid(), 12);
+
+    EXPECT_EQ(model.find_subtree(1).size(), 5u);
+    EXPECT_TRUE(model.find_subtree(999).empty());
+}
@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+#include "../src/processes_list/procfs_processes.hpp"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <unistd.h>
+
+namespace fs = std::filesystem;
+
+// Builds a fake /proc with two processes
+class ProcfsProcessesTest : public ::testing::Test {
+protected:
+    fs::path root;
+
+    void write(const fs::path& path, const std::string& contents) {
+        fs::create_directories(path.parent_path());
+        std::ofstream(path) << contents;
+    }
+
+    // Fields after the name: state, then placeholders with ppid at 4,
+    // utime/stime at 14/15, starttime at 22 and rss at 24
+    static std::string stat_line(int pid, const std::string& name, uint64_t utime, uint64_t stime,
+                                 uint64_t start, uint64_t rss, uint64_t ppid = 0, int nice = 0) {
+        std::string line = std::to_string(pid) + " (" + name + ") S";
+        for (int field = 4; field <= 24; field++) {
+            int64_t value = 0;
+            if (field == 4) value = ppid;
+            if (field == 19) value = nice;
+            if (field == 14) value = utime;
+            if (field == 15) value = stime;
+            if (field == 22) value = start;
+            if (field == 24) value = rss;
+            line += " " + std::to_string(value);
+        }
+        return line + " 0 0 0\n";
+    }
+
+    void SetUp() override {
+        root = fs::temp_directory_path() / ("houston_procfs_" + std::to_string(getpid()));
+        fs::remove_all(root);
+
+        write(root / "stat", "cpu  1 2 3 4\nbtime 1000\nprocesses 5\n");
+        write(root / "1" / "stat", stat_line(1, "init", 10, 5, 0, 100));
+        write(root / "1" / "cmdline", std::string("/sbin/init\0splash\0", 18));
+        write(root / "42" / "stat", stat_line(42, "worker", 0, 0, 50, 8));
+        write(root / "42" / "cmdline", "");
+        write(root / "self" / "stat", "not a pid");
+    }
+
+    void TearDown() override {
+        fs::remove_all(root);
+    }
+};
+
+TEST_F(ProcfsProcessesTest, ParsesStatWithTrickyName) {
+    ProcStat stat;
+    ASSERT_TRUE(parse_proc_stat(stat_line(7, "a) (b", 3, 4, 99, 12, 5, -5), stat));
+
+    EXPECT_EQ(stat.name, "a) (b");
+    EXPECT_EQ(stat.parent_pid, 5);
+    EXPECT_EQ(stat.nice, -5);
+    EXPECT_EQ(stat.cpu_ticks, 7u);
+    EXPECT_EQ(stat.start_ticks, 99u);
+    EXPECT_EQ(stat.rss_pages, 12u);
+}
+
+TEST_F(ProcfsProcessesTest, RejectsTruncatedStat) {
+    ProcStat stat;
+    EXPECT_FALSE(parse_proc_stat("7 (short) S 1 2 3", stat));
+    EXPECT_FALSE(parse_proc_stat("", stat));
+}
+
+TEST_F(ProcfsProcessesTest, ReadsNumericEntriesOnly) {
+    ProcfsProcessReader reader(root.string());
+    auto processes = reader.read(false);
+
+    ASSERT_EQ(processes.size(), 2u);
+    std::sort(processes.begin(), processes.end(),
+              [](const Process& a, const Process& b) { return a.get_pid() < b.get_pid(); });
+
+    EXPECT_EQ(processes[0].get_process_name(), "init");
+    EXPECT_EQ(processes[0].get_command(), "/sbin/init splash");
+    EXPECT_EQ(processes[0].get_memory_usage(), 100u * (sysconf(_SC_PAGESIZE) / 1024));
+    // No previous sample yet
+    EXPECT_DOUBLE_EQ(processes[0].get_cpu_usage(), 0.0);
+    // Started at boot (btime 1000), so its uptime is the time since then
+    EXPECT_GT(processes[0].get_cpu_time(), 0u);
+    EXPECT_EQ(processes[1].get_process_name(), "worker");
+    EXPECT_EQ(processes[1].get_start_time(), 50u);
+}
+
+TEST_F(ProcfsProcessesTest, DerivesCpuFromTickDeltas) {
+    ProcfsProcessReader reader(root.string());
+    reader.read(false);
+
+    usleep(50000);
+    write(root / "1" / "stat", stat_line(1, "init", 1000, 5, 0, 100));
+    auto processes = reader.read(false);
+
+    auto init = std::find_if(processes.begin(), processes.end(),
+                             [](const Process& p) { return p.get_pid() == 1; });
+    ASSERT_NE(init, processes.end());
+    EXPECT_GT(init->get_cpu_usage(), 0.0);
+}
+
+TEST_F(ProcfsProcessesTest, DropsExitedProcesses) {
+    ProcfsProcessReader reader(root.string());
+    reader.read(false);
+
+    fs::remove_all(root / "42");
+    auto processes = reader.read(false);
+
+    ASSERT_EQ(processes.size(), 1u);
+    EXPECT_EQ(processes[0].get_pid(), 1);
+}
+
+TEST_F(ProcfsProcessesTest, CachesMorePidsThanTheInitialSlots) {
+    for (int pid = 1000; pid < 2100; pid++) {
+        write(root / std::to_string(pid) / "stat", stat_line(pid, "fork", 0, 0, 10, 1));
+    }
+    ProcfsProcessReader reader(root.string(), 4096);
+    ASSERT_EQ(reader.read(false).size(), 1102u);
+
+    // Every stat file stayed open, so the next tick opens nothing
+    uint64_t opens_before = proc_file_stats().opens.load();
+    ASSERT_EQ(reader.read(false).size(), 1102u);
+    EXPECT_EQ(proc_file_stats().opens.load(), opens_before);
+    EXPECT_EQ(reader.get_open_files(), 1102u);
+}
+
+TEST_F(ProcfsProcessesTest, ReadsPidsBeyondTheDescriptorCapWithoutThrashing) {
+    for (int pid = 1000; pid < 1148; pid++) {
+        write(root / std::to_string(pid) / "stat", stat_line(pid, "fork", 0, 0, 10, 1));
+    }
+    ProcfsProcessReader reader(root.string(), 100);
+    ASSERT_EQ(reader.read(false).size(), 150u);
+
+    // The cached 100 stay put; only the 50 over the cap are reopened
+    uint64_t opens_before = proc_file_stats().opens.load();
+    ASSERT_EQ(reader.read(false).size(), 150u);
+    EXPECT_EQ(proc_file_stats().opens.load(), opens_before + 50);
+    EXPECT_EQ(reader.get_open_files(), 100u);
+}
@@ -0,0 +1,52 @@
+#include <gtest/gtest.h>
+#include "../src/ui/redraw_filter.hpp"
+#include "../src/ui/frame_pacer.hpp"
+#include <thread>
+
+// Test fixture for RedrawFilter tests
+class RedrawFilterTest : public ::testing::Test {
+protected:
+    RedrawFilter filter;
+
+    static Event motion(int x, int y) {
+        Mouse mouse;
+        mouse.button = Mouse::None;
+        mouse.motion = Mouse::Moved;
+        mouse.x = x;
+        mouse.y = y;
+        return Event::Mouse("", mouse);
+    }
+};
+
+TEST_F(RedrawFilterTest, ResizeRebuildsTheFrame) {
+    FramePacer pacer([] {}, 1000);
+    ASSERT_TRUE(pacer.begin_frame());
+    pacer.end_frame();
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    EXPECT_FALSE(pacer.begin_frame());
+
+    // FTXUI reports a terminal resize as Special({0}), which no handler takes
+    if (filter.needs_frame(Event::Special({0}))) {
+        pacer.mark_dirty();
+    }
+    EXPECT_TRUE(pacer.begin_frame());
+}
+
+TEST_F(RedrawFilterTest, PacerRedrawsAreNotInput) {
+    EXPECT_FALSE(filter.needs_frame(Event::Custom));
+    EXPECT_TRUE(filter.needs_frame(Event::ArrowDown));
+    EXPECT_TRUE(filter.needs_frame(Event::Character('x')));
+}
+
+TEST_F(RedrawFilterTest, SkipsOnlyMotionAtTheSamePosition) {
+    EXPECT_TRUE(filter.needs_frame(motion(3, 4)));
+    EXPECT_FALSE(filter.needs_frame(motion(3, 4)));
+    EXPECT_TRUE(filter.needs_frame(motion(4, 4)));
+
+    Mouse click;
+    click.button = Mouse::Left;
+    click.motion = Mouse::Pressed;
+    click.x = 4;
+    click.y = 4;
+    EXPECT_TRUE(filter.needs_frame(Event::Mouse("", click)));
+}
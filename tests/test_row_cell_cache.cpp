@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+#include "../src/ui/process_view/processes_view_row_cache.hpp"
+
+using namespace ProcessesView;
+
+// Test fixture for RowCellCache tests
+class RowCellCacheTest : public ::testing::Test {
+protected:
+    RowCellCache cache;
+
+    void SetUp() override {
+    }
+};
+
+TEST_F(RowCellCacheTest, FormatsCells) {
+    Process proc(1234, "chrome", 2048, 12.345, 512, 3725);
+
+    const FormattedRow& row = cache.get(proc);
+
+    EXPECT_EQ(row.pid_text, "1234");
+    EXPECT_EQ(row.memory_text, "2.00");
+    EXPECT_EQ(row.cpu_text, "12.35");
+    EXPECT_EQ(row.network_text, "512");
+    EXPECT_EQ(row.time_text, "1:02:05");
+}
+
+TEST_F(RowCellCacheTest, UnchangedValuesHitTheCache) {
+    Process proc(1234, "chrome", 2048, 1.5, 512, 60);
+
+    cache.get(proc);
+    cache.begin_frame();
+    cache.get(proc);
+    cache.get(proc);
+
+    EXPECT_EQ(cache.get_misses(), 1u);
+    EXPECT_EQ(cache.get_hits(), 2u);
+}
+
+TEST_F(RowCellCacheTest, ChangedValuesAreReformatted) {
+    Process proc(1234, "chrome", 2048, 1.5, 512, 60);
+    cache.get(proc);
+
+    proc.set_cpu_usage(99.0);
+    const FormattedRow& row = cache.get(proc);
+
+    EXPECT_EQ(row.cpu_text, "99.00");
+    EXPECT_EQ(cache.get_misses(), 2u);
+}
+
+TEST_F(RowCellCacheTest, IdleRowsAreDropped) {
+    cache.get(Process(1, "init"));
+    cache.get(Process(2, "kthreadd"));
+
+    for (uint64_t i = 0; i < RowCellCache::MAX_IDLE_FRAMES + 64; i++) {
+        cache.begin_frame();
+        cache.get(Process(1, "init"));
+    }
+
+    EXPECT_EQ(cache.size(), 1u);
+}
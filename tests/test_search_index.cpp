@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+#include "../src/ui/process_view/processes_view_search.hpp"
+
+using namespace ProcessesView;
+
+// Test fixture for SearchIndex tests
+class SearchIndexTest : public ::testing::Test {
+protected:
+    std::vector<Process> processes;
+
+    void SetUp() override {
+        processes.push_back(Process(1000, "Chrome", 5000, 10.5, 1024, 0, "/opt/google/chrome/chrome --type=renderer"));
+        processes.push_back(Process(2000, "firefox", 3000, 5.2, 512, 0, "/usr/lib/firefox/firefox"));
+        processes.push_back(Process(3000, "java", 8000, 20.1, 2048, 0, "/usr/bin/java -jar Service.jar"));
+        processes.push_back(Process(4000, "terminal", 1000, 2.3, 256, 0, "gnome-terminal"));
+    }
+};
+
+TEST_F(SearchIndexTest, ContainsLowercaseMatchesAcrossBlockBoundaries) {
+    std::string haystack(100, 'a');
+    haystack += "needle";
+    haystack += std::string(37, 'b');
+
+    EXPECT_TRUE(contains_lowercase(haystack, "needle"));
+    EXPECT_TRUE(contains_lowercase(haystack, "n"));
+    EXPECT_TRUE(contains_lowercase(haystack, "eb"));
+    EXPECT_FALSE(contains_lowercase(haystack, "ab"));
+    EXPECT_FALSE(contains_lowercase(haystack, "needles"));
+    EXPECT_FALSE(contains_lowercase("short", "much longer needle"));
+    EXPECT_TRUE(contains_lowercase("anything", ""));
+}
+
+TEST_F(SearchIndexTest, MatchesNameCaseInsensitively) {
+    SearchIndex index;
+    index.update(processes);
+
+    EXPECT_EQ(index.search("CHROME"), (std::vector<uint32_t>{0}));
+}
+
+TEST_F(SearchIndexTest, MatchesCommandLineAndPid) {
+    SearchIndex index;
+    index.update(processes);
+
+    EXPECT_EQ(index.search("service.jar"), (std::vector<uint32_t>{2}));
+    EXPECT_EQ(index.search("400"), (std::vector<uint32_t>{3}));
+}
+
+TEST_F(SearchIndexTest, ExtendingQueryNarrowsPreviousMatches) {
+    SearchIndex index;
+    index.update(processes);
+
+    EXPECT_EQ(index.search("r").size(), 4u);
+    EXPECT_EQ(index.search("re"), (std::vector<uint32_t>{0, 1}));
+    EXPECT_EQ(index.search("ref"), (std::vector<uint32_t>{1}));
+
+    EXPECT_EQ(index.get_full_scans(), 1u);
+    EXPECT_EQ(index.get_narrowed_scans(), 2u);
+}
+
+TEST_F(SearchIndexTest, NewSnapshotRescans) {
+    SearchIndex index;
+    index.update(processes);
+    index.search("java");
+
+    // Same processes again: nothing to rebuild
+    uint64_t generation = index.get_generation();
+    index.update(processes);
+    EXPECT_EQ(index.get_generation(), generation);
+
+    // An exec changes the command line, so previous matches can't be reused
+    processes[1].set_process_name("javac");
+    index.update(processes);
+    EXPECT_GT(index.get_generation(), generation);
+    EXPECT_EQ(index.search("javac"), (std::vector<uint32_t>{1}));
+    EXPECT_EQ(index.get_full_scans(), 2u);
+}
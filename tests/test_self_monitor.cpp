@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include "../src/metrics/self_monitor.hpp"
+#include <memory>
+#include <thread>
+#include <vector>
+
+// Test fixture for LatencyHistogram and SelfMonitor tests
+class SelfMonitorTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+    }
+};
+
+TEST_F(SelfMonitorTest, BucketsAreContiguousAndOrdered) {
+    // Every value lands in a bucket whose bounds contain it
+    for (uint64_t value : std::vector<uint64_t>{0, 1, 15, 16, 17, 31, 32, 1000, 123456789, UINT64_MAX}) {
+        size_t index = LatencyHistogram::bucket_index(value);
+        ASSERT_LT(index, LatencyHistogram::BUCKET_COUNT);
+        EXPECT_LE(value, LatencyHistogram::bucket_upper_bound(index)) << value;
+        if (index > 0) {
+            EXPECT_GT(value, LatencyHistogram::bucket_upper_bound(index - 1)) << value;
+        }
+    }
+    EXPECT_EQ(LatencyHistogram::bucket_index(UINT64_MAX), LatencyHistogram::BUCKET_COUNT - 1);
+}
+
+TEST_F(SelfMonitorTest, PercentilesWithinBucketPrecision) {
+    auto histogram = std::make_unique<LatencyHistogram>();
+    for (uint64_t value = 1; value <= 10000; value++) {
+        histogram->record(value * 1000);
+    }
+
+    EXPECT_EQ(histogram->count(), 10000u);
+    EXPECT_EQ(histogram->max(), 10000000u);
+    EXPECT_NEAR(histogram->mean(), 5000500.0, 1.0);
+    // Sub-buckets are 1/16 of a power of two wide, so within ~6.25%
+    EXPECT_NEAR(static_cast<double>(histogram->percentile(50)), 5000000.0, 5000000.0 * 0.0625);
+    EXPECT_NEAR(static_cast<double>(histogram->percentile(99)), 9900000.0, 9900000.0 * 0.0625);
+    EXPECT_EQ(histogram->percentile(100), 10000000u);
+}
+
+TEST_F(SelfMonitorTest, EmptyHistogram) {
+    auto histogram = std::make_unique<LatencyHistogram>();
+
+    EXPECT_EQ(histogram->count(), 0u);
+    EXPECT_EQ(histogram->percentile(99), 0u);
+    EXPECT_DOUBLE_EQ(histogram->mean(), 0.0);
+}
+
+TEST_F(SelfMonitorTest, ConcurrentRecordsAreAllCounted) {
+    auto histogram = std::make_unique<LatencyHistogram>();
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([&histogram, t] {
+            for (int i = 0; i < 10000; i++) {
+                histogram->record(static_cast<uint64_t>(t * 10000 + i));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(histogram->count(), 40000u);
+    EXPECT_EQ(histogram->max(), 39999u);
+}
+
+TEST_F(SelfMonitorTest, StageTimerRecordsIntoStage) {
+    const LatencyHistogram& render = SelfMonitor::getInstance().get_histogram(Stage::RENDER);
+    uint64_t before = render.count();
+    {
+        StageTimer timer(Stage::RENDER);
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+
+    EXPECT_EQ(render.count(), before + 1);
+    EXPECT_GE(render.max(), 2000000u);
+}
+
+TEST_F(SelfMonitorTest, CountsAllocations) {
+    uint64_t before = SelfMonitor::get_allocation_count();
+    std::vector<std::unique_ptr<int>> values;
+    values.reserve(100);
+    for (int i = 0; i < 100; i++) {
+        values.push_back(std::make_unique<int>(i));
+    }
+
+    ASSERT_EQ(values.size(), 100u);
+    EXPECT_GE(SelfMonitor::get_allocation_count(), before + 100);
+}
+
+TEST_F(SelfMonitorTest, SamplesOwnUsage) {
+    SelfMonitor& monitor = SelfMonitor::getInstance();
+    monitor.sample(std::chrono::milliseconds(0));
+    monitor.record_tick();
+    std::vector<std::unique_ptr<int>> values;
+    for (int i = 0; i < 50; i++) {
+        values.push_back(std::make_unique<int>(i));
+    }
+
+    SelfUsage usage = monitor.sample(std::chrono::milliseconds(0));
+    EXPECT_GT(usage.rss_kb, 0u);
+    EXPECT_GE(usage.allocations_per_tick, 50.0);
+    EXPECT_GE(usage.cpu_percent, 0.0);
+
+    // Within the interval the previous sample is reused
+    monitor.record_tick();
+    EXPECT_EQ(monitor.sample(std::chrono::hours(1)).ticks, usage.ticks);
+}
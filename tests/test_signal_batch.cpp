@@ -0,0 +1,159 @@
+#include <gtest/gtest.h>
+#include "../src/processes_list/signal_batch.hpp"
+#include "../src/processes_list/procfs_processes.hpp"
+#include <atomic>
+#include <csignal>
+#include <fstream>
+#include <iterator>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// Forks children that wait to be signalled, so batches have real targets
+class SignalBatchTest : public ::testing::Test {
+protected:
+    std::vector<pid_t> children;
+    std::string own_name;
+
+    pid_t spawn_child() {
+        pid_t pid = fork();
+        if (pid == 0) {
+            while (true) {
+                pause();
+            }
+        }
+        children.push_back(pid);
+        return pid;
+    }
+
+    // Signal the child died from, or 0 if it exited some other way
+    int reap(pid_t pid) {
+        int status = 0;
+        waitpid(pid, &status, 0);
+        std::erase(children, pid);
+        return WIFSIGNALED(status) ? WTERMSIG(status) : 0;
+    }
+
+    void SetUp() override {
+        std::ifstream("/proc/self/comm") >> own_name;
+    }
+
+    void TearDown() override {
+        for (pid_t pid : children) {
+            ::kill(pid, SIGKILL);
+            waitpid(pid, nullptr, 0);
+        }
+    }
+};
+
+TEST_F(SignalBatchTest, SignalsEverySelectedProcess) {
+    ProcessSelection selection;
+    std::vector<pid_t> pids = {spawn_child(), spawn_child(), spawn_child()};
+    for (pid_t pid : pids) {
+        ASSERT_TRUE(selection.add(Process(pid, own_name)));
+    }
+    EXPECT_EQ(selection.size(), 3u);
+
+    std::vector<SignalTarget> targets = selection.take();
+    EXPECT_TRUE(selection.empty());
+    BatchSignalResult result = signal_targets(targets, SIGTERM);
+
+    EXPECT_EQ(result.requested, 3u);
+    EXPECT_EQ(result.sent, 3u);
+    for (pid_t pid : pids) {
+        EXPECT_EQ(reap(pid), SIGTERM);
+    }
+}
+
+TEST_F(SignalBatchTest, RefusesPidNowUsedByAnotherProcess) {
+    ProcessSelection selection;
+    pid_t pid = spawn_child();
+
+    // The snapshot said this pid was something else
+    EXPECT_FALSE(selection.add(Process(pid, "not-" + own_name)));
+    EXPECT_FALSE(selection.contains(pid));
+    EXPECT_FALSE(selection.add(Process(0, own_name)));
+}
+
+TEST_F(SignalBatchTest, RefusesPidStartedAfterTheSnapshot) {
+    pid_t pid = spawn_child();
+    std::ifstream stat_file("/proc/" + std::to_string(pid) + "/stat");
+    std::string contents((std::istreambuf_iterator<char>(stat_file)), std::istreambuf_iterator<char>());
+    ProcStat stat;
+    ASSERT_TRUE(parse_proc_stat(contents, stat));
+
+    // Same name, as in a fork storm; only the start time tells them apart
+    ProcessSelection selection;
+    Process newer(pid, own_name);
+    newer.set_start_time(stat.start_ticks + 1);
+    EXPECT_FALSE(selection.add(newer));
+
+    Process original(pid, own_name);
+    original.set_start_time(stat.start_ticks);
+    EXPECT_TRUE(selection.add(original));
+}
+
+TEST_F(SignalBatchTest, CountsTargetsThatExitedAfterSelection) {
+    ProcessSelection selection;
+    pid_t alive = spawn_child();
+    pid_t gone = spawn_child();
+    ASSERT_TRUE(selection.add(Process(alive, own_name)));
+    ASSERT_TRUE(selection.add(Process(gone, own_name)));
+
+    // Exits and is reaped before the batch goes out; its pid could now be reused
+    ::kill(gone, SIGKILL);
+    reap(gone);
+
+    std::vector<SignalTarget> targets = selection.take();
+    BatchSignalResult result = signal_targets(targets, SIGKILL);
+
+    EXPECT_EQ(result.sent, 1u);
+    EXPECT_EQ(result.exited, 1u);
+    EXPECT_EQ(reap(alive), SIGKILL);
+    EXPECT_NE(summarize_signal_result(result).find("1 already exited"), std::string::npos);
+}
+
+TEST_F(SignalBatchTest, ToggleAndClear) {
+    ProcessSelection selection;
+    pid_t pid = spawn_child();
+    Process proc(pid, own_name);
+
+    selection.toggle(proc);
+    EXPECT_TRUE(selection.contains(pid));
+    selection.toggle(proc);
+    EXPECT_FALSE(selection.contains(pid));
+
+    selection.add(proc);
+    selection.clear();
+    EXPECT_TRUE(selection.empty());
+}
+
+TEST_F(SignalBatchTest, DispatcherSignalsInBackground) {
+    std::atomic<int> batches{0};
+    SignalDispatcher dispatcher([&batches] { batches++; });
+    ProcessSelection selection;
+    pid_t pid = spawn_child();
+    ASSERT_TRUE(selection.add(Process(pid, own_name)));
+
+    dispatcher.submit(selection.take(), SIGTERM);
+    dispatcher.wait_idle();
+
+    EXPECT_EQ(batches.load(), 1);
+    ASSERT_TRUE(dispatcher.get_last_result().has_value());
+    EXPECT_EQ(dispatcher.get_last_result()->sent, 1u);
+    EXPECT_EQ(reap(pid), SIGTERM);
+
+    dispatcher.clear_last_result();
+    EXPECT_FALSE(dispatcher.get_last_result().has_value());
+}
+
+TEST_F(SignalBatchTest, SummarizesResult) {
+    BatchSignalResult result;
+    result.signal_number = SIGTERM;
+    result.requested = 10;
+    result.sent = 7;
+    result.exited = 2;
+    result.denied = 1;
+
+    EXPECT_EQ(summarize_signal_result(result),
+              "SIGTERM sent to 7 of 10 processes (2 already exited, 1 permission denied)");
+}
@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+#include "../src/processes_list/snapshot_writer.hpp"
+#include "../src/metrics/self_monitor.hpp"
+#include "../src/smart_sparker/json.hpp"
+
+// Fixed snapshots with names and command lines that need escaping
+class SnapshotWriterTest : public ::testing::Test {
+protected:
+    std::vector<Process> snapshot;
+
+    void SetUp() override {
+        Process editor(100, "vim", 20480, 1.5, 0, 3600, "vim \"notes, draft\".txt");
+        editor.set_uid(1000);
+        editor.set_parent_pid(1);
+        editor.set_nice(-5);
+        Process tricky(200, "a\\b\tc", 4096, 75.25, 512, 60, "line\nbreak");
+        tricky.set_uid(0);
+        tricky.set_parent_pid(100);
+        tricky.set_nice(19);
+        snapshot = {editor, tricky};
+    }
+};
+
+TEST_F(SnapshotWriterTest, JsonParsesBackWithEscapes) {
+    SnapshotWriter writer;
+    nlohmann::json parsed = nlohmann::json::parse(writer.write(snapshot, SnapshotFormat::JSON));
+
+    ASSERT_EQ(parsed.size(), 2u);
+    EXPECT_EQ(parsed[0]["command"], "vim \"notes, draft\".txt");
+    EXPECT_EQ(parsed[0]["nice"], -5);
+    EXPECT_EQ(parsed[1]["name"], "a\\b\tc");
+    EXPECT_EQ(parsed[1]["command"], "line\nbreak");
+    EXPECT_DOUBLE_EQ(parsed[1]["cpu_usage"].get<double>(), 75.25);
+    EXPECT_EQ(parsed[1]["parent_pid"], 100);
+}
+
+TEST_F(SnapshotWriterTest, JsonComesFromTheGivenSnapshot) {
+    SnapshotWriter writer;
+    nlohmann::json parsed = nlohmann::json::parse(
+        writer.write({Process(42, "worker", 2048, 12.5, 100, 60)}, SnapshotFormat::JSON));
+
+    ASSERT_EQ(parsed.size(), 1u);
+    EXPECT_EQ(parsed[0]["pid"], 42);
+    EXPECT_EQ(parsed[0]["name"], "worker");
+    EXPECT_EQ(parsed[0]["memory_usage"], 2048);
+}
+
+TEST_F(SnapshotWriterTest, JsonWritesOnlySelectedFields) {
+    SnapshotWriter writer;
+    std::string_view json = writer.write({snapshot[0]}, SnapshotFormat::JSON, SNAPSHOT_PID | SNAPSHOT_MEMORY);
+
+    EXPECT_EQ(json, "[{\"pid\":100,\"memory_usage\":20480}]");
+    EXPECT_EQ(writer.write({}, SnapshotFormat::JSON), "[]");
+}
+
+TEST_F(SnapshotWriterTest, CsvQuotesOnlyWhenNeeded) {
+    SnapshotWriter writer;
+    std::string_view csv = writer.write(snapshot, SnapshotFormat::CSV, SNAPSHOT_PID | SNAPSHOT_NAME | SNAPSHOT_COMMAND);
+
+    EXPECT_EQ(csv,
+              "pid,name,command\r\n"
+              "100,vim,\"vim \"\"notes, draft\"\".txt\"\r\n"
+              "200,a\\b\tc,\"line\nbreak\"\r\n");
+}
+
+TEST_F(SnapshotWriterTest, BinaryRoundTrips) {
+    SnapshotWriter writer;
+    std::string binary(writer.write(snapshot, SnapshotFormat::BINARY));
+
+    std::vector<Process> decoded;
+    ASSERT_TRUE(read_binary_snapshot(binary, decoded));
+    ASSERT_EQ(decoded.size(), 2u);
+    for (size_t i = 0; i < decoded.size(); i++) {
+        EXPECT_EQ(decoded[i].get_pid(), snapshot[i].get_pid());
+        EXPECT_EQ(decoded[i].get_process_name(), snapshot[i].get_process_name());
+        EXPECT_DOUBLE_EQ(decoded[i].get_cpu_usage(), snapshot[i].get_cpu_usage());
+        EXPECT_EQ(decoded[i].get_memory_usage(), snapshot[i].get_memory_usage());
+        EXPECT_EQ(decoded[i].get_uid(), snapshot[i].get_uid());
+        EXPECT_EQ(decoded[i].get_nice(), snapshot[i].get_nice());
+        EXPECT_EQ(decoded[i].get_command(), snapshot[i].get_command());
+    }
+
+    // Truncated or foreign data is rejected
+    EXPECT_FALSE(read_binary_snapshot(std::string_view(binary).substr(0, binary.size() - 3), decoded));
+    EXPECT_FALSE(read_binary_snapshot("not a snapshot", decoded));
+}
+
+TEST_F(SnapshotWriterTest, ReusedBufferDoesNotAllocate) {
+    std::vector<Process> large;
+    for (pid_t pid = 1; pid <= 1000; pid++) {
+        large.emplace_back(pid, "worker", pid * 10, pid / 10.0, 0, pid, "/usr/bin/worker --id=" + std::to_string(pid));
+    }
+    SnapshotWriter writer(0);
+    for (SnapshotFormat format : {SnapshotFormat::JSON, SnapshotFormat::CSV, SnapshotFormat::BINARY}) {
+        writer.write(large, format);
+    }
+
+    uint64_t before = SelfMonitor::get_allocation_count();
+    for (SnapshotFormat format : {SnapshotFormat::JSON, SnapshotFormat::CSV, SnapshotFormat::BINARY}) {
+        writer.write(large, format);
+    }
+    EXPECT_EQ(SelfMonitor::get_allocation_count(), before);
+}
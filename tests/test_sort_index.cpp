@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+#include "../src/ui/process_view/processes_view_sort.hpp"
+#include <algorithm>
+#include <random>
+
+using namespace ProcessesView;
+
+// Test fixture for SortIndex tests
+class SortIndexTest : public ::testing::Test {
+protected:
+    std::vector<Process> processes;
+
+    void SetUp() override {
+        std::mt19937 rng(42);
+        for (int i = 0; i < 20000; i++) {
+            processes.push_back(Process(100 + i, "proc" + std::to_string(rng() % 500), rng() % 100000,
+                                        (rng() % 1000) / 10.0, rng() % 5000, rng() % 100000,
+                                        "/bin/cmd" + std::to_string(rng() % 300)));
+        }
+    }
+
+    // Reference order: stable sort by the column with pid as tie-breaker
+    std::vector<pid_t> reference(SortColumn column, bool ascending) {
+        std::vector<Process> copy = processes;
+        auto key_less = [column](const Process& a, const Process& b) {
+            switch (column) {
+                case SortColumn::NAME: return a.get_process_name() < b.get_process_name();
+                case SortColumn::CPU: return a.get_cpu_usage() < b.get_cpu_usage();
+                case SortColumn::MEMORY: return a.get_memory_usage() < b.get_memory_usage();
+                default: return a.get_pid() < b.get_pid();
+            }
+        };
+        std::sort(copy.begin(), copy.end(), [&](const Process& a, const Process& b) {
+            if (key_less(a, b)) return ascending;
+            if (key_less(b, a)) return !ascending;
+            return a.get_pid() < b.get_pid();
+        });
+        std::vector<pid_t> pids;
+        for (const auto& p : copy) pids.push_back(p.get_pid());
+        return pids;
+    }
+
+    std::vector<pid_t> pids_in_order(const std::vector<uint32_t>& order, size_t count) {
+        std::vector<pid_t> pids;
+        for (size_t i = 0; i < count && i < order.size(); i++) pids.push_back(processes[order[i]].get_pid());
+        return pids;
+    }
+};
+
+TEST_F(SortIndexTest, SortsAboveTenThousandProcesses) {
+    SortIndex index;
+    auto order = index.sort(processes, SortColumn::CPU, false);
+
+    EXPECT_EQ(pids_in_order(order, processes.size()), reference(SortColumn::CPU, false));
+    EXPECT_EQ(index.get_full_sorts(), 1u);
+}
+
+TEST_F(SortIndexTest, SortsEveryColumnBothWays) {
+    for (SortColumn column : {SortColumn::PID, SortColumn::NAME, SortColumn::MEMORY, SortColumn::CPU}) {
+        for (bool ascending : {true, false}) {
+            SortIndex index;
+            auto order = index.sort(processes, column, ascending);
+            EXPECT_EQ(pids_in_order(order, processes.size()), reference(column, ascending));
+        }
+    }
+}
+
+TEST_F(SortIndexTest, RepairsOrderIncrementallyBetweenTicks) {
+    SortIndex index;
+    index.sort(processes, SortColumn::MEMORY, false);
+
+    // Next tick: a handful of processes change, one exits and one starts
+    processes[10].set_memory_usage(999999);
+    processes[500].set_memory_usage(0);
+    processes[7000].set_memory_usage(50000);
+    processes.erase(processes.begin() + 3);
+    processes.push_back(Process(99999, "new", 77777));
+
+    auto order = index.sort(processes, SortColumn::MEMORY, false);
+
+    EXPECT_EQ(pids_in_order(order, processes.size()), reference(SortColumn::MEMORY, false));
+    EXPECT_EQ(index.get_incremental_sorts(), 1u);
+    EXPECT_EQ(index.get_full_sorts(), 1u);
+}
+
+TEST_F(SortIndexTest, PartialSortOrdersOnlyTheVisiblePrefix) {
+    SortIndex index;
+    auto order = index.sort(processes, SortColumn::CPU, false, 50);
+
+    EXPECT_EQ(order.size(), processes.size());
+    auto expected = reference(SortColumn::CPU, false);
+    expected.resize(50);
+    EXPECT_EQ(pids_in_order(order, 50), expected);
+    EXPECT_EQ(index.get_partial_sorts(), 1u);
+}
+
+TEST_F(SortIndexTest, ColumnChangeResorts) {
+    SortIndex index;
+    index.sort(processes, SortColumn::CPU, false);
+    auto order = index.sort(processes, SortColumn::NAME, true);
+
+    EXPECT_EQ(pids_in_order(order, processes.size()), reference(SortColumn::NAME, true));
+    EXPECT_EQ(index.get_incremental_sorts(), 0u);
+    EXPECT_EQ(index.get_full_sorts(), 2u);
+}
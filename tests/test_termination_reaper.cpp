@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+#include "../src/processes_list/termination_reaper.hpp"
+#include <csignal>
+#include <fstream>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+
+using namespace std::chrono_literals;
+
+// Forks children that either die on SIGTERM or ignore it, and waits for each
+// child to report in so the SIGTERM disposition is set before it is signalled.
+class TerminationReaperTest : public ::testing::Test {
+protected:
+    std::vector<pid_t> children;
+    std::string own_name;
+
+    SignalTarget spawn_child(bool ignore_sigterm) {
+        int ready[2];
+        EXPECT_EQ(pipe(ready), 0);
+        pid_t pid = fork();
+        if (pid == 0) {
+            if (ignore_sigterm) {
+                signal(SIGTERM, SIG_IGN);
+            }
+            char byte = 1;
+            (void)!write(ready[1], &byte, 1);
+            while (true) {
+                pause();
+            }
+        }
+        char byte;
+        (void)!read(ready[0], &byte, 1);
+        close(ready[0]);
+        close(ready[1]);
+        children.push_back(pid);
+
+        ProcessSelection selection;
+        EXPECT_TRUE(selection.add(Process(pid, own_name)));
+        return selection.take().front();
+    }
+
+    // Signal the child died from, or 0 if it exited some other way
+    int reap(pid_t pid) {
+        int status = 0;
+        waitpid(pid, &status, 0);
+        std::erase(children, pid);
+        return WIFSIGNALED(status) ? WTERMSIG(status) : 0;
+    }
+
+    std::vector<TerminationOutcome> wait_for_outcomes(TerminationReaper& reaper, size_t count) {
+        auto give_up = std::chrono::steady_clock::now() + 10s;
+        while (reaper.get_outcomes().size() < count && std::chrono::steady_clock::now() < give_up) {
+            std::this_thread::sleep_for(5ms);
+        }
+        return reaper.get_outcomes();
+    }
+
+    void SetUp() override {
+        std::ifstream("/proc/self/comm") >> own_name;
+    }
+
+    void TearDown() override {
+        for (pid_t pid : children) {
+            ::kill(pid, SIGKILL);
+            waitpid(pid, nullptr, 0);
+        }
+    }
+};
+
+TEST_F(TerminationReaperTest, CooperativeProcessExitsWithoutEscalation) {
+    TerminationReaper reaper(nullptr, 5000ms);
+    SignalTarget target = spawn_child(false);
+    pid_t pid = target.pid;
+
+    reaper.terminate({target});
+    auto outcomes = wait_for_outcomes(reaper, 1);
+
+    ASSERT_EQ(outcomes.size(), 1u);
+    EXPECT_EQ(outcomes[0].pid, pid);
+    EXPECT_EQ(outcomes[0].state, TerminationState::EXITED);
+    EXPECT_LT(outcomes[0].exit_time, 5000ms);
+    EXPECT_EQ(reaper.get_pending_count(), 0u);
+    EXPECT_EQ(reap(pid), SIGTERM);
+}
+
+TEST_F(TerminationReaperTest, EscalatesWhenSigtermIsIgnored) {
+    TerminationReaper reaper(nullptr, 200ms);
+    SignalTarget target = spawn_child(true);
+    pid_t pid = target.pid;
+
+    reaper.terminate({target});
+    auto outcomes = wait_for_outcomes(reaper, 1);
+
+    ASSERT_EQ(outcomes.size(), 1u);
+    EXPECT_EQ(outcomes[0].state, TerminationState::KILLED);
+    EXPECT_GE(outcomes[0].exit_time, 200ms);
+    EXPECT_EQ(reap(pid), SIGKILL);
+}
+
+TEST_F(TerminationReaperTest, HandlesManyProcessesConcurrently) {
+    TerminationReaper reaper(nullptr, 300ms);
+    std::vector<SignalTarget> targets;
+    for (int i = 0; i < 16; i++) {
+        targets.push_back(spawn_child(i % 2 == 1));
+    }
+    std::vector<pid_t> pids = children;
+
+    auto started = std::chrono::steady_clock::now();
+    reaper.terminate(std::move(targets));
+    auto outcomes = wait_for_outcomes(reaper, 16);
+    auto elapsed = std::chrono::steady_clock::now() - started;
+
+    ASSERT_EQ(outcomes.size(), 16u);
+    size_t killed = 0;
+    for (const auto& outcome : outcomes) {
+        killed += outcome.state == TerminationState::KILLED;
+    }
+    EXPECT_EQ(killed, 8u);
+    // One shared grace period, not one per stubborn process
+    EXPECT_LT(elapsed, 2000ms);
+    for (pid_t pid : pids) {
+        reap(pid);
+    }
+}
+
+TEST_F(TerminationReaperTest, ReportsProcessesAlreadyGone) {
+    TerminationReaper reaper(nullptr, 200ms);
+    SignalTarget target = spawn_child(false);
+    ::kill(target.pid, SIGKILL);
+    reap(target.pid);
+
+    reaper.terminate({target});
+    auto outcomes = wait_for_outcomes(reaper, 1);
+
+    ASSERT_EQ(outcomes.size(), 1u);
+    EXPECT_EQ(outcomes[0].state, TerminationState::ALREADY_EXITED);
+}
+
+TEST_F(TerminationReaperTest, DescribesOutcomes) {
+    TerminationOutcome exited{1234, "nginx", TerminationState::EXITED, 400ms};
+    TerminationOutcome killed{99, "java", TerminationState::KILLED, 3100ms};
+
+    EXPECT_EQ(describe_termination(exited), "nginx (1234) exited 0.4 s after SIGTERM");
+    EXPECT_EQ(summarize_terminations({exited}), describe_termination(exited));
+    EXPECT_EQ(summarize_terminations({exited, killed}),
+              "2 terminated: 1 exited on SIGTERM, 1 killed; slowest 3.1 s");
+}
@@ -0,0 +1,158 @@
+#include <gtest/gtest.h>
+#include "../src/metrics/time_series.hpp"
+
+// Test fixture for RingBuffer and TimeSeries tests
+class TimeSeriesTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+    }
+
+    TimeSeries<double>::Clock::time_point origin{};
+
+    TimeSeries<double>::Clock::time_point at(int seconds) const {
+        return origin + std::chrono::seconds(seconds);
+    }
+};
+
+// ===========================
+// RingBuffer Tests
+// ===========================
+
+TEST_F(TimeSeriesTest, RingBufferKeepsInsertionOrder) {
+    RingBuffer<int> buffer(4);
+    buffer.push(1);
+    buffer.push(2);
+    buffer.push(3);
+
+    EXPECT_EQ(buffer.size(), 3u);
+    EXPECT_EQ(buffer[0], 1);
+    EXPECT_EQ(buffer[2], 3);
+    EXPECT_EQ(buffer.back(), 3);
+}
+
+TEST_F(TimeSeriesTest, RingBufferOverwritesOldestWhenFull) {
+    RingBuffer<int> buffer(3);
+    for (int i = 1; i <= 5; i++) {
+        buffer.push(i);
+    }
+
+    EXPECT_TRUE(buffer.full());
+    EXPECT_EQ(buffer.size(), 3u);
+    EXPECT_EQ(buffer.to_vector(), (std::vector<int>{3, 4, 5}));
+}
+
+TEST_F(TimeSeriesTest, RingBufferClear) {
+    RingBuffer<int> buffer(3);
+    buffer.push(1);
+    buffer.clear();
+
+    EXPECT_TRUE(buffer.empty());
+    buffer.push(7);
+    EXPECT_EQ(buffer[0], 7);
+}
+
+// ===========================
+// TimeSeries Roll-up Tests
+// ===========================
+
+TEST_F(TimeSeriesTest, RollsUpIntoMinutes) {
+    TimeSeries<double> series(60, 60, 24, 4);
+    int t = 0;
+    for (double v : {1.0, 2.0, 3.0, 6.0}) {
+        series.push(v, at(t++));
+    }
+    EXPECT_TRUE(series.minutes().empty());
+
+    // The window closes once a sample lands in the next one
+    series.push(0.0, at(t));
+    ASSERT_EQ(series.minutes().size(), 1u);
+    EXPECT_DOUBLE_EQ(series.minutes()[0].min, 1.0);
+    EXPECT_DOUBLE_EQ(series.minutes()[0].avg, 3.0);
+    EXPECT_DOUBLE_EQ(series.minutes()[0].max, 6.0);
+    EXPECT_TRUE(series.hours().empty());
+}
+
+TEST_F(TimeSeriesTest, RollsUpMinutesIntoHours) {
+    TimeSeries<double> series(60, 60, 24, 2);
+    int t = 0;
+    for (double v : {1.0, 3.0, 5.0, 7.0, 0.0}) {
+        series.push(v, at(t++));
+    }
+
+    ASSERT_EQ(series.minutes().size(), 2u);
+    ASSERT_EQ(series.hours().size(), 1u);
+    EXPECT_DOUBLE_EQ(series.hours()[0].min, 1.0);
+    EXPECT_DOUBLE_EQ(series.hours()[0].avg, 4.0);
+    EXPECT_DOUBLE_EQ(series.hours()[0].max, 7.0);
+}
+
+TEST_F(TimeSeriesTest, MemoryStaysConstant) {
+    TimeSeries<float> series(60, 60, 24);
+    for (int i = 0; i < 200000; i++) {
+        series.push(static_cast<float>(i % 100), at(i));
+    }
+
+    EXPECT_EQ(series.seconds().size(), 60u);
+    EXPECT_EQ(series.minutes().size(), 60u);
+    EXPECT_EQ(series.hours().size(), 24u);
+    EXPECT_EQ(series.values(Resolution::HOURS).size(), 24u);
+}
+
+TEST_F(TimeSeriesTest, ValuesAndCapacityPerResolution) {
+    TimeSeries<int> series(10, 5, 3, 2);
+    for (int i = 0; i < 5; i++) {
+        series.push(i, at(i));
+    }
+
+    EXPECT_EQ(series.values(Resolution::SECONDS), (std::vector<int>{0, 1, 2, 3, 4}));
+    EXPECT_EQ(series.values(Resolution::MINUTES).size(), 2u);
+    EXPECT_EQ(series.capacity(Resolution::SECONDS), 10u);
+    EXPECT_EQ(series.capacity(Resolution::MINUTES), 5u);
+    EXPECT_EQ(series.capacity(Resolution::HOURS), 3u);
+    EXPECT_EQ(series.latest(), 4);
+}
+
+TEST_F(TimeSeriesTest, ClearResetsAllTiers) {
+    TimeSeries<int> series(10, 5, 3, 2);
+    for (int i = 0; i < 10; i++) {
+        series.push(i, at(i));
+    }
+    series.clear();
+
+    EXPECT_TRUE(series.empty());
+    EXPECT_TRUE(series.minutes().empty());
+    EXPECT_TRUE(series.hours().empty());
+
+    // The next sample starts a new timeline instead of filling the gap
+    series.push(42, at(100));
+    EXPECT_EQ(series.values(Resolution::SECONDS), (std::vector<int>{42}));
+}
+
+TEST_F(TimeSeriesTest, SamplesWithinOnePeriodShareAPoint) {
+    TimeSeries<int> series;
+    series.push(1, origin);
+    series.push(2, origin + std::chrono::milliseconds(500));
+    series.push(3, origin + std::chrono::milliseconds(1000));
+
+    EXPECT_EQ(series.values(Resolution::SECONDS), (std::vector<int>{2, 3}));
+}
+
+TEST_F(TimeSeriesTest, SlowSamplesRepeatOverTheirInterval) {
+    TimeSeries<int> series;
+    series.push(1, at(0));
+    series.push(2, at(5));
+
+    EXPECT_EQ(series.values(Resolution::SECONDS), (std::vector<int>{1, 1, 1, 1, 1, 2}));
+}
+
+TEST_F(TimeSeriesTest, MinutesSpanSixtySecondsAtAnyInterval) {
+    for (auto interval : {std::chrono::milliseconds(500), std::chrono::milliseconds(5000)}) {
+        TimeSeries<double> series;
+        for (auto t = std::chrono::milliseconds(0); t <= std::chrono::minutes(2); t += interval) {
+            series.push(1.0, origin + t);
+        }
+
+        EXPECT_EQ(series.minutes().size(), 2u);
+        EXPECT_EQ(series.seconds().size(), 60u);
+    }
+}